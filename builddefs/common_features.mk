@@ -651,6 +651,12 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SEND_STRING_ENABLE := yes
+    DEFERRED_EXEC_ENABLE := yes
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -667,6 +673,9 @@ ifneq ($(strip $(CUSTOM_MATRIX)), yes)
         # Include the standard or split matrix code if needed
         QUANTUM_SRC += $(QUANTUM_DIR)/matrix.c
     endif
+else ifeq ($(strip $(SCAN_QUEUE_ENABLE)), yes)
+    # A fully custom matrix_scan() runs matrix_scan_kb() itself, which has to stay on the main loop
+    OPT_DEFS += -DSCAN_QUEUE_NO_THREAD
 endif
 
 # Debounce Modules. Set DEBOUNCE_TYPE=custom if including one manually.
@@ -683,6 +692,13 @@ ifeq ($(filter $(SERIAL_DRIVER),$(VALID_SERIAL_DRIVER_TYPES)),)
     $(call CATASTROPHIC_ERROR,Invalid SERIAL_DRIVER,SERIAL_DRIVER="$(SERIAL_DRIVER)" is not a valid SERIAL driver)
 endif
 
+VALID_SERIAL_PROTOCOL_TYPES := v1 v2
+
+SERIAL_PROTOCOL ?= v1
+ifeq ($(filter $(SERIAL_PROTOCOL),$(VALID_SERIAL_PROTOCOL_TYPES)),)
+    $(call CATASTROPHIC_ERROR,Invalid SERIAL_PROTOCOL,SERIAL_PROTOCOL="$(SERIAL_PROTOCOL)" is not a valid SERIAL protocol)
+endif
+
 ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     POST_CONFIG_H += $(QUANTUM_DIR)/split_common/post_config.h
     OPT_DEFS += -DSPLIT_KEYBOARD
@@ -710,6 +726,11 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         OPT_DEFS += -DSERIAL_DRIVER_$(strip $(shell echo $(SERIAL_DRIVER) | tr '[:lower:]' '[:upper:]'))
         ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
             QUANTUM_LIB_SRC += serial.c
+        else ifeq ($(strip $(SERIAL_PROTOCOL)), v2)
+            OPT_DEFS += -DSERIAL_PROTOCOL_V2
+            QUANTUM_SRC += $(QUANTUM_DIR)/split_common/serial_link.c
+            QUANTUM_LIB_SRC += serial_protocol_v2.c
+            QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
         else
             QUANTUM_LIB_SRC += serial_protocol.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
@@ -987,6 +1008,10 @@ ifeq ($(strip $(WS2812_DRIVER_REQUIRED)), yes)
 
     SRC += ws2812.c ws2812_$(strip $(WS2812_DRIVER)).c
 
+    ifeq ($(strip $(WS2812_DRIVER)), spi)
+        SRC += ws2812_encoder.c
+    endif
+
     ifeq ($(strip $(PLATFORM)), CHIBIOS)
         ifeq ($(strip $(WS2812_DRIVER)), pwm)
             OPT_DEFS += -DSTM32_DMA_REQUIRED=TRUE
@@ -39,6 +39,7 @@ GENERIC_FEATURES = \
     KEYCODE_STRING \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACE \
     LAYER_LOCK \
     LEADER \
     MAGIC \
@@ -47,12 +48,15 @@ GENERIC_FEATURES = \
     OS_DETECTION \
     PROGRAMMABLE_BUTTON \
     REPEAT_KEY \
+    SCAN_QUEUE \
+    SCAN_RATE \
     SECURE \
     SEND_STRING \
     SEQUENCER \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TICKLESS_IDLE \
     TRI_LAYER \
     VIA \
     VIRTSER \
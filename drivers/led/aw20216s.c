@@ -18,6 +18,7 @@
 #include "aw20216s.h"
 #include "wait.h"
 #include "spi_master.h"
+#include "util.h"
 
 #define AW20216S_PWM_REGISTER_COUNT 216
 
@@ -45,14 +46,20 @@
 #    define AW20216S_SPI_DIVISOR 4
 #endif
 
+// The PWM registers auto-increment over SPI, so only the span between the
+// lowest and highest changed register needs to be sent on update.
 typedef struct aw20216s_driver_t {
     uint8_t pwm_buffer[AW20216S_PWM_REGISTER_COUNT];
     bool    pwm_buffer_dirty;
+    uint8_t pwm_dirty_first;
+    uint8_t pwm_dirty_last;
 } PACKED aw20216s_driver_t;
 
 aw20216s_driver_t driver_buffers[AW20216S_DRIVER_COUNT] = {{
     .pwm_buffer       = {0},
     .pwm_buffer_dirty = false,
+    .pwm_dirty_first  = 0,
+    .pwm_dirty_last   = 0,
 }};
 
 bool aw20216s_write(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t* data, uint8_t len) {
@@ -147,7 +154,18 @@ void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     driver_buffers[led.driver].pwm_buffer[led.r] = red;
     driver_buffers[led.driver].pwm_buffer[led.g] = green;
     driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-    driver_buffers[led.driver].pwm_buffer_dirty  = true;
+
+    uint8_t first = MIN(led.r, MIN(led.g, led.b));
+    uint8_t last  = MAX(led.r, MAX(led.g, led.b));
+
+    if (driver_buffers[led.driver].pwm_buffer_dirty) {
+        first = MIN(first, driver_buffers[led.driver].pwm_dirty_first);
+        last  = MAX(last, driver_buffers[led.driver].pwm_dirty_last);
+    }
+
+    driver_buffers[led.driver].pwm_dirty_first  = first;
+    driver_buffers[led.driver].pwm_dirty_last   = last;
+    driver_buffers[led.driver].pwm_buffer_dirty = true;
 }
 
 void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -158,7 +176,10 @@ void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 
 void aw20216s_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, 0, driver_buffers[index].pwm_buffer, AW20216S_PWM_REGISTER_COUNT);
+        uint8_t first = driver_buffers[index].pwm_dirty_first;
+        uint8_t last  = driver_buffers[index].pwm_dirty_last;
+
+        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, first, driver_buffers[index].pwm_buffer + first, last - first + 1);
         driver_buffers[index].pwm_buffer_dirty = false;
     }
 }
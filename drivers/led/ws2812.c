@@ -13,3 +13,13 @@ void ws2812_rgb_to_rgbw(ws2812_led_t *led) {
     led->b -= led->w;
 }
 #endif
+
+__attribute__((weak)) bool ws2812_busy(void) {
+    return false;
+}
+
+__attribute__((weak)) void ws2812_flush_complete_kb(void) {
+    ws2812_flush_complete_user();
+}
+
+__attribute__((weak)) void ws2812_flush_complete_user(void) {}
@@ -15,6 +15,8 @@
 
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "util.h"
 
 /*
@@ -94,4 +96,13 @@ void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 void ws2812_flush(void);
 
+/*
+ * Drivers that clock frames out by DMA return from ws2812_flush() as soon as the transfer has started. ws2812_busy()
+ * is true until the previous frame has been sent, and ws2812_flush() waits for it. ws2812_flush_complete_kb() is
+ * called from interrupt context when a frame has been sent. Drivers that send synchronously are never busy.
+ */
+bool ws2812_busy(void);
+void ws2812_flush_complete_kb(void);
+void ws2812_flush_complete_user(void);
+
 void ws2812_rgb_to_rgbw(ws2812_led_t *led);
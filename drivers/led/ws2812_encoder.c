@@ -0,0 +1,38 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812_encoder.h"
+
+#define WS2812_ENCODER_ZERO (((1u << WS2812_ENCODER_T0H_BITS) - 1) << (WS2812_ENCODER_SYMBOL_BITS - WS2812_ENCODER_T0H_BITS))
+#define WS2812_ENCODER_ONE (((1u << WS2812_ENCODER_T1H_BITS) - 1) << (WS2812_ENCODER_SYMBOL_BITS - WS2812_ENCODER_T1H_BITS))
+#define WS2812_ENCODER_SYMBOL(nibble, bit) ((uint32_t)(((nibble) >> (bit)) & 1 ? WS2812_ENCODER_ONE : WS2812_ENCODER_ZERO) << ((bit) * WS2812_ENCODER_SYMBOL_BITS))
+#define WS2812_ENCODER_NIBBLE(nibble) (WS2812_ENCODER_SYMBOL(nibble, 3) | WS2812_ENCODER_SYMBOL(nibble, 2) | WS2812_ENCODER_SYMBOL(nibble, 1) | WS2812_ENCODER_SYMBOL(nibble, 0))
+
+#if WS2812_ENCODER_SYMBOL_BITS <= 4
+typedef uint32_t ws2812_encoder_word_t;
+#else
+typedef uint64_t ws2812_encoder_word_t;
+#endif
+
+// The symbols for every 4 bits of LED data, so a byte is encoded with two lookups instead of a branch per bit
+// clang-format off
+static const uint32_t ws2812_encoder_nibbles[16] = {
+    WS2812_ENCODER_NIBBLE(0),  WS2812_ENCODER_NIBBLE(1),  WS2812_ENCODER_NIBBLE(2),  WS2812_ENCODER_NIBBLE(3),
+    WS2812_ENCODER_NIBBLE(4),  WS2812_ENCODER_NIBBLE(5),  WS2812_ENCODER_NIBBLE(6),  WS2812_ENCODER_NIBBLE(7),
+    WS2812_ENCODER_NIBBLE(8),  WS2812_ENCODER_NIBBLE(9),  WS2812_ENCODER_NIBBLE(10), WS2812_ENCODER_NIBBLE(11),
+    WS2812_ENCODER_NIBBLE(12), WS2812_ENCODER_NIBBLE(13), WS2812_ENCODER_NIBBLE(14), WS2812_ENCODER_NIBBLE(15),
+};
+// clang-format on
+
+uint8_t *ws2812_encode_leds(uint8_t *buffer, const ws2812_led_t *leds, uint16_t count) {
+    // ws2812_led_t is laid out in the order the LEDs expect their channels
+    const uint8_t *data = (const uint8_t *)leds;
+
+    for (uint16_t i = 0; i < count * sizeof(ws2812_led_t); i++) {
+        ws2812_encoder_word_t word = ((ws2812_encoder_word_t)ws2812_encoder_nibbles[data[i] >> 4] << (4 * WS2812_ENCODER_SYMBOL_BITS)) | ws2812_encoder_nibbles[data[i] & 0xF];
+        for (int8_t shift = 8 * (WS2812_ENCODER_SYMBOL_BITS - 1); shift >= 0; shift -= 8) {
+            *buffer++ = word >> shift;
+        }
+    }
+    return buffer;
+}
@@ -0,0 +1,46 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "ws2812.h"
+
+/*
+ * Encodes LED data into a serial bit stream for drivers that clock WS2812 frames out of a peripheral by DMA, such as
+ * the SPI driver. Every WS2812 bit is sent as a symbol of WS2812_ENCODER_SYMBOL_BITS stream bits, most significant
+ * first, so the peripheral has to be clocked at WS2812_ENCODER_SYMBOL_BITS times the WS2812 bit rate. Each symbol
+ * starts with as many high bits as come closest to WS2812_T0H or WS2812_T1H, and is low for the rest.
+ */
+
+#ifndef WS2812_ENCODER_SYMBOL_BITS
+#    define WS2812_ENCODER_SYMBOL_BITS 4
+#endif
+
+#if (WS2812_ENCODER_SYMBOL_BITS < 3) || (WS2812_ENCODER_SYMBOL_BITS > 8)
+#    error "WS2812_ENCODER_SYMBOL_BITS must be between 3 and 8"
+#endif
+
+// Width of a single stream bit in ns
+#define WS2812_ENCODER_BIT_NS (WS2812_TIMING / WS2812_ENCODER_SYMBOL_BITS)
+
+// Number of high stream bits at the start of a 0 and a 1
+#define WS2812_ENCODER_T0H_BITS ((WS2812_T0H + WS2812_ENCODER_BIT_NS / 2) / WS2812_ENCODER_BIT_NS)
+#define WS2812_ENCODER_T1H_BITS ((WS2812_T1H + WS2812_ENCODER_BIT_NS / 2) / WS2812_ENCODER_BIT_NS)
+
+#if (WS2812_ENCODER_T0H_BITS < 1) || (WS2812_ENCODER_T1H_BITS <= WS2812_ENCODER_T0H_BITS) || (WS2812_ENCODER_T1H_BITS >= WS2812_ENCODER_SYMBOL_BITS)
+#    error "WS2812 timings can't be told apart at this WS2812_ENCODER_SYMBOL_BITS"
+#endif
+
+// Number of stream bytes holding `bytes` bytes of LED data
+#define WS2812_ENCODER_SIZE(bytes) ((bytes) * WS2812_ENCODER_SYMBOL_BITS)
+
+// Number of all-low stream bytes needed to hold the line low for `us` microseconds
+#define WS2812_ENCODER_RESET_SIZE(us) ((1000 * (us) * WS2812_ENCODER_SYMBOL_BITS + 8 * WS2812_TIMING - 1) / (8 * WS2812_TIMING))
+
+/**
+ * @brief Encode `count` LEDs into `buffer`, which must hold WS2812_ENCODER_SIZE(count * sizeof(ws2812_led_t)) bytes.
+ *
+ * @return A pointer to the byte after the encoded data.
+ */
+uint8_t *ws2812_encode_leds(uint8_t *buffer, const ws2812_led_t *leds, uint16_t count);
@@ -29,6 +29,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include OLED_FONT_H
 #include "timer.h"
 #include "print.h"
+#include "debug.h"
 #include <string.h>
 #include "progmem.h"
 #include "wait.h"
@@ -114,6 +115,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_PRE_CHARGE_PERIOD 0xF1
 #endif
 
+#ifndef OLED_UPDATE_BYTE_LIMIT
+#    define OLED_UPDATE_BYTE_LIMIT (OLED_UPDATE_PROCESS_LIMIT * OLED_BLOCK_SIZE)
+#endif
+
 #define OLED_ALL_BLOCKS_MASK (((((OLED_BLOCK_TYPE)1 << (OLED_BLOCK_COUNT - 1)) - 1) << 1) | 1)
 
 #define OLED_IC_HAS_HORIZONTAL_MODE (OLED_IC == OLED_IC_SSD1306)
@@ -168,6 +173,21 @@ uint32_t oled_scroll_timeout;
 uint16_t oled_update_timeout;
 #endif
 
+#ifdef OLED_COALESCE_BLOCKS
+// Buffer bytes of the run of dirty blocks being rendered, and how many of them the current address window still takes.
+// A run can take several windows and several oled_render() calls to send.
+static uint16_t oled_run_offset       = 0;
+static uint16_t oled_run_end          = 0;
+static uint16_t oled_window_remaining = 0;
+#endif
+
+#ifdef OLED_RENDER_STATS
+#    include "timestamp.h"
+
+static oled_render_stats_t oled_render_stats;
+static uint32_t            oled_render_stats_start = 0;
+#endif
+
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
 #        error "The OLED driver in SPI needs a D/C pin defined"
@@ -206,6 +226,9 @@ __attribute__((weak)) bool oled_send_cmd(const uint8_t *data, uint16_t size) {
     i2c_status_t status = i2c_transmit((OLED_DISPLAY_ADDRESS << 1), data, size, OLED_I2C_TIMEOUT);
 
     return (status == I2C_STATUS_SUCCESS);
+#else
+    // Custom transports provide their own implementation
+    return false;
 #endif
 }
 
@@ -252,9 +275,28 @@ __attribute__((weak)) bool oled_send_data(const uint8_t *data, uint16_t size) {
 #elif defined(OLED_TRANSPORT_I2C)
     i2c_status_t status = i2c_write_register((OLED_DISPLAY_ADDRESS << 1), I2C_DATA, data, size, OLED_I2C_TIMEOUT);
     return (status == I2C_STATUS_SUCCESS);
+#else
+    // Custom transports provide their own implementation
+    return false;
 #endif
 }
 
+// Sends a command or data transfer for oled_render_dirty(), keeping track of the time the bus was busy with it
+static bool oled_render_send(bool is_data, const uint8_t *data, uint16_t size) {
+#ifdef OLED_RENDER_STATS
+    uint32_t start = timestamp_read();
+#endif
+    bool success = is_data ? oled_send_data(data, size) : oled_send_cmd(data, size);
+#ifdef OLED_RENDER_STATS
+    oled_render_stats.busy_us += timestamp_to_us(timestamp_read() - start);
+    oled_render_stats.transfers++;
+    if (is_data) {
+        oled_render_stats.bytes += size;
+    }
+#endif
+    return success;
+}
+
 __attribute__((weak)) void oled_driver_init(void) {
 #if defined(OLED_TRANSPORT_SPI)
     spi_init();
@@ -358,6 +400,15 @@ bool oled_init(oled_rotation_t rotation) {
     oled_scroll_timeout = timer_read32() + OLED_SCROLL_TIMEOUT;
 #endif
 
+#ifdef OLED_COALESCE_BLOCKS
+    oled_run_offset       = 0;
+    oled_run_end          = 0;
+    oled_window_remaining = 0;
+#endif
+#ifdef OLED_RENDER_STATS
+    oled_reset_render_stats();
+#endif
+
     oled_clear();
     oled_initialized = true;
     oled_active      = true;
@@ -442,16 +493,134 @@ static void rotate_90(const uint8_t *src, uint8_t *dest) {
     }
 }
 
+static inline bool oled_render_pending(void) {
+#ifdef OLED_COALESCE_BLOCKS
+    return oled_dirty || oled_run_offset != oled_run_end;
+#else
+    return oled_dirty;
+#endif
+}
+
+#ifdef OLED_COALESCE_BLOCKS
+// Gives the blocks of the run being rendered that haven't been sent yet back to oled_dirty, so they're rendered again
+static void oled_abort_run(void) {
+    for (uint16_t offset = oled_run_offset; offset < oled_run_end; offset += OLED_BLOCK_SIZE) {
+        oled_dirty |= ((OLED_BLOCK_TYPE)1 << (offset / OLED_BLOCK_SIZE));
+    }
+    oled_run_offset       = 0;
+    oled_run_end          = 0;
+    oled_window_remaining = 0;
+}
+
+// Starts rendering the first run of consecutive dirty blocks. The blocks are sent as they are in the buffer when their
+// bytes go out, so they're clean from here on and anything drawn into them later marks them dirty again.
+static void oled_start_run(void) {
+    uint8_t first = 0;
+    while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << first))) {
+        ++first;
+    }
+    uint8_t end = first;
+    while (end < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << end))) {
+        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << end);
+        ++end;
+    }
+    oled_run_offset = OLED_BLOCK_SIZE * first;
+    oled_run_end    = OLED_BLOCK_SIZE * end;
+}
+
+// Sets the address window for as much of the rest of the run as the controller takes in one data stream
+static bool oled_start_window(void) {
+    uint16_t length = oled_run_end - oled_run_offset;
+    uint8_t  page   = oled_run_offset / OLED_DISPLAY_WIDTH;
+    uint8_t  column = oled_run_offset % OLED_DISPLAY_WIDTH;
+
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    uint8_t pages = 1;
+    if (column == 0 && length >= OLED_DISPLAY_WIDTH) {
+        // Whole pages follow each other in horizontal addressing mode
+        pages  = length / OLED_DISPLAY_WIDTH;
+        length = pages * OLED_DISPLAY_WIDTH;
+    } else if (column + length > OLED_DISPLAY_WIDTH) {
+        length = OLED_DISPLAY_WIDTH - column;
+    }
+    const uint8_t width    = MIN(length, OLED_DISPLAY_WIDTH);
+    uint8_t       window[] = {I2C_CMD, COLUMN_ADDR, OLED_COLUMN_OFFSET + column, OLED_COLUMN_OFFSET + column + width - 1, PAGE_ADDR, page, page + pages - 1};
+#else
+    // Page addressing mode wraps around within the page, so a window ends with its page
+    if (column + length > OLED_DISPLAY_WIDTH) {
+        length = OLED_DISPLAY_WIDTH - column;
+    }
+    uint8_t window[] = {I2C_CMD, PAM_PAGE_ADDR | page, PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + column) & 0x0f), PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + column) >> 4 & 0x0f)};
+#endif
+
+    if (!oled_render_send(false, window, ARRAY_SIZE(window))) {
+        return false;
+    }
+    oled_window_remaining = length;
+    return true;
+}
+
+// Renders runs of consecutive dirty blocks with one address window per run (or per page, for runs that don't start on a
+// page boundary), streaming up to OLED_UPDATE_BYTE_LIMIT bytes per call. The controller keeps its address pointer between
+// transfers, so a window that doesn't fit picks up where it left off on the next call.
+static void oled_render_coalesced(bool all) {
+    uint16_t budget = OLED_UPDATE_BYTE_LIMIT;
+    while (all || budget > 0) {
+        if (oled_window_remaining == 0) {
+            if (oled_run_offset == oled_run_end) {
+                if (!oled_dirty) {
+                    break;
+                }
+                oled_start_run();
+            }
+            if (!oled_start_window()) {
+                print("oled_render offset command failed\n");
+                oled_abort_run();
+                return;
+            }
+        }
+
+        uint16_t length = oled_window_remaining;
+        if (!all && length > budget) {
+            length = budget;
+        }
+        if (!oled_render_send(true, &oled_buffer[oled_run_offset], length)) {
+            print("oled_render data failed\n");
+            oled_abort_run();
+            return;
+        }
+        oled_run_offset += length;
+        oled_window_remaining -= length;
+        if (!all) {
+            budget -= length;
+        }
+    }
+
+#    ifdef OLED_RENDER_STATS
+    if (!oled_render_pending()) {
+        oled_render_stats.frames++;
+    }
+#    endif
+}
+#endif
+
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
-    if (!oled_dirty || !oled_initialized || oled_scrolling) {
+    if (!oled_render_pending() || !oled_initialized || oled_scrolling) {
         return;
     }
 
     // Turn on display if it is off
     oled_on();
 
+#ifdef OLED_COALESCE_BLOCKS
+    if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
+        oled_render_coalesced(all);
+        return;
+    }
+#endif
+
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
     while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
@@ -473,14 +642,14 @@ void oled_render_dirty(bool all) {
         }
 
         // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        if (!oled_render_send(false, display_start, ARRAY_SIZE(display_start))) {
             print("oled_render offset command failed\n");
             return;
         }
 
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
             // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
+            if (!oled_render_send(true, &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
                 print("oled_render data failed\n");
                 return;
             }
@@ -497,7 +666,7 @@ void oled_render_dirty(bool all) {
 
 #if OLED_IC_HAS_HORIZONTAL_MODE
             // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+            if (!oled_render_send(true, &temp_buffer[0], OLED_BLOCK_SIZE)) {
                 print("oled_render90 data failed\n");
                 return;
             }
@@ -509,13 +678,13 @@ void oled_render_dirty(bool all) {
                 // Send column & page position for all pages except the first one
                 if (i > 0) {
                     display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                    if (!oled_render_send(false, display_start, ARRAY_SIZE(display_start))) {
                         print("oled_render offset command failed\n");
                         return;
                     }
                 }
                 // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+                if (!oled_render_send(true, &temp_buffer[columns_in_block * i], columns_in_block)) {
                     print("oled_render90 data failed\n");
                     return;
                 }
@@ -526,6 +695,12 @@ void oled_render_dirty(bool all) {
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
+
+#ifdef OLED_RENDER_STATS
+    if (!oled_dirty) {
+        oled_render_stats.frames++;
+    }
+#endif
 }
 
 void oled_set_cursor(uint8_t col, uint8_t line) {
@@ -832,7 +1007,7 @@ bool oled_scroll_right(void) {
 
     // Dont enable scrolling if we need to update the display
     // This prevents scrolling of bad data from starting the scroll too early after init
-    if (!oled_dirty && !oled_scrolling) {
+    if (!oled_render_pending() && !oled_scrolling) {
         uint8_t display_scroll_right[] = {I2C_CMD, SCROLL_RIGHT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
         if (!oled_send_cmd(display_scroll_right, ARRAY_SIZE(display_scroll_right))) {
             print("oled_scroll_right cmd failed\n");
@@ -850,7 +1025,7 @@ bool oled_scroll_left(void) {
 
     // Dont enable scrolling if we need to update the display
     // This prevents scrolling of bad data from starting the scroll too early after init
-    if (!oled_dirty && !oled_scrolling) {
+    if (!oled_render_pending() && !oled_scrolling) {
         uint8_t display_scroll_left[] = {I2C_CMD, SCROLL_LEFT, 0x00, oled_scroll_start, oled_scroll_speed, oled_scroll_end, 0x00, 0xFF, ACTIVATE_SCROLL};
         if (!oled_send_cmd(display_scroll_left, ARRAY_SIZE(display_scroll_left))) {
             print("oled_scroll_left cmd failed\n");
@@ -874,6 +1049,9 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_COALESCE_BLOCKS
+        oled_abort_run();
+#endif
     }
     return !oled_scrolling;
 }
@@ -946,6 +1124,15 @@ void oled_task(void) {
     // Smart render system, no need to check for dirty
     oled_render();
 
+#if defined(OLED_RENDER_STATS) && OLED_RENDER_STATS_INTERVAL > 0
+    if (timer_elapsed32(oled_render_stats_start) >= OLED_RENDER_STATS_INTERVAL) {
+        oled_render_stats_t stats;
+        oled_get_render_stats(&stats);
+        dprintf("oled: %lu.%02lu fps, bus busy %lu.%01lu%% (%lu transfers, %lu bytes)\n", (unsigned long)(stats.frames * 1000UL / stats.elapsed_ms), (unsigned long)(stats.frames * 100000UL / stats.elapsed_ms % 100), (unsigned long)(stats.busy_us / stats.elapsed_ms / 10), (unsigned long)(stats.busy_us / stats.elapsed_ms % 10), (unsigned long)stats.transfers, (unsigned long)stats.bytes);
+        oled_reset_render_stats();
+    }
+#endif
+
     // Display timeout check
 #if OLED_TIMEOUT > 0
     if (oled_active && timer_expired32(timer_read32(), oled_timeout)) {
@@ -964,6 +1151,46 @@ void oled_task(void) {
 #endif
 }
 
+bool oled_next_deadline(uint32_t *deadline) {
+    if (!oled_initialized) {
+        return false;
+    }
+
+    uint32_t now = timer_read32();
+#if OLED_UPDATE_INTERVAL > 0
+    uint16_t elapsed = timer_elapsed(oled_update_timeout);
+    *deadline        = now + (elapsed >= OLED_UPDATE_INTERVAL ? 0 : OLED_UPDATE_INTERVAL - elapsed);
+#else
+    // oled_task_user() is invoked every iteration, so there's no telling when it next wants to draw
+    *deadline = now;
+#endif
+
+#if OLED_TIMEOUT > 0
+    if (oled_active && (int32_t)(oled_timeout - *deadline) < 0) {
+        *deadline = oled_timeout;
+    }
+#endif
+
+#if OLED_SCROLL_TIMEOUT > 0
+    if (!oled_scrolling && (int32_t)(oled_scroll_timeout - *deadline) < 0) {
+        *deadline = oled_scroll_timeout;
+    }
+#endif
+    return true;
+}
+
+#ifdef OLED_RENDER_STATS
+void oled_get_render_stats(oled_render_stats_t *stats) {
+    *stats            = oled_render_stats;
+    stats->elapsed_ms = timer_elapsed32(oled_render_stats_start);
+}
+
+void oled_reset_render_stats(void) {
+    memset(&oled_render_stats, 0, sizeof(oled_render_stats));
+    oled_render_stats_start = timer_read32();
+}
+#endif
+
 __attribute__((weak)) bool oled_task_kb(void) {
     return oled_task_user();
 }
@@ -309,6 +309,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define OLED_UPDATE_PROCESS_LIMIT 1
 #endif
 
+#if !defined(OLED_RENDER_STATS_INTERVAL)
+#    define OLED_RENDER_STATS_INTERVAL 10000
+#endif
+
 typedef struct __attribute__((__packed__)) {
     uint8_t *current_element;
     uint16_t remaining_element_count;
@@ -341,6 +345,22 @@ oled_rotation_t oled_init_user(oled_rotation_t rotation);
 // Clears the display buffer, resets cursor position to 0, and sets the buffer to dirty for rendering
 void oled_clear(void);
 
+#if defined(OLED_RENDER_STATS)
+typedef struct {
+    uint32_t frames;     // Renders that left no dirty blocks behind
+    uint32_t transfers;  // Command and data transfers sent while rendering
+    uint32_t bytes;      // Display data bytes sent while rendering
+    uint32_t busy_us;    // Time spent waiting on those transfers
+    uint32_t elapsed_ms; // Time since the stats were last reset
+} oled_render_stats_t;
+
+// Copies the render stats gathered since they were last reset. Frames per second are frames * 1000 / elapsed_ms.
+void oled_get_render_stats(oled_render_stats_t *stats);
+
+// Zeroes the render stats and restarts their elapsed time
+void oled_reset_render_stats(void);
+#endif
+
 // Alias to oled_render_dirty to avoid a change in api.
 #define oled_render() oled_render_dirty(false)
 
@@ -434,6 +454,9 @@ uint8_t oled_get_brightness(void);
 // Basically it's oled_render, but with timeout management and oled_task_user calling!
 void oled_task(void);
 
+// Retrieves the time at which oled_task next has work to do, returns false if it has none
+bool oled_next_deadline(uint32_t *deadline);
+
 // Called at the start of oled_task, weak function overridable by the user
 bool oled_task_kb(void);
 bool oled_task_user(void);
@@ -5,6 +5,7 @@
 
 #    include "color.h"
 #    include "qp_draw.h"
+#    include "qp_comms.h"
 #    include "qp_surface_internal.h"
 #    include "qp_comms_dummy.h"
 
@@ -76,10 +77,18 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
     uint16_t r = entire_surface ? (surface_handle->base.panel_width - 1) : surface_handle->dirty.r;
     uint16_t b = entire_surface ? (surface_handle->base.panel_height - 1) : surface_handle->dirty.b;
 
+    // Keep comms running for the whole transfer, so that each chunk can be sent while the next is being prepared
+    painter_device_t target_device = (painter_device_t)target_driver;
+    if (!qp_comms_start(target_device)) {
+        qp_dprintf("rgb565_target_pixdata_transfer: fail (could not start comms)\n");
+        return false;
+    }
+
     // Set the target drawing area
-    bool ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
+    bool ok = target_driver->driver_vtable->viewport(target_device, x + l, y + t, x + r, y + b);
     if (!ok) {
         qp_dprintf("rgb565_target_pixdata_transfer: fail (could not set target viewport)\n");
+        qp_comms_stop(target_device);
         return false;
     }
 
@@ -89,18 +98,16 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
     uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
 
     // Fill the global pixdata area so that we can start transferring to the panel
-    for (uint16_t y = t; y <= b; ++y) {
-        for (uint16_t x = l; x <= r; ++x) {
+    for (uint16_t y = t; ok && y <= b; ++y) {
+        for (uint16_t x = l; ok && x <= r; ++x) {
             // Update the target buffer
             target_buffer[pixel_counter++] = surface_handle->u16buffer[y * surface_handle->base.panel_width + x];
 
             // If we've accumulated enough data, send it
             if (pixel_counter == total_pixel_count) {
-                ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
-                if (!ok) {
-                    qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
-                    return false;
-                }
+                ok = qp_internal_flush_pixdata(target_device, pixel_counter);
+                // Flushing may have swapped to the other pixdata buffer
+                target_buffer = (uint16_t *)qp_internal_global_pixdata_buffer;
                 // Reset the counter
                 pixel_counter = 0;
             }
@@ -108,15 +115,15 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
     }
 
     // If there's any leftover data, send it
-    if (pixel_counter > 0) {
-        ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
-        if (!ok) {
-            qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
-            return false;
-        }
+    if (ok && pixel_counter > 0) {
+        ok = qp_internal_flush_pixdata(target_device, pixel_counter);
     }
 
-    return true;
+    qp_comms_stop(target_device);
+    if (!ok) {
+        qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
+    }
+    return ok;
 }
 
 static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
@@ -248,14 +248,49 @@ uint16_t pmw33xx_get_cpi_wrapper(void) {
     return pmw33xx_get_cpi(0);
 }
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+// Motion from bursts that didn't fit in a single report, carried over to the following ones
+static int32_t carry_x = 0;
+static int32_t carry_y = 0;
+
+void pointing_device_driver_clear_motion(void) {
+    carry_x = 0;
+    carry_y = 0;
+}
+#endif
+
 report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
     pmw33xx_report_t report    = pmw33xx_read_burst(0);
     static bool      in_motion = false;
 
     if (report.motion.b.is_lifted) {
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+        // Don't move the pointer once the sensor is set down again
+        pointing_device_driver_clear_motion();
+#endif
         return mouse_report;
     }
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+    if (report.motion.b.is_motion) {
+        if (!in_motion) {
+            in_motion = true;
+            pd_dprintf("PWM3360 (0): starting motion\n");
+        }
+        carry_x += report.delta_x;
+        carry_y += report.delta_y;
+    } else {
+        in_motion = false;
+        if (!carry_x && !carry_y) {
+            return mouse_report;
+        }
+    }
+
+    mouse_report.x = CONSTRAIN_HID_XY(carry_x);
+    mouse_report.y = CONSTRAIN_HID_XY(carry_y);
+    carry_x -= mouse_report.x;
+    carry_y -= mouse_report.y;
+#else
     if (!report.motion.b.is_motion) {
         in_motion = false;
         return mouse_report;
@@ -268,5 +303,6 @@ report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
 
     mouse_report.x = CONSTRAIN_HID_XY(report.delta_x);
     mouse_report.y = CONSTRAIN_HID_XY(report.delta_y);
+#endif
     return mouse_report;
 }
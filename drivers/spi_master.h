@@ -103,6 +103,28 @@ spi_status_t spi_transmit(const uint8_t *data, uint16_t length);
  */
 spi_status_t spi_receive(uint8_t *data, uint16_t length);
 
+/**
+ * \brief Start sending multiple bytes to the selected SPI device, without waiting for the transfer to complete.
+ *
+ * The contents of `data` must not be modified until `spi_transmit_wait()` has returned. Platforms without DMA support
+ * perform the transfer before returning.
+ *
+ * \param data A pointer to the data to write from.
+ * \param length The number of bytes to write. Take care not to overrun the length of `data`.
+ *
+ * \return `SPI_STATUS_ERROR` if the transfer could not be started, for instance because one is still in progress,
+ * otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length);
+
+/**
+ * \brief Wait for a transfer started by `spi_transmit_async()` to complete. Returns immediately if there is none.
+ *
+ * \return `SPI_STATUS_TIMEOUT` if the transfer did not complete within `SPI_TIMEOUT` milliseconds, `SPI_STATUS_ERROR` if it
+ * failed, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_wait(void);
+
 /**
  * \brief End the current SPI transaction. This will deassert the slave select pin and reset the endianness, mode and divisor configured by `spi_start()`.
  *
@@ -57,7 +57,7 @@ void dynamic_macro_play(uint8_t macro_id) {
 
   clear_keyboard();
 
-  layer_state = saved_layer_state;
+  layer_state_set(saved_layer_state);
 }
 
 /**
@@ -27,7 +27,10 @@ Example:
 For full documentation, see QMK Docs
 """
 
+import bisect
+import itertools
 import textwrap
+import zlib
 from typing import Any, Dict, Iterator, List, Tuple
 
 from milc import cli
@@ -43,12 +46,27 @@ KC_A = 4
 KC_SPC = 0x2c
 KC_QUOT = 0x34
 
+# Node links are two bytes for dictionaries stored in the firmware, and three
+# bytes for dictionaries stored in external flash.
+LINK_SIZE = 2
+EXTERNAL_LINK_SIZE = 3
+
+# Chain terminators: the chain's child either follows it directly, or is linked to.
+CHAIN_INLINE = 0
+CHAIN_LINK = 1
+
+# Identifies a dictionary written for external flash.
+EXTERNAL_MAGIC = [ord('Q'), ord('A'), ord('C'), 2]
+
 TYPO_CHARS = dict([
     ("'", KC_QUOT),
     (':', KC_SPC),  # "Word break" character.
 ] + [(chr(c), c + KC_A - ord('a')) for c in range(ord('a'),
                                                   ord('z') + 1)])  # Characters a-z.
 
+# Order of the links in the table at the start of the data.
+ROOT_CHARS = 'abcdefghijklmnopqrstuvwxyz\':'
+
 
 def parse_file(file_name: str) -> List[Tuple[str, str]]:
     """Parses autocorrections dictionary file.
@@ -77,9 +95,11 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
             cli.echo('  {fg_cyan}python3 -m pip install english_words')
         # Use a minimal word list as a fallback.
         correct_words = ('information', 'available', 'international', 'language', 'loosest', 'reference', 'wealthier', 'entertainment', 'association', 'provides', 'technology', 'statehood')
+    correct_words = CorrectWords(correct_words)
 
     autocorrections = []
     typos = set()
+    typo_substrings = {}  # Every substring of the typos so far, and a typo that contains it.
     for line_number, typo, correction in parse_file_lines(file_name):
         if typo in typos:
             cli.log.warning('{fg_red}Error:%d:{fg_reset} Ignoring duplicate typo: "{fg_cyan}%s{fg_reset}"', line_number, typo)
@@ -89,10 +109,10 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
         if not (all([c in TYPO_CHARS for c in typo])):
             cli.log.error('{fg_red}Error:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" has characters other than a-z, \' and :.', line_number, typo)
             maybe_exit(1)
-        for other_typo in typos:
-            if typo in other_typo or other_typo in typo:
-                cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
-                maybe_exit(1)
+        other_typo = typo_substrings.get(typo) or next((other for other in substrings(typo) if other in typos), None)
+        if other_typo:
+            cli.log.error('{fg_red}Error:%d:{fg_reset} Typos may not be substrings of one another, otherwise the longer typo would never trigger: "{fg_cyan}%s{fg_reset}" vs. "{fg_cyan}%s{fg_reset}".', line_number, typo, other_typo)
+            maybe_exit(1)
         if len(typo) < 5:
             cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} It is suggested that typos are at least 5 characters long to avoid false triggers: "{fg_cyan}%s{fg_reset}"', line_number, typo)
         if len(typo) > 127:
@@ -103,12 +123,60 @@ def parse_file(file_name: str) -> List[Tuple[str, str]]:
 
         autocorrections.append((typo, correction))
         typos.add(typo)
+        for substring in substrings(typo):
+            typo_substrings.setdefault(substring, typo)
 
     return autocorrections
 
 
+def substrings(text: str) -> Iterator[str]:
+    """Yields every substring of `text`."""
+    for start in range(len(text)):
+        for end in range(start + 1, len(text) + 1):
+            yield text[start:end]
+
+
+class CorrectWords:
+    """Finds the correctly spelled words that are, start with, end with or contain a typo.
+  Checking every word for every typo takes too long with large dictionaries, so
+  words are kept sorted for prefix and suffix searches, and joined together for
+  substring searches.
+  """
+    def __init__(self, words):
+        self.words = set(words)
+        self.sorted = sorted(self.words)
+        self.reversed = sorted(word[::-1] for word in self.words)
+        self.joined = '\n'.join(self.sorted)
+        self.starts = []
+        offset = 0
+        for word in self.sorted:
+            self.starts.append(offset)
+            offset += len(word) + 1
+
+    def __contains__(self, word: str) -> bool:
+        return word in self.words
+
+    def starting_with(self, prefix: str) -> List[str]:
+        index = bisect.bisect_left(self.sorted, prefix)
+        return list(itertools.takewhile(lambda word: word.startswith(prefix), self.sorted[index:]))
+
+    def ending_with(self, suffix: str) -> List[str]:
+        reversed_suffix = suffix[::-1]
+        index = bisect.bisect_left(self.reversed, reversed_suffix)
+        return [word[::-1] for word in itertools.takewhile(lambda word: word.startswith(reversed_suffix), self.reversed[index:])]
+
+    def containing(self, text: str) -> List[str]:
+        found = []
+        offset = self.joined.find(text)
+        while offset >= 0:
+            index = bisect.bisect_right(self.starts, offset) - 1
+            found.append(self.sorted[index])
+            offset = self.joined.find(text, self.starts[index] + len(self.sorted[index]))
+        return found
+
+
 def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
-    """Makes a trie from the the typos, writing in reverse.
+    """Makes a trie from the the typos.
   Args:
     autocorrections: List of (typo, correction) tuples.
   Returns:
@@ -117,7 +185,7 @@ def make_trie(autocorrections: List[Tuple[str, str]]) -> Dict[str, Any]:
     trie = {}
     for typo, correction in autocorrections:
         node = trie
-        for letter in typo[::-1]:
+        for letter in typo:
             node = node.setdefault(letter, {})
         node['LEAF'] = (typo, correction)
 
@@ -145,100 +213,143 @@ def parse_file_lines(file_name: str) -> Iterator[Tuple[int, str, str]]:
             yield line_number, typo, correction
 
 
-def check_typo_against_dictionary(typo: str, line_number: int, correct_words) -> None:
+def check_typo_against_dictionary(typo: str, line_number: int, correct_words: CorrectWords) -> None:
     """Checks `typo` against English dictionary words."""
 
     if typo.startswith(':') and typo.endswith(':'):
         if typo[1:-1] in correct_words:
             cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" is a correctly spelled dictionary word.', line_number, typo)
     elif typo.startswith(':') and not typo.endswith(':'):
-        for word in correct_words:
-            if word.startswith(typo[1:]):
-                cli.log.warning('{fg_yellow}Warning:%d: {fg_reset}Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
+        for word in correct_words.starting_with(typo[1:]):
+            cli.log.warning('{fg_yellow}Warning:%d: {fg_reset}Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
     elif not typo.startswith(':') and typo.endswith(':'):
-        for word in correct_words:
-            if word.endswith(typo[:-1]):
-                cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
+        for word in correct_words.ending_with(typo[:-1]):
+            cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
     elif not typo.startswith(':') and not typo.endswith(':'):
-        for word in correct_words:
-            if typo in word:
-                cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
+        for word in correct_words.containing(typo):
+            cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def make_changes(typo: str, correction: str) -> Tuple[int, str]:
+    """Works out the keystrokes that turn `typo` into `correction`.
+  Args:
+    typo: The typo, with ':' for word breaks.
+    correction: What the typo is corrected to.
+  Returns:
+    The number of backspaces to send, and the text to send after them.
+  """
+    word_boundary_ending = typo[-1] == ':'
+    typo = typo.strip(':')
+    i = 0
+    # The last letter of the typo is never sent, so it is always part of the changes.
+    while i < min(len(typo) - 1, len(correction)) and typo[i] == correction[i]:
+        i += 1
+    backspaces = len(typo) - i - 1 + word_boundary_ending
+    assert 0 <= backspaces <= 63
+    return backspaces, correction[i:]
+
+
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], link_size: int) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
+  The data starts with a table of links to the first node of typos starting
+  with each of the characters in ROOT_CHARS, so that the firmware can start
+  matching a typo at every keystroke without searching. Identical subtries,
+  most commonly the leaves holding the corrections, are only stored once.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
+    link_size: Number of bytes in a node link.
   Returns:
     List of ints in the range 0-255.
   """
-    table = []
+    entries = {}
 
-    # Traverse trie in depth first order.
-    def traverse(trie_node):
+    # Builds the table entry for a trie node, reusing an existing identical entry.
+    def build(trie_node):
         if 'LEAF' in trie_node:  # Handle a leaf trie node.
-            typo, correction = trie_node['LEAF']
-            word_boundary_ending = typo[-1] == ':'
-            typo = typo.strip(':')
-            i = 0  # Make the autocorrection data for this entry and serialize it.
-            while i < min(len(typo), len(correction)) and typo[i] == correction[i]:
-                i += 1
-            backspaces = len(typo) - i - 1 + word_boundary_ending
-            assert 0 <= backspaces <= 63
-            correction = correction[i:]
-            bs_count = [backspaces + 128]
-            data = bs_count + list(bytes(correction, 'ascii')) + [0]
-
-            entry = {'data': data, 'links': [], 'byte_offset': 0}
-            table.append(entry)
+            backspaces, changes = make_changes(*trie_node['LEAF'])
+            data = [backspaces + 128] + list(bytes(changes, 'ascii')) + [0]
+            entry = {'data': data, 'links': []}
+            key = ('leaf', tuple(data))
         elif len(trie_node) == 1:  # Handle trie node with a single child.
             c, trie_node = next(iter(trie_node.items()))
-            entry = {'chars': c, 'byte_offset': 0}
+            chars = c
 
             # It's common for a trie to have long chains of single-child nodes. We
             # find the whole chain so that we can serialize it more efficiently.
             while len(trie_node) == 1 and 'LEAF' not in trie_node:
                 c, trie_node = next(iter(trie_node.items()))
-                entry['chars'] += c
+                chars += c
 
-            table.append(entry)
-            entry['links'] = [traverse(trie_node)]
+            entry = {'chars': chars, 'links': [build(trie_node)]}
+            key = ('chain', chars, id(entry['links'][0]))
         else:  # Handle trie node with multiple children.
-            entry = {'chars': ''.join(sorted(trie_node.keys())), 'byte_offset': 0}
-            table.append(entry)
-            entry['links'] = [traverse(trie_node[c]) for c in entry['chars']]
-        return entry
+            chars = ''.join(sorted(trie_node.keys()))
+            entry = {'chars': chars, 'links': [build(trie_node[c]) for c in chars]}
+            key = ('branch', chars, tuple(id(link) for link in entry['links']))
+        return entries.setdefault(key, entry)
 
-    traverse(trie)
+    roots = [build(trie[c]) if c in trie else None for c in ROOT_CHARS]
+
+    # Lay out the entries depth first. A chain is directly followed by its child,
+    # unless the child is shared and has already been placed elsewhere.
+    table = []
+    placed = set()
+
+    def place(e):
+        if id(e) in placed:
+            return
+        placed.add(id(e))
+        table.append(e)
+        if len(e['links']) == 1:
+            e['inline'] = id(e['links'][0]) not in placed
+        for link in e['links']:
+            place(link)
+
+    for e in roots:
+        if e:
+            place(e)
 
     def serialize(e: Dict[str, Any]) -> List[int]:
         if not e['links']:  # Handle a leaf table entry.
             return e['data']
         elif len(e['links']) == 1:  # Handle a chain table entry.
-            return [TYPO_CHARS[c] for c in e['chars']] + [0]  # + encode_link(e['links'][0]))
+            chars = [TYPO_CHARS[c] for c in e['chars']]
+            if e['inline']:
+                return chars + [CHAIN_INLINE]
+            return chars + [CHAIN_LINK] + encode_link(e['links'][0], link_size)
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
+                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link, link_size)
             return data + [0]
 
-    byte_offset = 0
+    def entry_size(e: Dict[str, Any]) -> int:
+        if not e['links']:
+            return len(e['data'])
+        elif len(e['links']) == 1:
+            return len(e['chars']) + 1 + (0 if e['inline'] else link_size)
+        else:
+            return len(e['links']) * (1 + link_size) + 1
+
+    byte_offset = len(ROOT_CHARS) * link_size
     for e in table:  # To encode links, first compute byte offset of each entry.
         e['byte_offset'] = byte_offset
-        byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
+        byte_offset += entry_size(e)
+
+    root_table = []
+    for e in roots:
+        root_table += encode_link(e, link_size) if e else [0] * link_size
 
-    return [b for e in table for b in serialize(e)]  # Serialize final table.
+    return root_table + [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
+def encode_link(link: Dict[str, Any], link_size: int) -> List[int]:
+    """Encodes a node link as `link_size` little endian bytes."""
     byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
-        maybe_exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
+    if not (0 <= byte_offset < 1 << (8 * link_size)):
+        raise OverflowError(byte_offset)
+    return [(byte_offset >> (8 * i)) & 255 for i in range(link_size)]
 
 
 def typo_len(e: Tuple[str, str]) -> int:
@@ -253,12 +364,21 @@ def to_hex(b: int) -> str:
 @cli.argument('-kb', '--keyboard', type=keyboard_folder, completer=keyboard_completer, help='The keyboard to build a firmware for. Ignored when a output file is supplied.')
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a output file is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
+@cli.argument('-e', '--external', arg_only=True, action='store_true', help='Write the dictionary to autocorrect_data.bin, to be programmed into external flash')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    try:
+        data = serialize_trie(autocorrections, trie, EXTERNAL_LINK_SIZE if cli.args.external else LINK_SIZE)
+    except OverflowError:
+        if cli.args.external:
+            cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds the 16MB limit. Try reducing the autocorrection dict to fewer entries.')
+        else:
+            cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries, or storing it in external flash with --external.')
+        maybe_exit(1)
+        return
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -266,26 +386,50 @@ def generate_autocorrect_data(cli):
     if not cli.args.output and current_keyboard and current_keymap:
         cli.args.output = locate_keymap(current_keyboard, current_keymap).parent / 'autocorrect_data.h'
 
+    if cli.args.external and (not cli.args.output or cli.args.output.name == '-'):
+        cli.log.error('{fg_red}Error:{fg_reset} An output file or keymap is needed to write the external dictionary next to.')
+        maybe_exit(1)
+        return
+
     assert all(0 <= b <= 255 for b in data)
 
     min_typo = min(autocorrections, key=typo_len)[0]
     max_typo = max(autocorrections, key=typo_len)[0]
+    max_changes = max(len(make_changes(typo, correction)[1]) for typo, correction in autocorrections)
 
     # Build the autocorrect_data.h file.
     autocorrect_data_h_lines = [GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE, '#pragma once', '']
 
-    autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries):')
-    for typo, correction in autocorrections:
-        autocorrect_data_h_lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
+    if cli.args.external:
+        autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries), stored in external flash.')
+    else:
+        autocorrect_data_h_lines.append(f'// Autocorrection dictionary ({len(autocorrections)} entries):')
+        for typo, correction in autocorrections:
+            autocorrect_data_h_lines.append(f'//   {typo:<{len(max_typo)}} -> {correction}')
 
     autocorrect_data_h_lines.append('')
+    autocorrect_data_h_lines.append('#define AUTOCORRECT_DATA_VERSION 2')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
+    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_CHANGES_LENGTH {max_changes}')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
-    autocorrect_data_h_lines.append('')
-    autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
-    autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
-    autocorrect_data_h_lines.append('};')
+
+    if cli.args.external:
+        autocorrect_data_h_lines.append('#define AUTOCORRECT_DATA_EXTERNAL')
+        autocorrect_data_h_lines.append(f'#define AUTOCORRECT_DATA_CRC 0x{zlib.crc32(bytes(data)):08X}')
+
+        size = len(data).to_bytes(4, 'little')
+        crc = zlib.crc32(bytes(data)).to_bytes(4, 'little')
+        binary_file = cli.args.output.parent / 'autocorrect_data.bin'
+        binary_file.parent.mkdir(parents=True, exist_ok=True)
+        binary_file.write_bytes(bytes(EXTERNAL_MAGIC) + size + crc + bytes(data))
+        if not cli.args.quiet:
+            cli.log.info(f'Wrote {binary_file.name} to {binary_file}.')
+    else:
+        autocorrect_data_h_lines.append('')
+        autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
+        autocorrect_data_h_lines.append(textwrap.fill('    %s' % (', '.join(map(to_hex, data))), width=100, subsequent_indent='    '))
+        autocorrect_data_h_lines.append('};')
 
     # Show the results
     dump_lines(cli.args.output, autocorrect_data_h_lines, cli.args.quiet)
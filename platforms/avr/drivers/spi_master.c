@@ -187,6 +187,15 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+// No DMA, so asynchronous transfers complete before returning
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    return spi_transmit(data, length);
+}
+
+spi_status_t spi_transmit_wait(void) {
+    return SPI_STATUS_SUCCESS;
+}
+
 void spi_stop(void) {
     if (current_slave_pin != NO_PIN) {
         gpio_set_pin_output(current_slave_pin);
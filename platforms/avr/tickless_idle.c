@@ -0,0 +1,31 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <avr/sleep.h>
+#include <avr/interrupt.h>
+#include "tickless_idle.h"
+
+static volatile bool wakeup_pending = false;
+
+void tickless_idle_platform_sleep(uint32_t timeout_ms) {
+    // The millisecond timer interrupt wakes the core every tick regardless, so sleep until the next interrupt of any
+    // kind and let the main loop reevaluate -- LUFA/V-USB also expect to be serviced promptly after USB interrupts.
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cli();
+    if (!wakeup_pending) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    wakeup_pending = false;
+    sei();
+}
+
+void tickless_idle_wakeup_from_isr(void) {
+    wakeup_pending = true;
+}
+
+void tickless_idle_wakeup(void) {
+    wakeup_pending = true;
+}
@@ -0,0 +1,285 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <string.h>
+
+#include "serial.h"
+#include "serial_link.h"
+#include "serial_protocol.h"
+#include "synchronization_util.h"
+#include "timer.h"
+#include "util.h"
+
+/*
+ * Runs the split transactions over a serial_link, instead of one request and response at a time:
+ *   - Transactions that only write to the slave are sent and left to the link, so several are in flight at once.
+ *   - Transactions that only read from the slave are answered from the master's copy of shared memory, which the slave
+ *     keeps up to date by sending every region that changes, unasked.
+ *   - Transactions with a slave callback, or that both write and read, wait for the slave to reply. Before it replies
+ *     the slave sends whatever the callback changed, so later reads see it.
+ * Both halves run a thread that reads the line and handles retransmissions.
+ */
+
+#if !defined(SERIAL_USART_FULL_DUPLEX)
+#    error "SERIAL_PROTOCOL = v2 needs a full duplex connection, define SERIAL_USART_FULL_DUPLEX"
+#endif
+
+// Longest wait for the line before the thread looks at retransmissions and changes to send
+#ifndef SERIAL_PROTOCOL_POLL_US
+#    define SERIAL_PROTOCOL_POLL_US 250
+#endif
+
+static serial_link_t split_link;
+static bool          is_initiator;
+static MUTEX_DECL(link_mutex);
+
+// Master: the transaction waiting for a reply, and the semaphore signalled when it comes
+static int8_t awaited_transaction = -1;
+static BSEMAPHORE_DECL(reply_semaphore, true);
+
+// Slave: what the master has last been sent of each region it reads, and the transaction waiting for a reply
+static split_shared_memory_t sent_memory;
+static uint8_t               sent_valid[(NUM_TOTAL_TRANSACTIONS + 7) / 8];
+static int8_t                pending_reply = -1;
+
+static inline bool transaction_is_pushed(const split_transaction_desc_t* transaction) {
+    return transaction->target2initiator_buffer_size && !transaction->initiator2target_buffer_size && !transaction->slave_callback;
+}
+
+static inline bool transaction_needs_reply(const split_transaction_desc_t* transaction) {
+    return transaction->target2initiator_buffer_size || transaction->slave_callback;
+}
+
+static void link_write(serial_link_t* link, const uint8_t* data, size_t length) {
+    (void)link;
+    if (unlikely(!serial_transport_send(data, length))) {
+        serial_dprintf("SPLIT: sending frame failed\n");
+    }
+}
+
+/**
+ * @brief Data from the slave, either a region that changed or a reply. Either way it goes into shared memory.
+ */
+static void master_receive(serial_link_t* link, uint8_t id, uint8_t flags, const uint8_t* data, uint8_t length) {
+    (void)link;
+    if (unlikely(id >= NUM_TOTAL_TRANSACTIONS)) {
+        return;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[id];
+    if (length == transaction->target2initiator_buffer_size) {
+        split_shared_memory_lock_autounlock();
+        memcpy(split_trans_target2initiator_buffer(transaction), data, length);
+    }
+
+    if ((flags & SERIAL_LINK_REPLY) && id == awaited_transaction) {
+        awaited_transaction = -1;
+        chBSemSignal(&reply_semaphore);
+    }
+}
+
+/**
+ * @brief A transaction from the master, which is handled straight away. Replies are left to the thread.
+ */
+static void slave_receive(serial_link_t* link, uint8_t id, uint8_t flags, const uint8_t* data, uint8_t length) {
+    (void)link;
+    if (unlikely(id >= NUM_TOTAL_TRANSACTIONS)) {
+        return;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[id];
+    {
+        split_shared_memory_lock_autounlock();
+        if (length == transaction->initiator2target_buffer_size) {
+            memcpy(split_trans_initiator2target_buffer(transaction), data, length);
+        }
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+    }
+
+    if (flags & SERIAL_LINK_REQUEST) {
+        pending_reply = id;
+    }
+}
+
+/**
+ * @brief The master lost everything it had been sent, so send all of it again.
+ */
+static void slave_reset(serial_link_t* link) {
+    (void)link;
+    memset(sent_valid, 0, sizeof(sent_valid));
+    pending_reply = -1;
+}
+
+/**
+ * @brief Sends the regions the master reads that changed since they were last sent.
+ *
+ * @return false if the window filled up before everything was sent.
+ */
+static bool slave_push_changes(void) {
+    uint8_t buffer[SERIAL_LINK_PAYLOAD_SIZE];
+
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (!transaction_is_pushed(transaction) || transaction->target2initiator_buffer_size > sizeof(buffer)) {
+            continue;
+        }
+
+        uint8_t* sent  = (uint8_t*)&sent_memory + transaction->target2initiator_offset;
+        bool     valid = sent_valid[id / 8] & (1 << (id % 8));
+        {
+            split_shared_memory_lock_autounlock();
+            memcpy(buffer, split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size);
+        }
+        if (valid && memcmp(buffer, sent, transaction->target2initiator_buffer_size) == 0) {
+            continue;
+        }
+
+        /* Sending can block on the line, so it is done without holding shared memory. */
+        if (!serial_link_send(&split_link, id, 0, buffer, transaction->target2initiator_buffer_size)) {
+            return false;
+        }
+        memcpy(sent, buffer, transaction->target2initiator_buffer_size);
+        sent_valid[id / 8] |= (1 << (id % 8));
+    }
+    return true;
+}
+
+static void slave_send_reply(void) {
+    uint8_t buffer[SERIAL_LINK_PAYLOAD_SIZE];
+
+    if (pending_reply < 0 || !slave_push_changes() || !serial_link_can_send(&split_link)) {
+        return;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[pending_reply];
+    uint8_t                   length      = MIN(transaction->target2initiator_buffer_size, sizeof(buffer));
+    {
+        split_shared_memory_lock_autounlock();
+        memcpy(buffer, split_trans_target2initiator_buffer(transaction), length);
+    }
+    serial_link_send(&split_link, pending_reply, SERIAL_LINK_REPLY, buffer, length);
+    pending_reply = -1;
+}
+
+/**
+ * @brief This thread runs on both halves. It feeds the line to the link, and on the slave sends changes and replies.
+ */
+static THD_WORKING_AREA(waLinkThread, 1024);
+static THD_FUNCTION(LinkThread, arg) {
+    (void)arg;
+    uint8_t buffer[32];
+    chRegSetThreadName("split_protocol_tx_rx");
+
+    while (true) {
+        size_t received = serial_transport_receive_available(buffer, sizeof(buffer), SERIAL_PROTOCOL_POLL_US);
+
+        chMtxLock(&link_mutex);
+        while (received > 0) {
+            serial_link_receive_bytes(&split_link, buffer, received);
+            received = serial_transport_receive_available(buffer, sizeof(buffer), 0);
+        }
+        serial_link_task(&split_link);
+        if (!is_initiator && serial_link_is_connected(&split_link)) {
+            slave_send_reply();
+            slave_push_changes();
+        }
+        chMtxUnlock(&link_mutex);
+    }
+}
+
+/**
+ * @brief Slave specific initializations.
+ */
+void soft_serial_target_init(void) {
+    serial_transport_driver_slave_init();
+    serial_link_init(&split_link, false, link_write, slave_receive, slave_reset);
+    is_initiator = false;
+
+    chThdCreateStatic(waLinkThread, sizeof(waLinkThread), HIGHPRIO, LinkThread, NULL);
+}
+
+/**
+ * @brief Master specific initializations.
+ */
+void soft_serial_initiator_init(void) {
+    serial_transport_driver_master_init();
+    serial_link_init(&split_link, true, link_write, master_receive, NULL);
+    is_initiator = true;
+
+    chThdCreateStatic(waLinkThread, sizeof(waLinkThread), HIGHPRIO, LinkThread, NULL);
+}
+
+/**
+ * @brief Start transaction from the master half to the slave half.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool Indicates success of transaction.
+ */
+bool soft_serial_transaction(int index) {
+    /* Sanity check that we are actually starting a valid transaction. */
+    if (unlikely(index < 0 || index >= NUM_TOTAL_TRANSACTIONS)) {
+        serial_dprintf("SPLIT: illegal transaction id\n");
+        return false;
+    }
+
+    split_transaction_desc_t* transaction = &split_transaction_table[index];
+    if (unlikely(transaction->initiator2target_buffer_size > SERIAL_LINK_PAYLOAD_SIZE || transaction->target2initiator_buffer_size > SERIAL_LINK_PAYLOAD_SIZE)) {
+        serial_dprintf("SPLIT: transaction larger than SERIAL_LINK_PAYLOAD_SIZE\n");
+        return false;
+    }
+
+    /* Reads are answered from what the slave sent last. */
+    if (transaction_is_pushed(transaction)) {
+        return serial_link_is_connected(&split_link);
+    }
+
+    uint16_t start = timer_read();
+    while (true) {
+        chMtxLock(&link_mutex);
+        if (!serial_link_is_connected(&split_link)) {
+            chMtxUnlock(&link_mutex);
+            return false;
+        }
+        if (serial_link_can_send(&split_link)) {
+            break;
+        }
+        chMtxUnlock(&link_mutex);
+
+        /* Window is full, wait for acknowledgements to make room. */
+        if (timer_elapsed(start) > SERIAL_LINK_TIMEOUT_MS) {
+            serial_dprintf("SPLIT: no room to send\n");
+            return false;
+        }
+        chThdSleepMicroseconds(SERIAL_PROTOCOL_POLL_US);
+    }
+
+    bool needs_reply = transaction_needs_reply(transaction);
+    if (needs_reply) {
+        chBSemReset(&reply_semaphore, true);
+        awaited_transaction = index;
+    }
+    uint8_t buffer[SERIAL_LINK_PAYLOAD_SIZE];
+    {
+        split_shared_memory_lock_autounlock();
+        memcpy(buffer, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size);
+    }
+    serial_link_send(&split_link, index, needs_reply ? SERIAL_LINK_REQUEST : 0, buffer, transaction->initiator2target_buffer_size);
+    chMtxUnlock(&link_mutex);
+
+    /* Writes are left to the link, which resends them until they are acknowledged. */
+    if (!needs_reply) {
+        return true;
+    }
+
+    if (chBSemWaitTimeout(&reply_semaphore, TIME_MS2I(SERIAL_LINK_TIMEOUT_MS)) != MSG_OK) {
+        chMtxLock(&link_mutex);
+        awaited_transaction = -1;
+        chMtxUnlock(&link_mutex);
+        serial_dprintf("SPLIT: no reply\n");
+        return false;
+    }
+    return true;
+}
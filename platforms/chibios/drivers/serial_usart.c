@@ -165,6 +165,15 @@ inline bool serial_transport_receive_blocking(uint8_t* destination, const size_t
     return success;
 }
 
+inline size_t serial_transport_receive_available(uint8_t* destination, const size_t size, const uint32_t timeout_us) {
+    msg_t first = chnGetTimeout(serial_driver, timeout_us > 0 ? TIME_US2I(timeout_us) : TIME_IMMEDIATE);
+    if (first < MSG_OK || size == 0) {
+        return 0;
+    }
+    destination[0] = (uint8_t)first;
+    return 1 + chnReadTimeout(serial_driver, destination + 1, size - 1, TIME_IMMEDIATE);
+}
+
 #if !defined(SERIAL_USART_FULL_DUPLEX)
 
 /**
@@ -16,6 +16,7 @@
 
 #include "spi_master.h"
 #include "chibios_config.h"
+#include "timer.h"
 #include <ch.h>
 #include <hal.h>
 
@@ -59,6 +60,11 @@
 #    endif
 #endif
 
+// Longest wait, in milliseconds, for a transfer started by spi_transmit_async() to complete
+#ifndef SPI_TIMEOUT
+#    define SPI_TIMEOUT 100
+#endif
+
 static bool spiStarted = false;
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
 static pin_t current_slave_pin     = NO_PIN;
@@ -460,6 +466,25 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length) {
+    if (SPI_DRIVER.state != SPI_READY) {
+        return SPI_STATUS_ERROR;
+    }
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_transmit_wait(void) {
+    // The driver drops back to SPI_READY from the DMA completion interrupt
+    uint16_t timeout_timer = timer_read();
+    while (((volatile SPIDriver *)&SPI_DRIVER)->state == SPI_ACTIVE) {
+        if (timer_elapsed(timeout_timer) >= SPI_TIMEOUT) {
+            return SPI_STATUS_TIMEOUT;
+        }
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
 void spi_stop(void) {
     if (spiStarted) {
         spi_unselect();
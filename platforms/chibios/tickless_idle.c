@@ -0,0 +1,37 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include "tickless_idle.h"
+
+#ifndef TICKLESS_IDLE_WAKEUP_EVENT
+#    define TICKLESS_IDLE_WAKEUP_EVENT EVENT_MASK(0)
+#endif
+
+static thread_t *volatile sleeping_thread = NULL;
+
+void tickless_idle_platform_sleep(uint32_t timeout_ms) {
+    sleeping_thread = chThdGetSelfX();
+    // Blocking here hands the core to the idle thread, which issues WFI until the timeout or a wakeup event
+    chEvtWaitAnyTimeout(TICKLESS_IDLE_WAKEUP_EVENT, TIME_MS2I(timeout_ms));
+}
+
+void tickless_idle_wakeup(void) {
+    thread_t *thread = sleeping_thread;
+    if (thread == NULL) {
+        return;
+    }
+
+    chEvtSignal(thread, TICKLESS_IDLE_WAKEUP_EVENT);
+}
+
+void tickless_idle_wakeup_from_isr(void) {
+    thread_t *thread = sleeping_thread;
+    if (thread == NULL) {
+        return;
+    }
+
+    chSysLockFromISR();
+    chEvtSignalI(thread, TICKLESS_IDLE_WAKEUP_EVENT);
+    chSysUnlockFromISR();
+}
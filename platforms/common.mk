@@ -10,6 +10,10 @@ SRC +=	\
 	$(PLATFORM_COMMON_DIR)/timer.c \
 	$(PLATFORM_COMMON_DIR)/bootloaders/$(BOOTLOADER_TYPE).c
 
+ifeq ($(strip $(TICKLESS_IDLE_ENABLE)), yes)
+    SRC += $(PLATFORM_COMMON_DIR)/tickless_idle.c
+endif
+
 # Search Path
 VPATH += $(PLATFORM_PATH)
 VPATH += $(PLATFORM_PATH)/$(PLATFORM_KEY)
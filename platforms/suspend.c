@@ -3,6 +3,12 @@
 
 #include "suspend.h"
 #include "matrix.h"
+#ifdef SCAN_QUEUE_ENABLE
+#    include "scan_queue.h"
+#else
+#    define scan_queue_lock()
+#    define scan_queue_unlock()
+#endif
 
 extern matrix_row_t matrix_previous[MATRIX_ROWS];
 static matrix_row_t wakeup_matrix[MATRIX_ROWS];
@@ -44,9 +50,11 @@ __attribute__((weak)) void suspend_wakeup_init_kb(void) {
  * FIXME: needs doc
  */
 bool suspend_wakeup_condition(void) {
+    scan_queue_lock();
     matrix_power_up();
     matrix_scan();
     matrix_power_down();
+    scan_queue_unlock();
 
     bool wakeup = false;
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
@@ -58,9 +66,11 @@ bool suspend_wakeup_condition(void) {
 }
 
 void update_matrix_state_after_wakeup(void) {
+    scan_queue_lock();
     matrix_power_up();
     matrix_scan();
     matrix_power_down();
+    scan_queue_unlock();
 
     for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
         const matrix_row_t current_row = matrix_get_row(row);
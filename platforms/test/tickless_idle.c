@@ -0,0 +1,44 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static bool     wakeup_pending   = false;
+static bool     interrupt_queued = false;
+static uint32_t interrupt_time   = 0;
+
+// Host stand-in for a pin-change interrupt firing at the given time while the main loop sleeps
+void tickless_idle_simulate_interrupt_at(uint32_t time) {
+    interrupt_queued = true;
+    interrupt_time   = time;
+}
+
+// Sleeping on the host simply moves simulated time forward to whichever wakeup source fires first
+void tickless_idle_platform_sleep(uint32_t timeout_ms) {
+    if (wakeup_pending) {
+        wakeup_pending = false;
+        return;
+    }
+
+    uint32_t now = timer_read32();
+    if (interrupt_queued && (int32_t)(interrupt_time - now) < (int32_t)timeout_ms) {
+        interrupt_queued = false;
+        if ((int32_t)(interrupt_time - now) > 0) {
+            advance_time(interrupt_time - now);
+        }
+        return;
+    }
+
+    advance_time(timeout_ms);
+}
+
+void tickless_idle_wakeup_from_isr(void) {
+    wakeup_pending = true;
+}
+
+void tickless_idle_wakeup(void) {
+    wakeup_pending = true;
+}
@@ -0,0 +1,30 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Free-running 32-bit timestamp for measuring how long code takes to run.
+
+    Uses the ChibiOS realtime counter where the port provides one, which usually counts CPU cycles, and falls back to
+    the millisecond timer everywhere else. Differences between two reads are valid across wraparound; convert them with
+    timestamp_to_us() rather than assuming a tick length.
+*/
+
+#include <stdint.h>
+#include "timer.h"
+
+#if defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+#if defined(PROTOCOL_CHIBIOS) && (PORT_SUPPORTS_RT == TRUE)
+#    define TIMESTAMP_TICKS_PER_SECOND REALTIME_COUNTER_CLOCK
+#    define timestamp_read() chSysGetRealtimeCounterX()
+#else
+#    define TIMESTAMP_TICKS_PER_SECOND 1000
+#    define timestamp_read() timer_read32()
+#endif
+
+static inline uint32_t timestamp_to_us(uint32_t ticks) {
+    return (uint32_t)(((uint64_t)ticks * 1000000) / TIMESTAMP_TICKS_PER_SECOND);
+}
@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "keycode_config.h"
 #include "debug.h"
 #include "quantum.h"
+#include "latency_trace.h"
 
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
@@ -77,6 +78,7 @@ __attribute__((weak)) bool get_retro_tapping(uint16_t keycode, keyrecord_t *reco
  */
 void action_exec(keyevent_t event) {
     if (IS_EVENT(event)) {
+        LATENCY_TRACE(ACTION_EXEC);
         ac_dprintf("\n---- action_exec: start -----\n");
         ac_dprintf("EVENT: ");
         debug_event(event);
@@ -281,6 +283,7 @@ void process_record(keyrecord_t *record) {
     if (IS_NOEVENT(record->event)) {
         return;
     }
+    LATENCY_TRACE(PROCESS_RECORD);
 #ifdef SPECULATIVE_HOLD
     if (record->event.pressed) {
         speculative_key_settled(record);
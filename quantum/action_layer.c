@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
@@ -45,6 +46,9 @@ static void default_layer_state_set(layer_state_t state) {
     ac_dprintf("default_layer_state: ");
     default_layer_debug();
     ac_dprintf(" to ");
+#if defined(EFFECTIVE_LAYER_CACHE) && !defined(NO_ACTION_LAYER)
+    effective_layer_cache_update(layer_state | default_layer_state, layer_state | state);
+#endif
     default_layer_state = state;
     default_layer_debug();
     ac_dprintf("\n");
@@ -135,6 +139,9 @@ void layer_state_set(layer_state_t state) {
     ac_dprintf("layer_state: ");
     layer_debug();
     ac_dprintf(" to ");
+#    ifdef EFFECTIVE_LAYER_CACHE
+    effective_layer_cache_update(layer_state | default_layer_state, state | default_layer_state);
+#    endif
     layer_state = state;
     layer_debug();
     ac_dprintf("\n");
@@ -335,12 +342,12 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
 #endif
 }
 
-/** \brief Layer switch get layer
+#ifndef NO_ACTION_LAYER
+/** \brief Layer switch resolve layer
  *
- * Gets the layer based on key info
+ * Walks the active layers from the top, returning the first one with a non-transparent action for the key
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
-#ifndef NO_ACTION_LAYER
+static uint8_t layer_switch_resolve_layer(keypos_t key) {
     action_t action;
     action.code = ACTION_TRANSPARENT;
 
@@ -356,6 +363,77 @@ uint8_t layer_switch_get_layer(keypos_t key) {
     }
     /* fall back to layer 0 */
     return 0;
+}
+#endif
+
+#if defined(EFFECTIVE_LAYER_CACHE) && !defined(NO_ACTION_LAYER)
+/** \brief effective layer cache
+ *
+ * Topmost non-transparent layer for each matrix position. Entries are resolved on first use and only the ones that
+ * may have been affected are invalidated when the layer state or the keymap changes.
+ */
+static uint8_t effective_layer_cache[MATRIX_ROWS * MATRIX_COLS];
+static uint8_t effective_layer_cache_valid[((MATRIX_ROWS * MATRIX_COLS) + (CHAR_BIT)-1) / (CHAR_BIT)];
+
+/** \brief Effective layer cache invalidate
+ *
+ * Drops every cached entry, forcing each key to be resolved again on its next lookup
+ */
+void effective_layer_cache_invalidate(void) {
+    memset(effective_layer_cache_valid, 0, sizeof(effective_layer_cache_valid));
+}
+
+/** \brief Effective layer cache invalidate key
+ *
+ * Drops the cached entry for a single matrix position, used when its keycode changes on any layer
+ */
+void effective_layer_cache_invalidate_key(uint8_t row, uint8_t col) {
+    if (row < MATRIX_ROWS && col < MATRIX_COLS) {
+        const uint16_t entry_number = (uint16_t)(row * MATRIX_COLS) + col;
+        effective_layer_cache_valid[entry_number / (CHAR_BIT)] &= ~(1U << (entry_number % (CHAR_BIT)));
+    }
+}
+
+/** \brief Effective layer cache update
+ *
+ * Invalidates the entries affected by a change of the combined layer state. A key that resolved to a layer above
+ * every layer that changed is unaffected, as everything from its winning layer upwards is still the same.
+ */
+void effective_layer_cache_update(layer_state_t old_state, layer_state_t new_state) {
+    const layer_state_t changed = old_state ^ new_state;
+    if (!changed) {
+        return;
+    }
+
+    const uint8_t highest_changed = get_highest_layer(changed);
+    for (uint16_t entry_number = 0; entry_number < (MATRIX_ROWS * MATRIX_COLS); entry_number++) {
+        if (effective_layer_cache[entry_number] <= highest_changed) {
+            effective_layer_cache_valid[entry_number / (CHAR_BIT)] &= ~(1U << (entry_number % (CHAR_BIT)));
+        }
+    }
+}
+#endif
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+#ifndef NO_ACTION_LAYER
+#    ifdef EFFECTIVE_LAYER_CACHE
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        const uint16_t entry_number = (uint16_t)(key.row * MATRIX_COLS) + key.col;
+        const uint16_t storage_idx  = entry_number / (CHAR_BIT);
+        const uint8_t  storage_bit  = entry_number % (CHAR_BIT);
+
+        if (!(effective_layer_cache_valid[storage_idx] & (1U << storage_bit))) {
+            effective_layer_cache[entry_number] = layer_switch_resolve_layer(key);
+            effective_layer_cache_valid[storage_idx] |= (1U << storage_bit);
+        }
+        return effective_layer_cache[entry_number];
+    }
+#    endif
+    return layer_switch_resolve_layer(key);
 #else
     return get_highest_layer(default_layer_state);
 #endif
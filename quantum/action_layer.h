@@ -169,5 +169,16 @@ action_t store_or_get_action(bool pressed, keypos_t key);
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
+/* effective layer cache, must be invalidated whenever the keymap changes outside of dynamic keymap */
+#if defined(EFFECTIVE_LAYER_CACHE) && !defined(NO_ACTION_LAYER)
+void effective_layer_cache_invalidate(void);
+void effective_layer_cache_invalidate_key(uint8_t row, uint8_t col);
+void effective_layer_cache_update(layer_state_t old_state, layer_state_t new_state);
+#else
+#    define effective_layer_cache_invalidate()
+#    define effective_layer_cache_invalidate_key(row, col)
+#    define effective_layer_cache_update(old_state, new_state)
+#endif
+
 /* return action depending on current layer status */
 action_t layer_switch_get_action(keypos_t key);
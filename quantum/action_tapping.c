@@ -1,5 +1,6 @@
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "action.h"
 #include "action_layer.h"
@@ -132,8 +133,17 @@ static keyrecord_t waiting_buffer[WAITING_BUFFER_SIZE] = {};
 static uint8_t     waiting_buffer_head                 = 0;
 static uint8_t     waiting_buffer_tail                 = 0;
 
+#    ifdef WAITING_BUFFER_KEY_INDEX
+// Number of buffered presses ([1]) and releases ([0]) of each key position in the matrix, so that looking for the
+// opposite event of a key doesn't have to scan the buffer
+static uint8_t waiting_buffer_key_count[MATRIX_ROWS][MATRIX_COLS][2] = {};
+#    endif
+
 static bool process_tapping(keyrecord_t *record);
 static bool waiting_buffer_enq(keyrecord_t record);
+static void waiting_buffer_pop(void);
+static void waiting_buffer_process(void);
+static void waiting_buffer_settle_early(void);
 static void waiting_buffer_clear(void);
 static bool waiting_buffer_typed(keyevent_t event);
 static bool waiting_buffer_has_anykey_pressed(void);
@@ -153,6 +163,10 @@ void action_tapping_process(keyrecord_t record) {
     }
 #    endif // SPECULATIVE_HOLD
 
+    if (IS_EVENT(record.event)) {
+        waiting_buffer_settle_early();
+    }
+
     if (process_tapping(&record)) {
         if (IS_EVENT(record.event)) {
             ac_dprintf("processed: ");
@@ -179,15 +193,7 @@ void action_tapping_process(keyrecord_t record) {
     if (IS_EVENT(record.event) && waiting_buffer_head != waiting_buffer_tail) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
-            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
-            debug_record(waiting_buffer[waiting_buffer_tail]);
-            ac_dprintf("\n\n");
-        } else {
-            break;
-        }
-    }
+    waiting_buffer_process();
     if (IS_EVENT(record.event)) {
         ac_dprintf("\n");
     } else {
@@ -323,7 +329,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     // Now that tapping_key has settled as tapped, check whether
                     // Flow Tap applies to following yet-unsettled keys.
                     uint16_t prev_time = tapping_key.event.time;
-                    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+                    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
                         keyrecord_t *record = &waiting_buffer[waiting_buffer_tail];
                         if (!record->event.pressed) {
                             break;
@@ -383,7 +389,7 @@ bool process_tapping(keyrecord_t *keyp) {
                     uint8_t first_tap = waiting_buffer_find_chordal_hold_tap();
                     ac_dprintf("first_tap = %u\n", first_tap);
                     if (first_tap < WAITING_BUFFER_SIZE) {
-                        for (; waiting_buffer_tail != first_tap; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+                        for (; waiting_buffer_tail != first_tap; waiting_buffer_pop()) {
                             ac_dprintf("Processing [%u]\n", waiting_buffer_tail);
                             process_record(&waiting_buffer[waiting_buffer_tail]);
                         }
@@ -483,7 +489,7 @@ bool process_tapping(keyrecord_t *keyp) {
                                 if (waiting_buffer_tail != waiting_buffer_head && is_tap_record(&waiting_buffer[waiting_buffer_tail])) {
                                     tapping_key = waiting_buffer[waiting_buffer_tail];
                                     // Pop tail from the queue.
-                                    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+                                    waiting_buffer_pop();
                                     debug_waiting_buffer();
                                 } else
 #    endif // CHORDAL_HOLD
@@ -666,12 +672,61 @@ bool waiting_buffer_enq(keyrecord_t record) {
 
     waiting_buffer[waiting_buffer_head] = record;
     waiting_buffer_head                 = (waiting_buffer_head + 1) % WAITING_BUFFER_SIZE;
+#    ifdef WAITING_BUFFER_KEY_INDEX
+    if (record.event.key.row < MATRIX_ROWS && record.event.key.col < MATRIX_COLS) {
+        waiting_buffer_key_count[record.event.key.row][record.event.key.col][record.event.pressed]++;
+    }
+#    endif
 
     ac_dprintf("waiting_buffer_enq: ");
     debug_waiting_buffer();
     return true;
 }
 
+/** \brief Removes the oldest event from the waiting buffer. */
+static void waiting_buffer_pop(void) {
+#    ifdef WAITING_BUFFER_KEY_INDEX
+    const keyevent_t event = waiting_buffer[waiting_buffer_tail].event;
+    if (event.key.row < MATRIX_ROWS && event.key.col < MATRIX_COLS) {
+        waiting_buffer_key_count[event.key.row][event.key.col][event.pressed]--;
+    }
+#    endif
+    waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+}
+
+/** \brief Processes buffered events in order until one has to wait for the tapping key again. */
+static void waiting_buffer_process(void) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
+        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+            ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
+            debug_record(waiting_buffer[waiting_buffer_tail]);
+            ac_dprintf("\n\n");
+        } else {
+            break;
+        }
+    }
+}
+
+/** \brief Keeps room in the waiting buffer for the next event.
+ *
+ * Once WAITING_BUFFER_WATERMARK events are waiting on an unsettled tap-hold
+ * key, the key is settled as held, the same way as when its tapping term runs
+ * out, and the buffered events are processed. Nothing is dropped.
+ */
+static void waiting_buffer_settle_early(void) {
+    while ((waiting_buffer_head + WAITING_BUFFER_SIZE - waiting_buffer_tail) % WAITING_BUFFER_SIZE >= WAITING_BUFFER_WATERMARK) {
+        if (tapping_key.event.pressed && tapping_key.tap.count == 0) {
+            ac_dprintf("Tapping: End. Waiting buffer full. Not tap(0).\n");
+            process_record(&tapping_key);
+        }
+        tapping_key = (keyrecord_t){0};
+        debug_tapping_key();
+
+        // With no tapping key, at least the oldest event gets processed
+        waiting_buffer_process();
+    }
+}
+
 /** \brief Waiting buffer clear
  *
  * FIXME: Needs docs
@@ -679,13 +734,21 @@ bool waiting_buffer_enq(keyrecord_t record) {
 void waiting_buffer_clear(void) {
     waiting_buffer_head = 0;
     waiting_buffer_tail = 0;
+#    ifdef WAITING_BUFFER_KEY_INDEX
+    memset(waiting_buffer_key_count, 0, sizeof(waiting_buffer_key_count));
+#    endif
 }
 
 /** \brief Waiting buffer typed
  *
- * FIXME: Needs docs
+ * Checks whether the opposite event of the same key is waiting in the buffer.
  */
 bool waiting_buffer_typed(keyevent_t event) {
+#    ifdef WAITING_BUFFER_KEY_INDEX
+    if (event.key.row < MATRIX_ROWS && event.key.col < MATRIX_COLS) {
+        return waiting_buffer_key_count[event.key.row][event.key.col][!event.pressed] != 0;
+    }
+#    endif
     for (uint8_t i = waiting_buffer_tail; i != waiting_buffer_head; i = (i + 1) % WAITING_BUFFER_SIZE) {
         if (KEYEQ(event.key, waiting_buffer[i].event.key) && event.pressed != waiting_buffer[i].event.pressed) {
             return true;
@@ -717,6 +780,13 @@ void waiting_buffer_scan_tap(void) {
         return;
     }
 
+#    ifdef WAITING_BUFFER_KEY_INDEX
+    // Nothing to find unless a release of the tapping key is waiting
+    if (tapping_key.event.key.row < MATRIX_ROWS && tapping_key.event.key.col < MATRIX_COLS && waiting_buffer_key_count[tapping_key.event.key.row][tapping_key.event.key.col][0] == 0) {
+        return;
+    }
+#    endif
+
 #    if (defined(AUTO_SHIFT_ENABLE) && defined(RETRO_SHIFT))
     TAP_DEFINE_KEYCODE;
 #    endif
@@ -968,7 +1038,7 @@ static void waiting_buffer_chordal_hold_taps_until(keypos_t key) {
             registered_taps_add(record->event.key);
         }
         process_record(record);
-        waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE;
+        waiting_buffer_pop();
 
         if (KEYEQ(key, record->event.key) && record->event.pressed) {
             break;
@@ -977,7 +1047,7 @@ static void waiting_buffer_chordal_hold_taps_until(keypos_t key) {
 }
 
 static void waiting_buffer_process_regular(void) {
-    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
+    for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_pop()) {
         if (is_tap_record(&waiting_buffer[waiting_buffer_tail])) {
             break; // Stop once a tap-hold key event is reached.
         }
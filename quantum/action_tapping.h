@@ -32,7 +32,23 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    define TAPPING_TOGGLE 5
 #endif
 
-#define WAITING_BUFFER_SIZE 8
+/* slots in the ring of events held back while a tap-hold key is unsettled, one of which is always free */
+#ifndef WAITING_BUFFER_SIZE
+#    define WAITING_BUFFER_SIZE 8
+#endif
+
+#if WAITING_BUFFER_SIZE < 2 || WAITING_BUFFER_SIZE > 255
+#    error "WAITING_BUFFER_SIZE must be between 2 and 255"
+#endif
+
+/* buffered events at which the unsettled tap-hold key is settled early */
+#ifndef WAITING_BUFFER_WATERMARK
+#    define WAITING_BUFFER_WATERMARK (WAITING_BUFFER_SIZE - 1)
+#endif
+
+#if WAITING_BUFFER_WATERMARK < 1 || WAITING_BUFFER_WATERMARK > WAITING_BUFFER_SIZE - 1
+#    error "WAITING_BUFFER_WATERMARK must be between 1 and WAITING_BUFFER_SIZE - 1"
+#endif
 
 #ifndef NO_ACTION_TAPPING
 uint16_t get_record_keycode(keyrecord_t *record, bool update_layer_cache);
@@ -23,10 +23,9 @@
 
 #if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
 #    define TIMESTAMP_GETTER TCNT0
-#elif defined(PROTOCOL_CHIBIOS)
-#    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
 #else
-#    error Unknown protocol in use
+#    include "timestamp.h"
+#    define TIMESTAMP_GETTER timestamp_read()
 #endif
 
 #ifndef CONSOLE_ENABLE
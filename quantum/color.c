@@ -108,3 +108,66 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+// Which of {v, p, q, t} goes to each of r, g and b in each hue region, matching the switch in hsv_to_rgb_impl()
+static const uint8_t hsv_region_channels[7][3] = {
+    {0, 3, 1}, // v, t, p
+    {2, 0, 1}, // q, v, p
+    {1, 0, 3}, // p, v, t
+    {1, 2, 0}, // p, q, v
+    {3, 1, 0}, // t, p, v
+    {0, 1, 2}, // v, p, q
+    {0, 3, 1}, // v, t, p
+};
+
+static inline void hsv_to_rgb_pixel(uint8_t h, uint8_t s, uint8_t v, rgb_t *rgb) {
+    uint8_t channels[4] = {v, v, v, v};
+    uint8_t region      = 0;
+
+    if (s != 0) {
+        // Exactly h * 6 / 255 for every hue, without the division
+        region                  = ((uint32_t)h * 1539 + 771) >> 16;
+        const uint8_t remainder = (h * 2 - region * 85) * 3;
+
+        // Each product fits in 16 bits, so a single 32-bit multiply computes a pair of them side by side
+        const uint32_t sr = (uint32_t)s * (remainder | (uint32_t)(255 - remainder) << 16);
+        const uint32_t qt = (uint32_t)v * ((255 - (uint8_t)(sr >> 8)) | (uint32_t)(255 - (uint8_t)(sr >> 24)) << 16);
+
+        channels[1] = (v * (255 - s)) >> 8;
+        channels[2] = qt >> 8;
+        channels[3] = qt >> 24;
+    }
+
+    const uint8_t *order = hsv_region_channels[region];
+    rgb->r               = channels[order[0]];
+    rgb->g               = channels[order[1]];
+    rgb->b               = channels[order[2]];
+}
+
+static void hsv_to_rgb_frame_impl(const hsv_t *hsv, rgb_t *rgb, uint16_t count, bool use_cie) {
+#ifdef USE_CIE1931_CURVE
+    if (use_cie) {
+        for (uint16_t i = 0; i < count; i++) {
+            const hsv_t pixel = hsv[i];
+            hsv_to_rgb_pixel(pixel.h, pixel.s, pgm_read_byte(&CIE1931_CURVE[pixel.v]), &rgb[i]);
+        }
+        return;
+    }
+#endif
+    for (uint16_t i = 0; i < count; i++) {
+        const hsv_t pixel = hsv[i];
+        hsv_to_rgb_pixel(pixel.h, pixel.s, pixel.v, &rgb[i]);
+    }
+}
+
+void hsv_to_rgb_frame(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_frame_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_frame_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_nocie_frame(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+    hsv_to_rgb_frame_impl(hsv, rgb, count, false);
+}
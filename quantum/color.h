@@ -95,3 +95,11 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+/**
+ * \brief Converts a whole array of colors, giving the same results as calling hsv_to_rgb() on each one.
+ *
+ * `rgb` may point to the same memory as `hsv`, to convert a frame in place.
+ */
+void hsv_to_rgb_frame(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
+void hsv_to_rgb_nocie_frame(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
@@ -16,3 +16,11 @@
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed);
 
 void debounce_init(void);
+
+/**
+ * @brief Whether a raw change is still waiting to be debounced.
+ *
+ * @return true The next calls to debounce() may still change cooked, without any further raw change
+ * @return false Cooked only changes again once raw does
+ */
+bool debounce_pending(void);
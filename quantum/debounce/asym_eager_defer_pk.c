@@ -69,6 +69,10 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
     return cooked_changed;
 }
 
+bool debounce_pending(void) {
+    return counters_need_update || matrix_need_update;
+}
+
 /**
  * @brief Processes per-key debounce counters and updates the debounced matrix state.
  *
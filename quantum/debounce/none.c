@@ -32,3 +32,7 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
 
     return cooked_changed;
 }
+
+bool debounce_pending(void) {
+    return false;
+}
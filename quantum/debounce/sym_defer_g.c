@@ -20,12 +20,13 @@
 
 #if DEBOUNCE > 0
 
+static fast_timer_t debouncing_time;
+static bool         debouncing = false;
+
 void debounce_init(void) {}
 
 bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
-    static fast_timer_t debouncing_time;
-    static bool         debouncing     = false;
-    bool                cooked_changed = false;
+    bool cooked_changed = false;
 
     if (changed) {
         debouncing      = true;
@@ -42,6 +43,10 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
     return cooked_changed;
 }
 
+bool debounce_pending(void) {
+    return debouncing;
+}
+
 #else // no debouncing.
 #    include "none.c"
 #endif
@@ -63,6 +63,10 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
     return cooked_changed;
 }
 
+bool debounce_pending(void) {
+    return counters_need_update;
+}
+
 /**
  * @brief Updates debounce counters and transfers debounced key states if the debounce period has expired.
  *
@@ -0,0 +1,176 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// Symmetric per-key algorithm using vertical counters. Has the same behaviour as sym_defer_pk, but the counters are
+// stored as bit planes: plane N of a row holds bit N of the counter of every key in that row, so a whole row of
+// counters is updated with a handful of word-wide operations regardless of the number of columns.
+// When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+
+#include "debounce.h"
+#include "timer.h"
+#include "util.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+#if DEBOUNCE > 0
+// Number of bit planes needed to hold a counter value of DEBOUNCE
+#    if DEBOUNCE < 2
+#        define DEBOUNCE_COUNTER_BITS 1
+#    elif DEBOUNCE < 4
+#        define DEBOUNCE_COUNTER_BITS 2
+#    elif DEBOUNCE < 8
+#        define DEBOUNCE_COUNTER_BITS 3
+#    elif DEBOUNCE < 16
+#        define DEBOUNCE_COUNTER_BITS 4
+#    elif DEBOUNCE < 32
+#        define DEBOUNCE_COUNTER_BITS 5
+#    elif DEBOUNCE < 64
+#        define DEBOUNCE_COUNTER_BITS 6
+#    elif DEBOUNCE < 128
+#        define DEBOUNCE_COUNTER_BITS 7
+#    else
+#        define DEBOUNCE_COUNTER_BITS 8
+#    endif
+
+// A key's counter is zero when it has elapsed.
+// Uses MATRIX_ROWS_PER_HAND instead of MATRIX_ROWS to support split keyboards
+static matrix_row_t debounce_counters[MATRIX_ROWS_PER_HAND][DEBOUNCE_COUNTER_BITS];
+static bool         counters_need_update;
+static bool         cooked_changed;
+
+static inline void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time);
+static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[]);
+
+void debounce_init(void) {}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
+    static fast_timer_t last_time;
+    bool                updated_last = false;
+    cooked_changed                   = false;
+
+    if (counters_need_update) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+
+        if (elapsed_time > 0) {
+            // Counters never exceed DEBOUNCE, so clamping to it keeps the subtrahend within the bit planes
+            update_debounce_counters_and_transfer_if_expired(raw, cooked, MIN(elapsed_time, DEBOUNCE));
+        }
+    }
+
+    if (changed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_counters(raw, cooked);
+    }
+
+    return cooked_changed;
+}
+
+bool debounce_pending(void) {
+    return counters_need_update;
+}
+
+/**
+ * @brief Returns a mask of the keys in a row whose debounce counter is running.
+ */
+static inline matrix_row_t running_debounce_counters(const matrix_row_t counter[]) {
+    matrix_row_t running = 0;
+    for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+        running |= counter[bit];
+    }
+    return running;
+}
+
+/**
+ * @brief Updates debounce counters and transfers debounced key states if the debounce period has expired.
+ *
+ * Subtracts the elapsed time from all counters of a row at once with a ripple-borrow subtraction across the bit
+ * planes. A key expires when its counter would reach zero or underflow, at which point its debounced state is
+ * updated to match the raw state and its counter is cleared.
+ *
+ * @param raw The current raw key state matrix.
+ * @param cooked The debounced key state matrix to be updated.
+ * @param elapsed_time The time elapsed since the last debounce update, in milliseconds, at most DEBOUNCE.
+ */
+static inline void update_debounce_counters_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time) {
+    counters_need_update = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        matrix_row_t *counter = debounce_counters[row];
+        matrix_row_t  running = running_debounce_counters(counter);
+
+        if (!running) {
+            continue;
+        }
+
+        matrix_row_t borrow    = 0;
+        matrix_row_t remaining = 0;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            matrix_row_t value = counter[bit];
+            if (elapsed_time & (1 << bit)) {
+                counter[bit] = ~(value ^ borrow);
+                borrow       = ~value | borrow;
+            } else {
+                counter[bit] = value ^ borrow;
+                borrow       = ~value & borrow;
+            }
+            remaining |= counter[bit];
+        }
+
+        matrix_row_t expired = running & (borrow | ~remaining);
+        matrix_row_t keep    = running & ~expired;
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter[bit] &= keep;
+        }
+
+        if (expired) {
+            matrix_row_t cooked_next = (cooked[row] & ~expired) | (raw[row] & expired);
+            cooked_changed |= cooked[row] ^ cooked_next;
+            cooked[row] = cooked_next;
+        }
+        if (keep) {
+            counters_need_update = true;
+        }
+    }
+}
+
+/**
+ * @brief Initializes debounce counters for keys with changed states.
+ *
+ * Keys whose raw state differs from the debounced state start counting from DEBOUNCE unless their counter is already
+ * running. Counters of keys that match their debounced state again are cleared.
+ *
+ * @param raw The current raw key state matrix.
+ * @param cooked The debounced key state matrix.
+ */
+static inline void start_debounce_counters(matrix_row_t raw[], matrix_row_t cooked[]) {
+    for (uint8_t row = 0; row < MATRIX_ROWS_PER_HAND; row++) {
+        matrix_row_t *counter = debounce_counters[row];
+        matrix_row_t  delta   = raw[row] ^ cooked[row];
+        matrix_row_t  start   = delta & ~running_debounce_counters(counter);
+
+        for (uint8_t bit = 0; bit < DEBOUNCE_COUNTER_BITS; bit++) {
+            counter[bit] = (counter[bit] & delta) | (((DEBOUNCE >> bit) & 1) ? start : 0);
+        }
+        if (start) {
+            counters_need_update = true;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
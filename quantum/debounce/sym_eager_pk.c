@@ -77,6 +77,10 @@ bool debounce(matrix_row_t raw[], matrix_row_t cooked[], bool changed) {
     return cooked_changed;
 }
 
+bool debounce_pending(void) {
+    return counters_need_update || matrix_need_update;
+}
+
 /**
  * @brief Updates per-key debounce counters and determines if matrix needs updating.
  *
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <stddef.h>
+#include <string.h>
 #include <timer.h>
 #include <deferred_exec.h>
 
@@ -156,22 +157,386 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *deadline) {
+    bool     found    = false;
+    uint32_t now      = timer_read32();
+    uint32_t earliest = 0;
+
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN && (!found || ((int32_t)TIMER_DIFF_32(entry->trigger_time, earliest)) < 0)) {
+            earliest = entry->trigger_time;
+            found    = true;
+        }
+    }
+
+    if (found && deadline) {
+        // Anything overdue is due right now
+        *deadline = ((int32_t)TIMER_DIFF_32(earliest, now)) < 0 ? now : earliest;
+    }
+    return found;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
+// Backed by a hierarchical timer wheel rather than a flat table, so that scheduling and cancellation are O(1) and
+// each tick only touches the executors that are actually due. Four levels of 32 slots cover ~17 minutes with 1ms
+// resolution at the bottom level; anything further out is parked in the top level and re-cascaded until it fits.
+//
+
+#define WHEEL_SLOT_BITS 5
+#define WHEEL_SLOTS (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS 4
+#define WHEEL_MAX_DELTA ((1UL << (WHEEL_SLOT_BITS * WHEEL_LEVELS)) - 1)
+
+#define WHEEL_NONE 0xFF
+#define WHEEL_FIRING_LIST (WHEEL_LEVELS * WHEEL_SLOTS)
+
+_Static_assert(MAX_DEFERRED_EXECUTORS > 0 && MAX_DEFERRED_EXECUTORS < WHEEL_NONE, "MAX_DEFERRED_EXECUTORS must be between 1 and 254");
+
+// Tokens encode the slot index plus a generation counter, so lookups are O(1) while stale tokens are still rejected
+#define WHEEL_GENERATIONS (255 / MAX_DEFERRED_EXECUTORS)
+
+// Beyond this many elapsed ticks, the wheel is rebuilt around the current time instead of stepping through every tick
+#define WHEEL_FAST_FORWARD_TICKS WHEEL_SLOTS
+
+typedef struct wheel_executor_t {
+    deferred_token         token;
+    uint8_t                generation;
+    uint8_t                list;
+    uint8_t                next;
+    uint8_t                prev;
+    uint32_t               trigger_time;
+    deferred_exec_callback callback;
+    void                  *cb_arg;
+} wheel_executor_t;
+
+static wheel_executor_t basic_executors[MAX_DEFERRED_EXECUTORS];
+static uint8_t          wheel_heads[WHEEL_FIRING_LIST + 1];
+static uint32_t         wheel_occupied[WHEEL_LEVELS];
+static uint32_t         wheel_now;
+static uint8_t          free_head;
+static uint8_t          active_count;
+static bool             wheel_initialized = false;
+
+static void wheel_init(void) {
+    memset(wheel_heads, WHEEL_NONE, sizeof(wheel_heads));
+    memset(wheel_occupied, 0, sizeof(wheel_occupied));
+    for (uint8_t i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        basic_executors[i].token = INVALID_DEFERRED_TOKEN;
+        basic_executors[i].list  = WHEEL_NONE;
+        basic_executors[i].next  = (i + 1 < MAX_DEFERRED_EXECUTORS) ? i + 1 : WHEEL_NONE;
+    }
+    free_head         = 0;
+    active_count      = 0;
+    wheel_now         = timer_read32();
+    wheel_initialized = true;
+}
+
+static inline void wheel_ensure_initialized(void) {
+    if (!wheel_initialized) {
+        wheel_init();
+    }
+}
+
+static void list_push(uint8_t list, uint8_t idx) {
+    wheel_executor_t *entry = &basic_executors[idx];
+    entry->list             = list;
+    entry->prev             = WHEEL_NONE;
+    entry->next             = wheel_heads[list];
+    if (entry->next != WHEEL_NONE) {
+        basic_executors[entry->next].prev = idx;
+    }
+    wheel_heads[list] = idx;
+    if (list < WHEEL_FIRING_LIST) {
+        wheel_occupied[list / WHEEL_SLOTS] |= (1UL << (list % WHEEL_SLOTS));
+    }
+}
+
+static void list_remove(uint8_t idx) {
+    wheel_executor_t *entry = &basic_executors[idx];
+    uint8_t           list  = entry->list;
+    if (list == WHEEL_NONE) {
+        return;
+    }
+    if (entry->prev != WHEEL_NONE) {
+        basic_executors[entry->prev].next = entry->next;
+    } else {
+        wheel_heads[list] = entry->next;
+    }
+    if (entry->next != WHEEL_NONE) {
+        basic_executors[entry->next].prev = entry->prev;
+    }
+    if (list < WHEEL_FIRING_LIST && wheel_heads[list] == WHEEL_NONE) {
+        wheel_occupied[list / WHEEL_SLOTS] &= ~(1UL << (list % WHEEL_SLOTS));
+    }
+    entry->list = WHEEL_NONE;
+    entry->next = WHEEL_NONE;
+    entry->prev = WHEEL_NONE;
+}
+
+static void wheel_insert(uint8_t idx) {
+    uint32_t trigger_time = basic_executors[idx].trigger_time;
+    int32_t  delta        = (int32_t)TIMER_DIFF_32(trigger_time, wheel_now);
+
+    // Overdue executors go into the very next tick
+    if (delta <= 0) {
+        trigger_time = wheel_now + 1;
+        delta        = 1;
+    } else if ((uint32_t)delta > WHEEL_MAX_DELTA) {
+        // Too far out for the wheel -- park it as far away as possible, it'll be re-cascaded from there
+        trigger_time = wheel_now + WHEEL_MAX_DELTA;
+        delta        = WHEEL_MAX_DELTA;
+    }
+
+    uint8_t level = 0;
+    while (level < (WHEEL_LEVELS - 1) && (uint32_t)delta >= (1UL << (WHEEL_SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    uint8_t slot = (trigger_time >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK;
+    list_push(level * WHEEL_SLOTS + slot, idx);
+}
+
+static void wheel_free(uint8_t idx) {
+    wheel_executor_t *entry = &basic_executors[idx];
+    list_remove(idx);
+    entry->token    = INVALID_DEFERRED_TOKEN;
+    entry->callback = NULL;
+    entry->cb_arg   = NULL;
+    entry->next     = free_head;
+    free_head       = idx;
+    --active_count;
+}
+
+static inline int16_t wheel_lookup(deferred_token token) {
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return -1;
+    }
+    uint8_t idx = (token - 1) % MAX_DEFERRED_EXECUTORS;
+    if (basic_executors[idx].token != token) {
+        return -1;
+    }
+    return idx;
+}
+
+static void wheel_cascade(uint8_t level) {
+    uint8_t list = level * WHEEL_SLOTS + ((wheel_now >> (WHEEL_SLOT_BITS * level)) & WHEEL_SLOT_MASK);
+    while (wheel_heads[list] != WHEEL_NONE) {
+        uint8_t idx = wheel_heads[list];
+        list_remove(idx);
+        if (basic_executors[idx].trigger_time == wheel_now) {
+            // Due on this very tick -- the current level 0 slot is drained straight after cascading
+            list_push(wheel_now & WHEEL_SLOT_MASK, idx);
+        } else {
+            wheel_insert(idx);
+        }
+    }
+}
+
+static void wheel_insert_overdue(uint8_t idx) {
+    // Overdue executors all share the next tick's slot, which fires from the tail -- keep it ordered latest first from
+    // the head so they still fire oldest first
+    wheel_executor_t *entry = &basic_executors[idx];
+    uint8_t           list  = (wheel_now + 1) & WHEEL_SLOT_MASK;
+    uint8_t           prev  = WHEEL_NONE;
+    uint8_t           next  = wheel_heads[list];
+    while (next != WHEEL_NONE && ((int32_t)TIMER_DIFF_32(basic_executors[next].trigger_time, entry->trigger_time)) > 0) {
+        prev = next;
+        next = basic_executors[next].next;
+    }
+    if (prev == WHEEL_NONE) {
+        list_push(list, idx);
+        return;
+    }
+    entry->list                = list;
+    entry->prev                = prev;
+    entry->next                = next;
+    basic_executors[prev].next = idx;
+    if (next != WHEEL_NONE) {
+        basic_executors[next].prev = idx;
+    }
+}
+
+static void wheel_rebase(uint32_t now) {
+    // Everything is put back relative to the new position in a single pass. Anything due in between becomes overdue
+    // and fires on the next tick, just as a flat table would after the main loop was held up.
+    memset(wheel_heads, WHEEL_NONE, sizeof(wheel_heads));
+    memset(wheel_occupied, 0, sizeof(wheel_occupied));
+    wheel_now = now;
+
+    for (uint8_t idx = 0; idx < MAX_DEFERRED_EXECUTORS; ++idx) {
+        wheel_executor_t *entry = &basic_executors[idx];
+        if (entry->token == INVALID_DEFERRED_TOKEN) {
+            continue;
+        }
+        if (((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
+            wheel_insert_overdue(idx);
+        } else {
+            wheel_insert(idx);
+        }
+    }
+}
 
-static uint32_t            last_deferred_exec_check                = 0;
-static deferred_executor_t basic_executors[MAX_DEFERRED_EXECUTORS] = {0};
+static void wheel_tick(void) {
+    ++wheel_now;
+
+    // Pull down anything from the upper levels whose window has just started, highest level first
+    uint8_t cascade_levels = 0;
+    while (cascade_levels < (WHEEL_LEVELS - 1) && (wheel_now & ((1UL << (WHEEL_SLOT_BITS * (cascade_levels + 1))) - 1)) == 0) {
+        ++cascade_levels;
+    }
+    for (uint8_t level = cascade_levels; level > 0; --level) {
+        wheel_cascade(level);
+    }
+
+    // Move everything that's due onto the firing list, so callbacks can freely schedule/cancel while we execute
+    uint8_t list = wheel_now & WHEEL_SLOT_MASK;
+    while (wheel_heads[list] != WHEEL_NONE) {
+        uint8_t idx = wheel_heads[list];
+        list_remove(idx);
+        list_push(WHEEL_FIRING_LIST, idx);
+    }
+
+    while (wheel_heads[WHEEL_FIRING_LIST] != WHEEL_NONE) {
+        uint8_t           idx        = wheel_heads[WHEEL_FIRING_LIST];
+        wheel_executor_t *entry      = &basic_executors[idx];
+        deferred_token    curr_token = entry->token;
+        list_remove(idx);
+
+        // Invoke the callback and work work out if we should be requeued
+        uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+        // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
+        if (entry->token != curr_token) {
+            continue;
+        }
+
+        // The callback may have extended itself, which already put it back on the wheel
+        list_remove(idx);
+
+        if (delay_ms > 0) {
+            // Intentionally add just the delay to the existing trigger time -- this ensures the next invocation is
+            // with respect to the previous trigger, rather than when it got to execution.
+            entry->trigger_time += delay_ms;
+            wheel_insert(idx);
+        } else {
+            wheel_free(idx);
+        }
+    }
+}
 
 deferred_token defer_exec(uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
-    return defer_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, delay_ms, callback, cb_arg);
+    // Ignore queueing if it's a zero-time delay, or the callback is not valid
+    if (delay_ms == 0 || !callback) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    wheel_ensure_initialized();
+
+    // None available
+    if (free_head == WHEEL_NONE) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    uint8_t           idx   = free_head;
+    wheel_executor_t *entry = &basic_executors[idx];
+    free_head               = entry->next;
+    ++active_count;
+
+    entry->generation   = (entry->generation + 1) % WHEEL_GENERATIONS;
+    entry->token        = (entry->generation * MAX_DEFERRED_EXECUTORS) + idx + 1;
+    entry->trigger_time = timer_read32() + delay_ms;
+    entry->callback     = callback;
+    entry->cb_arg       = cb_arg;
+    entry->list         = WHEEL_NONE;
+    wheel_insert(idx);
+    return entry->token;
 }
+
 bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
-    return extend_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token, delay_ms);
+    if (delay_ms == 0 || !wheel_initialized) {
+        return false;
+    }
+
+    int16_t idx = wheel_lookup(token);
+    if (idx < 0) {
+        return false;
+    }
+
+    list_remove(idx);
+    basic_executors[idx].trigger_time = timer_read32() + delay_ms;
+    wheel_insert(idx);
+    return true;
 }
+
 bool cancel_deferred_exec(deferred_token token) {
-    return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
+    if (!wheel_initialized) {
+        return false;
+    }
+
+    int16_t idx = wheel_lookup(token);
+    if (idx < 0) {
+        return false;
+    }
+
+    wheel_free(idx);
+    return true;
+}
+
+bool deferred_exec_next_deadline(uint32_t *deadline) {
+    if (!wheel_initialized || active_count == 0) {
+        return false;
+    }
+
+    // Within each level the first occupied slot after the current position holds that level's earliest executors.
+    // Levels can overlap in time, so the earliest of each needs to be compared.
+    bool     found    = false;
+    uint32_t earliest = 0;
+    for (uint8_t level = 0; level < WHEEL_LEVELS; ++level) {
+        uint32_t occupied = wheel_occupied[level];
+        if (!occupied) {
+            continue;
+        }
+
+        uint8_t position = ((wheel_now >> (WHEEL_SLOT_BITS * level)) + 1) & WHEEL_SLOT_MASK;
+        while (!(occupied & (1UL << position))) {
+            position = (position + 1) & WHEEL_SLOT_MASK;
+        }
+
+        for (uint8_t idx = wheel_heads[level * WHEEL_SLOTS + position]; idx != WHEEL_NONE; idx = basic_executors[idx].next) {
+            if (!found || ((int32_t)TIMER_DIFF_32(basic_executors[idx].trigger_time, earliest)) < 0) {
+                earliest = basic_executors[idx].trigger_time;
+                found    = true;
+            }
+        }
+    }
+
+    if (found && deadline) {
+        // Anything overdue is due right now
+        uint32_t now = timer_read32();
+        *deadline    = ((int32_t)TIMER_DIFF_32(earliest, now)) < 0 ? now : earliest;
+    }
+    return found;
 }
+
 void deferred_exec_task(void) {
-    deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
+    wheel_ensure_initialized();
+
+    uint32_t now = timer_read32();
+    if (active_count == 0) {
+        // Nothing to run, so there's no need to step through every tick
+        wheel_now = now;
+        return;
+    }
+
+    // After a long stall, such as USB suspend, don't step through every millisecond that was missed
+    if (((int32_t)TIMER_DIFF_32(now, wheel_now)) > WHEEL_FAST_FORWARD_TICKS) {
+        wheel_rebase(now - 1);
+    }
+
+    while (((int32_t)TIMER_DIFF_32(now, wheel_now)) > 0) {
+        wheel_tick();
+    }
 }
@@ -60,6 +60,14 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms);
  */
 bool cancel_deferred_exec(deferred_token token);
 
+/**
+ * Retrieves the time at which the earliest pending deferred execution is due, allowing callers to sleep until then.
+ *
+ * @param deadline[out] the time the next callback is due -- equivalent time-space as timer_read32(), clamped to the current time if already overdue. May be NULL.
+ * @return true if a deferred execution is pending, otherwise false
+ */
+bool deferred_exec_next_deadline(uint32_t *deadline);
+
 /**
  * Forward declaration for the main loop in order to execute any deferred executors. Should not be invoked by keyboard/user code.
  */
@@ -119,3 +127,13 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  * @param last_execution_time[in,out] the last execution time -- this will be checked first to determine if execution is needed, and updated if execution occurred
  */
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time);
+
+/**
+ * Retrieves the time at which the earliest pending deferred execution in a custom table is due.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param deadline[out] the time the next callback is due -- equivalent time-space as timer_read32(), clamped to the current time if already overdue. May be NULL.
+ * @return true if a deferred execution is pending, otherwise false
+ */
+bool deferred_exec_advanced_next_deadline(deferred_executor_t *table, size_t table_count, uint32_t *deadline);
@@ -18,6 +18,7 @@
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "send_string.h"
 #include "keycodes.h"
 #include "nvm_dynamic_keymap.h"
@@ -32,6 +33,11 @@
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+void dynamic_keymap_init(void) {
+    nvm_dynamic_keymap_init();
+    effective_layer_cache_invalidate();
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -42,6 +48,7 @@ uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column)
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     nvm_dynamic_keymap_update_keycode(layer, row, column, keycode);
+    effective_layer_cache_invalidate_key(row, column);
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -72,6 +79,7 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+    effective_layer_cache_invalidate();
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
@@ -80,6 +88,7 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     nvm_dynamic_keymap_update_buffer(offset, size, data);
+    effective_layer_cache_invalidate();
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -167,5 +176,11 @@ void dynamic_keymap_macro_send(uint8_t id) {
     }
 
     send_string_nvm_state_t state = {.offset = offset};
+#ifdef SEND_STRING_ASYNC_ENABLE
+    // Falls back to typing the macro immediately if the queue is full
+    if (send_string_async_impl(send_string_get_next_nvm, &state, sizeof(state), DYNAMIC_KEYMAP_MACRO_DELAY, NULL, NULL)) {
+        return;
+    }
+#endif
     send_string_with_delay_impl(send_string_get_next_nvm, &state, DYNAMIC_KEYMAP_MACRO_DELAY);
 }
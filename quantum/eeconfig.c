@@ -39,6 +39,10 @@
 #    include "connection.h"
 #endif // CONNECTION_ENABLE
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_PERSIST)
+#    include "nvm_dynamic_macro.h"
+#endif // DYNAMIC_MACRO_PERSIST
+
 #ifdef VIA_ENABLE
 bool via_eeprom_is_valid(void);
 void via_eeprom_set_valid(bool valid);
@@ -76,6 +80,7 @@ void eeconfig_init_quantum(void) {
     eeconfig_update_debug(&debug_config);
 
     default_layer_state = (layer_state_t)1 << 0;
+    effective_layer_cache_invalidate();
     eeconfig_update_default_layer(default_layer_state);
 
     keymap_config_t keymap_config = {
@@ -148,6 +153,10 @@ void eeconfig_init_quantum(void) {
     eeconfig_init_user_datablock();
 #endif // (EECONFIG_USER_DATA_SIZE) > 0
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_PERSIST)
+    nvm_dynamic_macro_erase();
+#endif
+
 #if defined(VIA_ENABLE)
     // Invalidate VIA eeprom config, and then reset.
     // Just in case if power is lost mid init, this makes sure that it gets
@@ -34,6 +34,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "eeconfig.h"
 #include "action_layer.h"
 #include "suspend.h"
+#include "latency_trace.h"
+#include "scan_rate.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -106,12 +108,21 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_WRITE_BEHIND)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -121,6 +132,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef SLEEP_LED_ENABLE
 #    include "sleep_led.h"
 #endif
+#ifdef SCAN_QUEUE_ENABLE
+#    include "scan_queue.h"
+#endif
 #ifdef SPLIT_KEYBOARD
 #    include "split_util.h"
 #endif
@@ -225,6 +239,12 @@ uint32_t get_matrix_scan_rate(void) {
 }
 #else
 #    define matrix_scan_perf_task()
+
+#    ifdef SCAN_RATE_ENABLE
+uint32_t get_matrix_scan_rate(void) {
+    return scan_rate_get_stats()->scans_per_second;
+}
+#    endif
 #endif
 
 #ifdef MATRIX_HAS_GHOST
@@ -436,6 +456,14 @@ void quantum_init(void) {
         eeconfig_init();
     }
 
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
+
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_init();
+#endif
+
     /* init globals */
     eeconfig_read_debug(&debug_config);
     eeconfig_read_keymap(&keymap_config);
@@ -548,6 +576,9 @@ void keyboard_init(void) {
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
 #endif
+#ifdef SCAN_QUEUE_ENABLE
+    scan_queue_init();
+#endif
 
     keyboard_post_init_quantum(); /* Always keep this last */
 }
@@ -582,6 +613,100 @@ static inline void generate_tick_event(void) {
 
 matrix_row_t matrix_previous[MATRIX_ROWS];
 
+#ifdef SCAN_QUEUE_ENABLE
+// Matrix state as of the last queued event, which runs ahead of matrix_previous until the consumer catches up
+static matrix_row_t matrix_queued[MATRIX_ROWS];
+
+bool scan_queue_produce(void) {
+    if (!matrix_can_read()) {
+        return false;
+    }
+
+    scan_queue_lock();
+    LATENCY_TRACE_SCAN_BEGIN();
+    matrix_scan();
+
+    bool queued = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        const matrix_row_t current_row = matrix_get_row(row);
+        const matrix_row_t row_changes = current_row ^ matrix_queued[row];
+
+        if (!row_changes || has_ghost_in_row(row, current_row)) {
+            continue;
+        }
+
+        matrix_row_t col_mask = 1;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
+            if (row_changes & col_mask) {
+                // Leave the rest of the changes for the next scan once the queue is full
+                if (!scan_queue_push(MAKE_KEYEVENT(row, col, current_row & col_mask))) {
+                    scan_queue_unlock();
+                    return queued;
+                }
+                matrix_queued[row] ^= col_mask;
+                queued = true;
+            }
+        }
+    }
+
+    scan_queue_unlock();
+    return queued;
+}
+
+/**
+ * @brief Processes the key events queued by the matrix scan, with the time
+ * each key changed.
+ *
+ * @return true Matrix did change
+ * @return false Matrix didn't change
+ */
+static bool matrix_task(void) {
+#    ifndef SCAN_QUEUE_THREAD
+    scan_queue_produce();
+#    else
+    // Keyboard and keymap hooks stay on the main loop, rather than racing it from the scan thread
+    scan_queue_lock();
+    matrix_scan_kb();
+    scan_queue_unlock();
+#    endif
+
+    matrix_scan_perf_task();
+
+    keyevent_t event;
+    bool       matrix_changed   = false;
+    const bool process_keypress = should_process_keypress();
+
+    while (scan_queue_pop(&event)) {
+        const uint8_t      row      = event.key.row;
+        const uint8_t      col      = event.key.col;
+        const matrix_row_t col_mask = (matrix_row_t)1 << col;
+
+        matrix_changed = true;
+
+        LATENCY_TRACE(MATRIX_TASK);
+        if (process_keypress && !keypress_is_wakeup_key(row, col)) {
+            action_exec(event);
+        }
+
+        switch_events(row, col, event.pressed);
+
+        if (event.pressed) {
+            matrix_previous[row] |= col_mask;
+        } else {
+            matrix_previous[row] &= ~col_mask;
+        }
+    }
+
+    if (!matrix_changed) {
+        generate_tick_event();
+    } else if (debug_config.matrix) {
+        scan_queue_lock();
+        matrix_print();
+        scan_queue_unlock();
+    }
+    return matrix_changed;
+}
+#else
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
@@ -595,6 +720,7 @@ static bool matrix_task(void) {
         return false;
     }
 
+    LATENCY_TRACE_SCAN_BEGIN();
     matrix_scan();
     bool matrix_changed = false;
     for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
@@ -628,6 +754,7 @@ static bool matrix_task(void) {
             if (row_changes & col_mask) {
                 const bool key_pressed = current_row & col_mask;
 
+                LATENCY_TRACE(MATRIX_TASK);
                 if (process_keypress && !keypress_is_wakeup_key(row, col)) {
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
                 }
@@ -641,6 +768,7 @@ static bool matrix_task(void) {
 
     return matrix_changed;
 }
+#endif
 
 /** \brief Tasks previously located in matrix_scan_quantum
  *
@@ -680,6 +808,10 @@ void quantum_task(void) {
     leader_task();
 #endif
 
+#ifdef DYNAMIC_MACRO_ENABLE
+    dynamic_macro_task();
+#endif
+
 #ifdef WPM_ENABLE
     decay_wpm();
 #endif
@@ -710,31 +842,45 @@ void quantum_task(void) {
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
+    SCAN_RATE_BEGIN();
     if (matrix_task()) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
+    SCAN_RATE_MARK(MATRIX);
 
     quantum_task();
+    SCAN_RATE_MARK(QUANTUM);
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
+    // Lighting, displays and haptics may be deferred to a later iteration to keep the target scan rate
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    if (SCAN_RATE_SHOULD_RUN(RGBLIGHT)) {
+        rgblight_task();
+        SCAN_RATE_MARK(RGBLIGHT);
+    }
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    if (SCAN_RATE_SHOULD_RUN(LED_MATRIX)) {
+        led_matrix_task();
+        SCAN_RATE_MARK(LED_MATRIX);
+    }
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    if (SCAN_RATE_SHOULD_RUN(RGB_MATRIX)) {
+        rgb_matrix_task();
+        SCAN_RATE_MARK(RGB_MATRIX);
+    }
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
 #    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
     backlight_task();
+    SCAN_RATE_MARK(OTHER);
 #    endif
 #endif
 
@@ -743,6 +889,7 @@ void keyboard_task(void) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
+    SCAN_RATE_MARK(ENCODER);
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
@@ -750,10 +897,14 @@ void keyboard_task(void) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
+    SCAN_RATE_MARK(POINTING_DEVICE);
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    if (SCAN_RATE_SHOULD_RUN(OLED)) {
+        oled_task();
+        SCAN_RATE_MARK(OLED);
+    }
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -761,7 +912,10 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ST7565_ENABLE
-    st7565_task();
+    if (SCAN_RATE_SHOULD_RUN(ST7565)) {
+        st7565_task();
+        SCAN_RATE_MARK(ST7565);
+    }
 #    if ST7565_TIMEOUT > 0
     // Wake up display if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) st7565_on();
@@ -794,7 +948,10 @@ void keyboard_task(void) {
 #endif
 
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    if (SCAN_RATE_SHOULD_RUN(HAPTIC)) {
+        haptic_task();
+        SCAN_RATE_MARK(HAPTIC);
+    }
 #endif
 
     led_task();
@@ -802,4 +959,14 @@ void keyboard_task(void) {
 #ifdef OS_DETECTION_ENABLE
     os_detection_task();
 #endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_WRITE_BEHIND)
+    wear_leveling_task();
+#endif
+
+#ifdef LATENCY_TRACE_ENABLE
+    latency_trace_task();
+#endif
+
+    SCAN_RATE_END();
 }
@@ -119,6 +119,22 @@ __attribute__((weak)) combo_t* combo_get(uint16_t combo_idx) {
     return combo_get_raw(combo_idx);
 }
 
+#    if defined(COMBO_KEY_INDEX)
+// Room for three keys per combo, the longer combos sharing what the two key ones leave over
+#        ifndef COMBO_KEY_INDEX_SIZE
+#            define COMBO_KEY_INDEX_SIZE (ARRAY_SIZE(key_combos) * 3)
+#        endif
+
+STATIC_ASSERT(COMBO_KEY_INDEX_SIZE <= UINT16_MAX, "COMBO_KEY_INDEX_SIZE is too large");
+
+static combo_key_index_entry_t combo_key_index_entries[COMBO_KEY_INDEX_SIZE];
+
+combo_key_index_entry_t* combo_key_index_storage(uint16_t* size) {
+    *size = ARRAY_SIZE(combo_key_index_entries);
+    return combo_key_index_entries;
+}
+#    endif // defined(COMBO_KEY_INDEX)
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
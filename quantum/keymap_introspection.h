@@ -66,6 +66,14 @@ combo_t* combo_get_raw(uint16_t combo_idx);
 // Get the combo definition, potentially stored dynamically
 combo_t* combo_get(uint16_t combo_idx);
 
+#    if defined(COMBO_KEY_INDEX)
+struct combo_key_index_entry_t;
+typedef struct combo_key_index_entry_t combo_key_index_entry_t;
+
+// Get the storage for the combo keycode index, sized from the combos defined in the user's keymap
+combo_key_index_entry_t* combo_key_index_storage(uint16_t* size);
+#    endif // defined(COMBO_KEY_INDEX)
+
 #endif // defined(COMBO_ENABLE)
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,230 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "latency_trace.h"
+#include "timer.h"
+#include "timestamp.h"
+#include "debug.h"
+#include "print.h"
+#include "util.h"
+
+#if defined(LATENCY_TRACE_RAW_HID) && defined(RAW_ENABLE)
+#    include "raw_hid.h"
+#endif
+
+#ifndef LATENCY_TRACE_BUFFER_SIZE
+#    define LATENCY_TRACE_BUFFER_SIZE 64
+#endif
+
+#ifndef LATENCY_TRACE_REPORT_INTERVAL
+#    define LATENCY_TRACE_REPORT_INTERVAL 10000
+#endif
+
+#ifndef LATENCY_TRACE_RAW_HID_REPORT_SIZE
+#    define LATENCY_TRACE_RAW_HID_REPORT_SIZE 32
+#endif
+
+#define LATENCY_TRACE_EVENT_WIRE_SIZE 6
+#define LATENCY_TRACE_REPORT_HEADER_SIZE 2
+
+_Static_assert((LATENCY_TRACE_BUFFER_SIZE & (LATENCY_TRACE_BUFFER_SIZE - 1)) == 0, "LATENCY_TRACE_BUFFER_SIZE must be a power of two");
+_Static_assert(LATENCY_TRACE_BUFFER_SIZE <= 256, "LATENCY_TRACE_BUFFER_SIZE must be at most 256");
+
+static latency_trace_event_t trace_ring[LATENCY_TRACE_BUFFER_SIZE];
+static uint8_t               trace_head    = 0;
+static uint8_t               trace_tail    = 0;
+static uint32_t              trace_dropped = 0;
+
+// Scan currently in progress -- only committed to the ring once something gets stamped against it
+static uint32_t scan_timestamp = 0;
+static bool     scan_committed = true;
+static uint8_t  scan_sequence  = 0;
+
+// Drain-side state, used to correlate stamps with the scan that produced them
+static uint32_t drain_origin   = 0;
+static uint8_t  drain_sequence = 0;
+static bool     drain_valid    = false;
+
+static latency_trace_histogram_t histograms[LATENCY_TRACE_STAGE_COUNT];
+static bool                      report_pending = false;
+#if defined(CONSOLE_ENABLE) && LATENCY_TRACE_REPORT_INTERVAL > 0
+static uint32_t last_report_time = 0;
+#endif
+
+static inline uint8_t ring_count(void) {
+    return (uint8_t)(trace_head - trace_tail) & (LATENCY_TRACE_BUFFER_SIZE - 1);
+}
+
+// All stamps are taken from the main loop, so the ring needs no locking
+static void ring_push(uint32_t timestamp, uint8_t stage) {
+    uint8_t next = (trace_head + 1) & (LATENCY_TRACE_BUFFER_SIZE - 1);
+    if (next == trace_tail) {
+        ++trace_dropped;
+        return;
+    }
+    trace_ring[trace_head] = (latency_trace_event_t){
+        .timestamp = timestamp,
+        .sequence  = scan_sequence,
+        .stage     = stage,
+    };
+    trace_head = next;
+}
+
+static bool ring_pop(latency_trace_event_t *event) {
+    if (trace_head == trace_tail) {
+        return false;
+    }
+    *event     = trace_ring[trace_tail];
+    trace_tail = (trace_tail + 1) & (LATENCY_TRACE_BUFFER_SIZE - 1);
+    return true;
+}
+
+void latency_trace_scan_begin(void) {
+    scan_timestamp = timestamp_read();
+    scan_committed = false;
+}
+
+void latency_trace_stamp(latency_trace_stage_t stage) {
+    uint32_t now = timestamp_read();
+    if (!scan_committed) {
+        ++scan_sequence;
+        ring_push(scan_timestamp, LATENCY_TRACE_STAGE_MATRIX_SCAN);
+        scan_committed = true;
+    }
+    ring_push(now, stage);
+}
+
+static uint8_t bucket_for(uint32_t us) {
+    uint8_t bucket = 0;
+    while (us > 0 && bucket < (LATENCY_TRACE_HISTOGRAM_BUCKETS - 1)) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+static void histogram_add(latency_trace_histogram_t *hist, uint32_t us) {
+    uint16_t *bucket = &hist->buckets[bucket_for(us)];
+    if (*bucket < UINT16_MAX) {
+        ++(*bucket);
+    }
+    if (hist->count == 0 || us < hist->min_us) {
+        hist->min_us = us;
+    }
+    if (us > hist->max_us) {
+        hist->max_us = us;
+    }
+    hist->total_us += us;
+    ++hist->count;
+}
+
+static void consume_event(const latency_trace_event_t *event) {
+    if (event->stage == LATENCY_TRACE_STAGE_MATRIX_SCAN) {
+        drain_origin   = event->timestamp;
+        drain_sequence = event->sequence;
+        drain_valid    = true;
+        histogram_add(&histograms[LATENCY_TRACE_STAGE_MATRIX_SCAN], 0);
+    } else if (drain_valid && event->sequence == drain_sequence && event->stage < LATENCY_TRACE_STAGE_COUNT) {
+        histogram_add(&histograms[event->stage], timestamp_to_us(event->timestamp - drain_origin));
+    }
+    report_pending = true;
+}
+
+const latency_trace_histogram_t *latency_trace_get_histogram(latency_trace_stage_t stage) {
+    if (stage >= LATENCY_TRACE_STAGE_COUNT) {
+        return NULL;
+    }
+    return &histograms[stage];
+}
+
+uint32_t latency_trace_dropped_count(void) {
+    return trace_dropped;
+}
+
+void latency_trace_reset(void) {
+    trace_head     = 0;
+    trace_tail     = 0;
+    trace_dropped  = 0;
+    scan_committed = true;
+    drain_valid    = false;
+    report_pending = false;
+    memset(histograms, 0, sizeof(histograms));
+}
+
+uint8_t latency_trace_fill_report(uint8_t *data, uint8_t length) {
+    if (length < LATENCY_TRACE_REPORT_HEADER_SIZE) {
+        return 0;
+    }
+
+    memset(data, 0, length);
+    data[0] = LATENCY_TRACE_REPORT_MARKER;
+
+    uint8_t               count  = 0;
+    uint8_t               offset = LATENCY_TRACE_REPORT_HEADER_SIZE;
+    latency_trace_event_t event;
+    while ((offset + LATENCY_TRACE_EVENT_WIRE_SIZE) <= length && ring_pop(&event)) {
+        data[offset++] = (uint8_t)(event.timestamp);
+        data[offset++] = (uint8_t)(event.timestamp >> 8);
+        data[offset++] = (uint8_t)(event.timestamp >> 16);
+        data[offset++] = (uint8_t)(event.timestamp >> 24);
+        data[offset++] = event.sequence;
+        data[offset++] = event.stage;
+        consume_event(&event);
+        ++count;
+    }
+
+    data[1] = count;
+    return count;
+}
+
+void latency_trace_print(void) {
+#ifdef CONSOLE_ENABLE
+    static const char *const stage_names[LATENCY_TRACE_STAGE_COUNT] = {
+        [LATENCY_TRACE_STAGE_MATRIX_SCAN]    = "matrix_scan",
+        [LATENCY_TRACE_STAGE_DEBOUNCE]       = "debounce",
+        [LATENCY_TRACE_STAGE_MATRIX_TASK]    = "matrix_task",
+        [LATENCY_TRACE_STAGE_ACTION_EXEC]    = "action_exec",
+        [LATENCY_TRACE_STAGE_PROCESS_RECORD] = "process_record",
+        [LATENCY_TRACE_STAGE_HOST_SEND]      = "host_send",
+    };
+
+    dprintf("latency trace: %lu scans, %lu dropped\n", (unsigned long)histograms[LATENCY_TRACE_STAGE_MATRIX_SCAN].count, (unsigned long)trace_dropped);
+    for (uint8_t stage = LATENCY_TRACE_STAGE_DEBOUNCE; stage < LATENCY_TRACE_STAGE_COUNT; ++stage) {
+        const latency_trace_histogram_t *hist = &histograms[stage];
+        if (hist->count == 0) {
+            continue;
+        }
+        dprintf("%-15s n=%lu min=%luus avg=%luus max=%luus |", stage_names[stage], (unsigned long)hist->count, (unsigned long)hist->min_us, (unsigned long)(hist->total_us / hist->count), (unsigned long)hist->max_us);
+        for (uint8_t i = 0; i < LATENCY_TRACE_HISTOGRAM_BUCKETS; ++i) {
+            dprintf(" %u", hist->buckets[i]);
+        }
+        dprint("\n");
+    }
+#endif
+}
+
+void latency_trace_task(void) {
+#if defined(LATENCY_TRACE_RAW_HID) && defined(RAW_ENABLE)
+    // Ship raw events to the host in full batches, histograms are updated as they go
+    const uint8_t batch = (LATENCY_TRACE_RAW_HID_REPORT_SIZE - LATENCY_TRACE_REPORT_HEADER_SIZE) / LATENCY_TRACE_EVENT_WIRE_SIZE;
+    while (ring_count() >= batch) {
+        uint8_t report[LATENCY_TRACE_RAW_HID_REPORT_SIZE];
+        latency_trace_fill_report(report, sizeof(report));
+        raw_hid_send(report, sizeof(report));
+    }
+#else
+    latency_trace_event_t event;
+    while (ring_pop(&event)) {
+        consume_event(&event);
+    }
+#endif
+
+#if defined(CONSOLE_ENABLE) && LATENCY_TRACE_REPORT_INTERVAL > 0
+    if (report_pending && timer_elapsed32(last_report_time) >= LATENCY_TRACE_REPORT_INTERVAL) {
+        last_report_time = timer_read32();
+        report_pending   = false;
+        latency_trace_print();
+    }
+#endif
+}
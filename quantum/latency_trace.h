@@ -0,0 +1,124 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * \defgroup latency_trace Scan-to-USB latency tracing
+ *
+ * Records a timestamp at each stage a key event passes through on its way from the matrix to the host, and
+ * accumulates per-stage latency histograms relative to the start of the matrix scan that produced the event.
+ *
+ * Stamping is cheap (a single ring buffer write); the histograms are built and reported from
+ * `latency_trace_task()` outside of the key processing path.
+ * \{
+ */
+
+/**
+ * \brief The points in the key processing pipeline that can be stamped.
+ */
+typedef enum {
+    LATENCY_TRACE_STAGE_MATRIX_SCAN,    ///< Start of the matrix scan that observed the change
+    LATENCY_TRACE_STAGE_DEBOUNCE,       ///< Debounced matrix reported a change
+    LATENCY_TRACE_STAGE_MATRIX_TASK,    ///< matrix_task() dispatching a changed key
+    LATENCY_TRACE_STAGE_ACTION_EXEC,    ///< action_exec() received a key event
+    LATENCY_TRACE_STAGE_PROCESS_RECORD, ///< process_record() chain entered
+    LATENCY_TRACE_STAGE_HOST_SEND,      ///< Keyboard report handed to the host driver
+    LATENCY_TRACE_STAGE_COUNT,
+} latency_trace_stage_t;
+
+/**
+ * \brief A single stamp, as stored in the trace ring and exported over raw HID.
+ */
+typedef struct {
+    uint32_t timestamp; ///< Raw `timestamp_read()` ticks
+    uint8_t  sequence;  ///< Identifies the matrix scan this stamp belongs to
+    uint8_t  stage;     ///< One of `latency_trace_stage_t`
+} latency_trace_event_t;
+
+#ifndef LATENCY_TRACE_REPORT_MARKER
+#    define LATENCY_TRACE_REPORT_MARKER 0xFD
+#endif
+
+#ifndef LATENCY_TRACE_HISTOGRAM_BUCKETS
+#    define LATENCY_TRACE_HISTOGRAM_BUCKETS 16
+#endif
+
+/**
+ * \brief Latency histogram for a single stage.
+ *
+ * Bucket `n` counts events with a latency of `[2^(n-1), 2^n)` microseconds, bucket 0 counts sub-microsecond
+ * events, and the last bucket also collects everything above its lower bound.
+ */
+typedef struct {
+    uint16_t buckets[LATENCY_TRACE_HISTOGRAM_BUCKETS];
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t total_us;
+} latency_trace_histogram_t;
+
+/**
+ * \brief Marks the start of a matrix scan.
+ *
+ * Nothing is written to the trace ring until a subsequent stamp occurs, so idle scans cost a single timestamp read.
+ */
+void latency_trace_scan_begin(void);
+
+/**
+ * \brief Records the current time against the given stage of the scan in progress.
+ */
+void latency_trace_stamp(latency_trace_stage_t stage);
+
+/**
+ * \brief Drains the trace ring into the histograms, and periodically reports them. Invoked from keyboard_task().
+ */
+void latency_trace_task(void);
+
+/**
+ * \brief Retrieves the accumulated histogram for a stage.
+ */
+const latency_trace_histogram_t *latency_trace_get_histogram(latency_trace_stage_t stage);
+
+/**
+ * \brief Clears all accumulated histograms and any pending trace events.
+ */
+void latency_trace_reset(void);
+
+/**
+ * \brief Number of trace events lost because the ring was full.
+ */
+uint32_t latency_trace_dropped_count(void);
+
+/**
+ * \brief Prints all histograms over console.
+ */
+void latency_trace_print(void);
+
+/**
+ * \brief Packs a batch of raw trace events into a raw HID report.
+ *
+ * The first byte is `LATENCY_TRACE_REPORT_MARKER`, the second is the number of events in the batch, followed by the
+ * events themselves in little-endian `{timestamp:u32, sequence:u8, stage:u8}` form. Events copied into the report are
+ * still fed into the histograms.
+ *
+ * \param data The buffer to fill
+ * \param length The size of the buffer
+ * \return The number of events written
+ */
+uint8_t latency_trace_fill_report(uint8_t *data, uint8_t length);
+
+#ifdef LATENCY_TRACE_ENABLE
+#    define LATENCY_TRACE_SCAN_BEGIN() latency_trace_scan_begin()
+#    define LATENCY_TRACE(stage) latency_trace_stamp(LATENCY_TRACE_STAGE_##stage)
+#else
+#    define LATENCY_TRACE_SCAN_BEGIN()
+#    define LATENCY_TRACE(stage)
+#endif
+
+/** \} */
@@ -73,5 +73,11 @@ int main(void) {
 #endif // DEFERRED_EXEC_ENABLE
 
         housekeeping_task();
+
+#ifdef TICKLESS_IDLE_ENABLE
+        // Sleep until the next subsystem deadline or pin-change interrupt
+        void tickless_idle_task(void);
+        tickless_idle_task();
+#endif // TICKLESS_IDLE_ENABLE
     }
 }
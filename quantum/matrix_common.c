@@ -3,6 +3,11 @@
 #include "wait.h"
 #include "print.h"
 #include "debug.h"
+#include "latency_trace.h"
+
+#ifdef SCAN_QUEUE_ENABLE
+#    include "scan_queue.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -168,8 +173,14 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     changed = debounce(raw_matrix, matrix + thisHand, changed) | matrix_post_scan();
 #else
     changed = debounce(raw_matrix, matrix, changed);
+#    ifndef SCAN_QUEUE_THREAD
+    // With the scan thread, keyboard and keymap code is run from matrix_task() on the main loop instead
     matrix_scan_kb();
+#    endif
 #endif
+    if (changed) {
+        LATENCY_TRACE(DEBOUNCE);
+    }
 
     return changed;
 }
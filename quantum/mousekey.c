@@ -53,6 +53,16 @@ static int8_t  mousekey_y_inertia = 0; // ...
 static uint16_t mouse_timer = 0;
 #endif
 
+// mousekey_task() moves once strictly more than `interval` has elapsed since `last`
+static void mousekey_merge_deadline(uint32_t *deadline, bool *pending, uint16_t last, uint16_t interval) {
+    uint16_t elapsed = timer_elapsed(last);
+    uint32_t due     = timer_read32() + (elapsed > interval ? 0 : interval + 1 - elapsed);
+    if (!*pending || (int32_t)(due - *deadline) < 0) {
+        *deadline = due;
+        *pending  = true;
+    }
+}
+
 #ifndef MK_3_SPEED
 
 static uint16_t last_timer_c = 0;
@@ -384,6 +394,23 @@ void mousekey_task(void) {
     memcpy(&mouse_report, &tmpmr, sizeof(tmpmr));
 }
 
+bool mousekey_next_deadline(uint32_t *deadline) {
+    bool pending = false;
+#    ifdef MOUSEKEY_INERTIA
+    if (mousekey_frame) {
+        mousekey_merge_deadline(deadline, &pending, last_timer_c, (mousekey_frame > 1) ? mk_interval : mk_delay * 10);
+    }
+#    else
+    if (mouse_report.x || mouse_report.y) {
+        mousekey_merge_deadline(deadline, &pending, last_timer_c, mousekey_repeat ? mk_interval : mk_delay * 10);
+    }
+#    endif
+    if (mouse_report.v || mouse_report.h) {
+        mousekey_merge_deadline(deadline, &pending, last_timer_w, mousekey_wheel_repeat ? mk_wheel_interval : mk_wheel_delay * 10);
+    }
+    return pending;
+}
+
 void mousekey_on(uint8_t code) {
 #    ifdef MK_KINETIC_SPEED
     // Start kinetic timer when movement keycodes are pressed
@@ -537,6 +564,17 @@ void mousekey_task(void) {
     memcpy(&mouse_report, &tmpmr, sizeof(tmpmr));
 }
 
+bool mousekey_next_deadline(uint32_t *deadline) {
+    bool pending = false;
+    if (mouse_report.x || mouse_report.y) {
+        mousekey_merge_deadline(deadline, &pending, last_timer_c, c_intervals[mk_speed]);
+    }
+    if (mouse_report.v || mouse_report.h) {
+        mousekey_merge_deadline(deadline, &pending, last_timer_w, w_intervals[mk_speed]);
+    }
+    return pending;
+}
+
 void adjust_speed(void) {
     uint16_t const c_offset = c_offsets[mk_speed];
     uint16_t const w_offset = w_offsets[mk_speed];
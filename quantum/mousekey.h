@@ -196,6 +196,7 @@ extern uint8_t mk_wheel_max_speed;
 extern uint8_t mk_wheel_time_to_max;
 
 void           mousekey_task(void);
+bool           mousekey_next_deadline(uint32_t *deadline);
 void           mousekey_on(uint8_t code);
 void           mousekey_off(uint8_t code);
 void           mousekey_clear(void);
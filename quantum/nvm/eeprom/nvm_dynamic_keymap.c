@@ -22,6 +22,13 @@
 #    define DYNAMIC_KEYMAP_EEPROM_START (EECONFIG_SIZE)
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_PERSIST)
+#    include "nvm_eeprom_dynamic_macro_internal.h"
+#    ifndef DYNAMIC_KEYMAP_EEPROM_MAX_ADDR
+#        define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (DYNAMIC_MACRO_EEPROM_ADDR - 1)
+#    endif
+#endif
+
 #ifndef DYNAMIC_KEYMAP_EEPROM_MAX_ADDR
 #    define DYNAMIC_KEYMAP_EEPROM_MAX_ADDR (TOTAL_EEPROM_BYTE_COUNT - 1)
 #endif
@@ -68,6 +75,16 @@ STATIC_ASSERT((int64_t)(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (int64_t)(DYNAMIC_KEYM
 #    define DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE (DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + 1)
 #endif
 
+#define DYNAMIC_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Keycodes are held in native byte order, so lookups are a plain array access
+static uint16_t keymap_mirror[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+#    ifdef ENCODER_MAP_ENABLE
+static uint16_t encoder_mirror[DYNAMIC_KEYMAP_LAYER_COUNT][NUM_ENCODERS][2];
+#    endif
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void nvm_dynamic_keymap_erase(void) {
@@ -82,8 +99,7 @@ static inline void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t
     return ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
 }
 
-uint16_t nvm_dynamic_keymap_read_keycode(uint8_t layer, uint8_t row, uint8_t column) {
-    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+static uint16_t dynamic_keymap_eeprom_read_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
@@ -91,12 +107,24 @@ uint16_t nvm_dynamic_keymap_read_keycode(uint8_t layer, uint8_t row, uint8_t col
     return keycode;
 }
 
+uint16_t nvm_dynamic_keymap_read_keycode(uint8_t layer, uint8_t row, uint8_t column) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    return keymap_mirror[layer][row][column];
+#else
+    return dynamic_keymap_eeprom_read_keycode(layer, row, column);
+#endif
+}
+
 void nvm_dynamic_keymap_update_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    keymap_mirror[layer][row][column] = keycode;
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -104,8 +132,7 @@ static void *dynamic_keymap_encoder_to_eeprom_address(uint8_t layer, uint8_t enc
     return ((void *)DYNAMIC_KEYMAP_ENCODER_EEPROM_ADDR) + (layer * NUM_ENCODERS * 2 * 2) + (encoder_id * 2 * 2);
 }
 
-uint16_t nvm_dynamic_keymap_read_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
-    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+static uint16_t dynamic_keymap_eeprom_read_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = ((uint16_t)eeprom_read_byte(address + (clockwise ? 0 : 2))) << 8;
@@ -113,22 +140,63 @@ uint16_t nvm_dynamic_keymap_read_encoder(uint8_t layer, uint8_t encoder_id, bool
     return keycode;
 }
 
+uint16_t nvm_dynamic_keymap_read_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise) {
+    if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return KC_NO;
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    return encoder_mirror[layer][encoder_id][clockwise ? 0 : 1];
+#    else
+    return dynamic_keymap_eeprom_read_encoder(layer, encoder_id, clockwise);
+#    endif
+}
+
 void nvm_dynamic_keymap_update_encoder(uint8_t layer, uint8_t encoder_id, bool clockwise, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || encoder_id >= NUM_ENCODERS) return;
     void *address = dynamic_keymap_encoder_to_eeprom_address(layer, encoder_id);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address + (clockwise ? 0 : 2), (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + (clockwise ? 0 : 2) + 1, (uint8_t)(keycode & 0xFF));
+#    ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    encoder_mirror[layer][encoder_id][clockwise ? 0 : 1] = keycode;
+#    endif
 }
 #endif // ENCODER_MAP_ENABLE
 
+void nvm_dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t column = 0; column < MATRIX_COLS; column++) {
+                keymap_mirror[layer][row][column] = dynamic_keymap_eeprom_read_keycode(layer, row, column);
+            }
+        }
+#    ifdef ENCODER_MAP_ENABLE
+        for (uint8_t encoder = 0; encoder < NUM_ENCODERS; encoder++) {
+            encoder_mirror[layer][encoder][0] = dynamic_keymap_eeprom_read_encoder(layer, encoder, true);
+            encoder_mirror[layer][encoder][1] = dynamic_keymap_eeprom_read_encoder(layer, encoder, false);
+        }
+#    endif // ENCODER_MAP_ENABLE
+    }
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+}
+
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+// Byte `offset` of the big endian EEPROM layout, as held in the mirror
+static inline uint16_t *dynamic_keymap_mirror_keycode(uint32_t offset) {
+    return &((uint16_t *)keymap_mirror)[offset / 2];
+}
+#endif // DYNAMIC_KEYMAP_RAM_MIRROR
+
 void nvm_dynamic_keymap_read_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
-    uint32_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void    *source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
+    void    *source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint8_t *target = data;
     for (uint32_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
+        if (offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE) {
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+            uint16_t keycode = *dynamic_keymap_mirror_keycode(offset + i);
+            *target          = ((offset + i) & 1) ? (uint8_t)(keycode & 0xFF) : (uint8_t)(keycode >> 8);
+#else
             *target = eeprom_read_byte(source);
+#endif
         } else {
             *target = 0x00;
         }
@@ -138,12 +206,15 @@ void nvm_dynamic_keymap_read_buffer(uint32_t offset, uint32_t size, uint8_t *dat
 }
 
 void nvm_dynamic_keymap_update_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
-    uint32_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void    *target                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
+    void    *target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint8_t *source = data;
     for (uint32_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
+        if (offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE) {
             eeprom_update_byte(target, *source);
+#ifdef DYNAMIC_KEYMAP_RAM_MIRROR
+            uint16_t *keycode = dynamic_keymap_mirror_keycode(offset + i);
+            *keycode          = ((offset + i) & 1) ? ((*keycode & 0xFF00) | *source) : ((*keycode & 0x00FF) | ((uint16_t)*source << 8));
+#endif
         }
         source++;
         target++;
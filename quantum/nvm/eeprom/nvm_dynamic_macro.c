@@ -0,0 +1,89 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "compiler_support.h"
+#include "util.h"
+#include "eeprom.h"
+#include "nvm_dynamic_macro.h"
+
+#ifdef DYNAMIC_MACRO_PERSIST
+#    include "nvm_eeprom_eeconfig_internal.h"
+#    include "nvm_eeprom_dynamic_macro_internal.h"
+
+#    define DYNAMIC_MACRO_EEPROM_MAGIC_ADDR (DYNAMIC_MACRO_EEPROM_ADDR)
+#    define DYNAMIC_MACRO_EEPROM_FORMAT_ADDR (DYNAMIC_MACRO_EEPROM_ADDR + 1)
+#    define DYNAMIC_MACRO_EEPROM_LENGTH1_ADDR (DYNAMIC_MACRO_EEPROM_ADDR + 2)
+#    define DYNAMIC_MACRO_EEPROM_LENGTH2_ADDR (DYNAMIC_MACRO_EEPROM_ADDR + 4)
+#    define DYNAMIC_MACRO_EEPROM_DATA_ADDR (DYNAMIC_MACRO_EEPROM_ADDR + DYNAMIC_MACRO_EEPROM_HEADER_SIZE)
+#    define DYNAMIC_MACRO_EEPROM_DATA_SIZE (DYNAMIC_MACRO_EEPROM_SIZE - DYNAMIC_MACRO_EEPROM_HEADER_SIZE)
+
+#    define DYNAMIC_MACRO_EEPROM_MAGIC 0xD3
+
+STATIC_ASSERT((int64_t)(DYNAMIC_MACRO_EEPROM_ADDR) >= (int64_t)(EECONFIG_SIZE), "Dynamic macros are configured to use more EEPROM than is available.");
+STATIC_ASSERT(DYNAMIC_MACRO_EEPROM_ADDR + DYNAMIC_MACRO_EEPROM_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "DYNAMIC_MACRO_EEPROM_ADDR is configured to use more space than what is available for the selected EEPROM driver");
+
+void nvm_dynamic_macro_erase(void) {
+    nvm_dynamic_macro_invalidate();
+}
+
+void nvm_dynamic_macro_invalidate(void) {
+    eeprom_update_byte((uint8_t *)(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR), 0);
+}
+
+uint32_t nvm_dynamic_macro_size(void) {
+    return DYNAMIC_MACRO_EEPROM_DATA_SIZE;
+}
+
+bool nvm_dynamic_macro_read_header(uint8_t format, uint16_t *length1, uint16_t *length2) {
+    if (eeprom_read_byte((const uint8_t *)(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR)) != DYNAMIC_MACRO_EEPROM_MAGIC || eeprom_read_byte((const uint8_t *)(DYNAMIC_MACRO_EEPROM_FORMAT_ADDR)) != format) {
+        return false;
+    }
+
+    *length1 = eeprom_read_word((const uint16_t *)(DYNAMIC_MACRO_EEPROM_LENGTH1_ADDR));
+    *length2 = eeprom_read_word((const uint16_t *)(DYNAMIC_MACRO_EEPROM_LENGTH2_ADDR));
+    return (uint32_t)*length1 + *length2 <= DYNAMIC_MACRO_EEPROM_DATA_SIZE;
+}
+
+void nvm_dynamic_macro_update_header(uint8_t format, uint16_t length1, uint16_t length2) {
+    // The magic goes last, so that the header only becomes valid once it is complete
+    eeprom_update_byte((uint8_t *)(DYNAMIC_MACRO_EEPROM_FORMAT_ADDR), format);
+    eeprom_update_word((uint16_t *)(DYNAMIC_MACRO_EEPROM_LENGTH1_ADDR), length1);
+    eeprom_update_word((uint16_t *)(DYNAMIC_MACRO_EEPROM_LENGTH2_ADDR), length2);
+    eeprom_update_byte((uint8_t *)(DYNAMIC_MACRO_EEPROM_MAGIC_ADDR), DYNAMIC_MACRO_EEPROM_MAGIC);
+}
+
+void nvm_dynamic_macro_read_buffer(uint32_t offset, uint32_t size, uint8_t *data) {
+    if (offset >= DYNAMIC_MACRO_EEPROM_DATA_SIZE) {
+        return;
+    }
+    eeprom_read_block(data, (const void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_DATA_ADDR + offset), MIN(size, DYNAMIC_MACRO_EEPROM_DATA_SIZE - offset));
+}
+
+void nvm_dynamic_macro_update_buffer(uint32_t offset, uint32_t size, const uint8_t *data) {
+    if (offset >= DYNAMIC_MACRO_EEPROM_DATA_SIZE) {
+        return;
+    }
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_MACRO_EEPROM_DATA_ADDR + offset), MIN(size, DYNAMIC_MACRO_EEPROM_DATA_SIZE - offset));
+}
+
+#else // DYNAMIC_MACRO_PERSIST
+
+void nvm_dynamic_macro_erase(void) {}
+
+void nvm_dynamic_macro_invalidate(void) {}
+
+uint32_t nvm_dynamic_macro_size(void) {
+    return 0;
+}
+
+bool nvm_dynamic_macro_read_header(uint8_t format, uint16_t *length1, uint16_t *length2) {
+    return false;
+}
+
+void nvm_dynamic_macro_update_header(uint8_t format, uint16_t length1, uint16_t length2) {}
+
+void nvm_dynamic_macro_read_buffer(uint32_t offset, uint32_t size, uint8_t *data) {}
+
+void nvm_dynamic_macro_update_buffer(uint32_t offset, uint32_t size, const uint8_t *data) {}
+
+#endif // DYNAMIC_MACRO_PERSIST
@@ -0,0 +1,21 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include "eeprom.h"
+#include "util.h"
+#include "process_dynamic_macro.h"
+#include "nvm_eeprom_eeconfig_internal.h"
+
+// Persisted dynamic macros live at the end of EEPROM, dynamic keymaps end before them
+#define DYNAMIC_MACRO_EEPROM_HEADER_SIZE 6
+
+// By default take the whole buffer, but no more than half of the EEPROM left after eeconfig, so that it also fits
+// small EEPROMs and leaves room for dynamic keymaps
+#ifndef DYNAMIC_MACRO_EEPROM_SIZE
+#    define DYNAMIC_MACRO_EEPROM_SIZE MIN(DYNAMIC_MACRO_EEPROM_HEADER_SIZE + DYNAMIC_MACRO_BUFFER_SIZE, (TOTAL_EEPROM_BYTE_COUNT - EECONFIG_SIZE) / 2)
+#endif
+
+#ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#    define DYNAMIC_MACRO_EEPROM_ADDR (TOTAL_EEPROM_BYTE_COUNT - DYNAMIC_MACRO_EEPROM_SIZE)
+#endif
@@ -0,0 +1,17 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+void nvm_dynamic_macro_erase(void);
+void nvm_dynamic_macro_invalidate(void);
+
+uint32_t nvm_dynamic_macro_size(void);
+
+bool nvm_dynamic_macro_read_header(uint8_t format, uint16_t *length1, uint16_t *length2);
+void nvm_dynamic_macro_update_header(uint8_t format, uint16_t length1, uint16_t length2);
+
+void nvm_dynamic_macro_read_buffer(uint32_t offset, uint32_t size, uint8_t *data);
+void nvm_dynamic_macro_update_buffer(uint32_t offset, uint32_t size, const uint8_t *data);
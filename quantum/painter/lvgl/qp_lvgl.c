@@ -146,3 +146,10 @@ void qp_lvgl_internal_tick(void) {
     static uint32_t last_lvgl_exec = 0;
     deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration Internal: qp_lvgl_internal_next_deadline
+
+bool qp_lvgl_internal_next_deadline(uint32_t *deadline) {
+    return deferred_exec_advanced_next_deadline(lvgl_executors, 2, deadline);
+}
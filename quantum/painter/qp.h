@@ -5,6 +5,9 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#ifdef QP_STREAM_HAS_FILE_IO
+#    include <stdio.h>
+#endif // QP_STREAM_HAS_FILE_IO
 
 #include "deferred_exec.h"
 
@@ -353,6 +356,20 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
  */
 painter_image_handle_t qp_load_image_mem(const void *buffer);
 
+#ifdef QP_STREAM_HAS_FILE_IO
+/**
+ * Loads an image from an open file, for hosts with stdio support.
+ *
+ * @note Images can be unloaded by calling \ref qp_close_image, which also closes the file.
+ *
+ * @param file[in] the file containing the image data, positioned at the start of the image
+ * @return an image handle usable with \ref qp_drawimage, \ref qp_drawimage_recolor, \ref qp_animate, and
+ *         \ref qp_animate_recolor.
+ * @return NULL if loading the image failed
+ */
+painter_image_handle_t qp_load_image_file(FILE *file);
+#endif // QP_STREAM_HAS_FILE_IO
+
 /**
  * Closes an image handle when no longer in use.
  *
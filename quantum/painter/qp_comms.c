@@ -3,6 +3,31 @@
 
 #include "qp_comms.h"
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous transfers
+
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Buffer which may be sent without waiting for the transfer to complete, and the device it is being sent to, if any
+static const void      *async_buffer = NULL;
+static painter_device_t async_device = NULL;
+
+void qp_comms_set_async_buffer(const void *data) {
+    async_buffer = data;
+}
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+
+void qp_comms_wait(void) {
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    if (async_device) {
+        painter_driver_t *driver = (painter_driver_t *)async_device;
+        async_device             = NULL;
+        if (!driver->comms_vtable->comms_wait(driver)) {
+            qp_dprintf("qp_comms_wait: fail (transfer did not complete)\n");
+        }
+    }
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base comms APIs
 
@@ -13,6 +38,7 @@ bool qp_comms_init(painter_device_t device) {
         return false;
     }
 
+    qp_comms_wait();
     return driver->comms_vtable->comms_init(device);
 }
 
@@ -23,6 +49,7 @@ bool qp_comms_start(painter_device_t device) {
         return false;
     }
 
+    qp_comms_wait();
     return driver->comms_vtable->comms_start(device);
 }
 
@@ -33,6 +60,7 @@ void qp_comms_stop(painter_device_t device) {
         return;
     }
 
+    qp_comms_wait();
     driver->comms_vtable->comms_stop(device);
 }
 
@@ -43,6 +71,13 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
         return false;
     }
 
+    qp_comms_wait();
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    if (data == async_buffer && driver->comms_vtable->comms_send_async && driver->comms_vtable->comms_wait) {
+        async_device = device;
+        return driver->comms_vtable->comms_send_async(device, data, byte_count);
+    }
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
@@ -52,6 +87,7 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
 bool qp_comms_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t                    *driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    qp_comms_wait();
     return comms_vtable->send_command(device, cmd);
 }
 
@@ -68,5 +104,6 @@ uint32_t qp_comms_command_databuf(painter_device_t device, uint8_t cmd, const vo
 bool qp_comms_bulk_command_sequence(painter_device_t device, const uint8_t *sequence, size_t sequence_len) {
     painter_driver_t                    *driver       = (painter_driver_t *)device;
     painter_comms_with_command_vtable_t *comms_vtable = (painter_comms_with_command_vtable_t *)driver->comms_vtable;
+    qp_comms_wait();
     return comms_vtable->bulk_command_sequence(device, sequence, sequence_len);
 }
@@ -16,6 +16,17 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous transfers -- every comms API above waits for an in-flight transfer before touching the bus
+
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// Permits qp_comms_send() of exactly this buffer to return before the transfer has completed, NULL to disallow
+void qp_comms_set_async_buffer(const void* data);
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+
+// Blocks until any in-flight asynchronous transfer has completed
+void qp_comms_wait(void);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
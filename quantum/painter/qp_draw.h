@@ -10,7 +10,11 @@
 // Quantum Painter utility functions
 
 // Global variable used for native pixel data streaming.
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+extern uint8_t *qp_internal_global_pixdata_buffer;
+#else
 extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -18,6 +22,10 @@ bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
 // Returns the number of pixels that can fit in the pixdata buffer
 uint32_t qp_internal_num_pixels_in_buffer(painter_device_t device);
 
+// Sends the first native_pixel_count pixels of the global pixdata buffer. With double buffering, the transfer may still
+// be in progress on return, and qp_internal_global_pixdata_buffer is swapped to the other buffer.
+bool qp_internal_flush_pixdata(painter_device_t device, uint32_t native_pixel_count);
+
 // Fills the supplied buffer with equivalent native pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val);
 
@@ -21,7 +21,14 @@ STATIC_ASSERT((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIXD
 //
 
 // Buffer used for transmitting native pixel data to the downstream device.
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+// One buffer is filled while the other is being transmitted.
+__attribute__((__aligned__(4))) static uint8_t pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+static uint8_t                                 pixdata_buffer_index              = 0;
+uint8_t                                       *qp_internal_global_pixdata_buffer = pixdata_buffers[0];
+#else
 __attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -48,6 +55,24 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y)
     return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
 }
 
+// Sends the global native pixel buffer. Only used where the buffer is refilled afterwards, as a double-buffered
+// transfer may still be in flight on return.
+bool qp_internal_flush_pixdata(painter_device_t device, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    qp_comms_set_async_buffer(qp_internal_global_pixdata_buffer);
+    bool ret = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+    qp_comms_set_async_buffer(NULL);
+
+    // The comms layer waited on the other buffer's transfer before starting this one, so it's free to be refilled
+    pixdata_buffer_index ^= 1;
+    qp_internal_global_pixdata_buffer = pixdata_buffers[pixdata_buffer_index];
+    return ret;
+#else
+    return driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+}
+
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val) {
     painter_driver_t *driver            = (painter_driver_t *)device;
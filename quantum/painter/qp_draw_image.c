@@ -85,6 +85,27 @@ painter_image_handle_t qp_load_image_mem(const void *buffer) {
     return qp_load_image_internal(image_mem_stream_factory, (void *)buffer);
 }
 
+#ifdef QP_STREAM_HAS_FILE_IO
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_load_image_file
+
+static inline bool image_file_stream_factory(qgf_image_handle_t *image, void *arg) {
+    FILE *file = (FILE *)arg;
+    if (!file) {
+        return false;
+    }
+
+    image->file_stream = qp_make_file_stream(file);
+    return true;
+}
+
+painter_image_handle_t qp_load_image_file(FILE *file) {
+    return qp_load_image_internal(image_file_stream_factory, (void *)file);
+}
+
+#endif // QP_STREAM_HAS_FILE_IO
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_close_image
 
@@ -394,3 +415,10 @@ void qp_internal_animation_tick(void) {
     static uint32_t last_anim_exec = 0;
     deferred_exec_advanced_task(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, &last_anim_exec);
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: qp_internal_animation_next_deadline
+
+bool qp_internal_animation_next_deadline(uint32_t *deadline) {
+    return deferred_exec_advanced_next_deadline(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, deadline);
+}
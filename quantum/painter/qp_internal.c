@@ -25,7 +25,7 @@ enum {
                      + (LD7032_NUM_DEVICES)  // LD7032
 };
 
-static painter_device_t qp_devices[QP_NUM_DEVICES] = {NULL};
+static painter_device_t qp_devices[QP_NUM_DEVICES];
 
 bool qp_internal_register_device(painter_device_t driver) {
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
@@ -71,10 +71,11 @@ static void qp_internal_display_timeout_task(void) {
 
 STATIC_ASSERT((QUANTUM_PAINTER_TASK_THROTTLE) > 0 && (QUANTUM_PAINTER_TASK_THROTTLE) < 1000, "QUANTUM_PAINTER_TASK_THROTTLE must be between 1 and 999");
 
+static uint32_t last_tick = 0;
+
 void qp_internal_task(void) {
     // Perform throttling of the internal processing of Quantum Painter
-    static uint32_t last_tick = 0;
-    uint32_t        now       = timer_read32();
+    uint32_t now = timer_read32();
     if (TIMER_DIFF_32(now, last_tick) < (QUANTUM_PAINTER_TASK_THROTTLE)) {
         return;
     }
@@ -108,3 +109,40 @@ void qp_internal_task(void) {
     debug_enable = old_debug_state;
 #endif // defined(QUANTUM_PAINTER_DEBUG_ENABLE_FLUSH_TASK_OUTPUT)
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter Core API: qp_internal_next_deadline
+
+bool qp_internal_animation_next_deadline(uint32_t *deadline);
+#ifdef QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
+bool qp_lvgl_internal_next_deadline(uint32_t *deadline);
+#endif
+
+bool qp_internal_next_deadline(uint32_t *deadline) {
+    bool     found    = false;
+    uint32_t earliest = 0;
+    uint32_t next     = 0;
+
+    if (qp_internal_animation_next_deadline(&next)) {
+        earliest = next;
+        found    = true;
+    }
+
+#ifdef QUANTUM_PAINTER_LVGL_INTEGRATION_ENABLE
+    if (qp_lvgl_internal_next_deadline(&next) && (!found || ((int32_t)TIMER_DIFF_32(next, earliest)) < 0)) {
+        earliest = next;
+        found    = true;
+    }
+#endif
+
+    // Executors only run once the task throttle lets them
+    uint32_t throttled = last_tick + (QUANTUM_PAINTER_TASK_THROTTLE);
+    if (found && ((int32_t)TIMER_DIFF_32(earliest, throttled)) < 0) {
+        earliest = throttled;
+    }
+
+    if (found && deadline) {
+        *deadline = earliest;
+    }
+    return found;
+}
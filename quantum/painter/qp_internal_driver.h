@@ -38,12 +38,17 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef bool (*painter_driver_comms_wait_func)(painter_device_t device);
 
 typedef struct painter_comms_vtable_t {
     painter_driver_comms_init_func  comms_init;
     painter_driver_comms_start_func comms_start;
     painter_driver_comms_stop_func  comms_stop;
     painter_driver_comms_send_func  comms_send;
+#ifdef QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+    painter_driver_comms_send_func comms_send_async; // optional, may return before the data has been sent
+    painter_driver_comms_wait_func comms_wait;       // optional, blocks until a comms_send_async transfer has completed
+#endif // QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
 } painter_comms_vtable_t;
 
 typedef bool (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
@@ -88,6 +88,19 @@ static pointing_device_status_t pointing_device_status     = POINTING_DEVICE_STA
 static uint16_t hires_scroll_resolution;
 #endif
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+// Motion that hasn't been reported yet, in 1/POINTING_DEVICE_MOTION_SCALE_ONE counts
+static struct {
+    int32_t x;
+    int32_t y;
+    int32_t h;
+    int32_t v;
+} pending_motion = {};
+
+static uint16_t xy_motion_scale = POINTING_DEVICE_MOTION_SCALE_ONE;
+static uint16_t hv_motion_scale = POINTING_DEVICE_MOTION_SCALE_ONE;
+#endif
+
 #define POINTING_DEVICE_DRIVER_CONCAT(name) name##_pointing_device_driver
 #define POINTING_DEVICE_DRIVER(name) POINTING_DEVICE_DRIVER_CONCAT(name)
 
@@ -252,6 +265,95 @@ __attribute__((weak)) bool pointing_device_send(void) {
     return should_send_report || buttons;
 }
 
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+/**
+ * @brief Adds scaled motion to a pending total, saturating rather than wrapping around
+ */
+static void pointing_device_add_motion(int32_t *pending, int32_t counts, uint16_t scale) {
+    int64_t total = (int64_t)*pending + (int64_t)counts * scale;
+    *pending      = total > INT32_MAX ? INT32_MAX : (total < INT32_MIN ? INT32_MIN : total);
+}
+
+/**
+ * @brief Takes as many whole counts from the pending total as fit in a report
+ *
+ * Division truncates towards zero, so the fraction that stays behind has the same sign as the motion.
+ */
+static int32_t pointing_device_take_motion(int32_t *pending, int32_t min, int32_t max) {
+    int32_t counts = *pending / POINTING_DEVICE_MOTION_SCALE_ONE;
+    counts         = counts < min ? min : (counts > max ? max : counts);
+    *pending -= counts * POINTING_DEVICE_MOTION_SCALE_ONE;
+    return counts;
+}
+
+/**
+ * @brief Moves the motion of the current report into the pending totals, and hands back what is due
+ *
+ * Sensors are read every time pointing_device_task() runs, but motion is only reported once every
+ * POINTING_DEVICE_REPORT_INTERVAL_MS. Each report then carries as much of the pending motion as it can hold, and the
+ * rest goes into the following reports. Buttons aren't held back.
+ */
+static void pointing_device_accumulate_motion(void) {
+    static uint32_t last_report = 0;
+
+    pointing_device_add_motion(&pending_motion.x, local_mouse_report.x, xy_motion_scale);
+    pointing_device_add_motion(&pending_motion.y, local_mouse_report.y, xy_motion_scale);
+    pointing_device_add_motion(&pending_motion.h, local_mouse_report.h, hv_motion_scale);
+    pointing_device_add_motion(&pending_motion.v, local_mouse_report.v, hv_motion_scale);
+
+    if (timer_elapsed32(last_report) < POINTING_DEVICE_REPORT_INTERVAL_MS) {
+        local_mouse_report.x = 0;
+        local_mouse_report.y = 0;
+        local_mouse_report.h = 0;
+        local_mouse_report.v = 0;
+        return;
+    }
+
+    local_mouse_report.x = pointing_device_take_motion(&pending_motion.x, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    local_mouse_report.y = pointing_device_take_motion(&pending_motion.y, MOUSE_REPORT_XY_MIN, MOUSE_REPORT_XY_MAX);
+    local_mouse_report.h = pointing_device_take_motion(&pending_motion.h, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    local_mouse_report.v = pointing_device_take_motion(&pending_motion.v, MOUSE_REPORT_HV_MIN, MOUSE_REPORT_HV_MAX);
+    if (local_mouse_report.x || local_mouse_report.y || local_mouse_report.h || local_mouse_report.v) {
+        last_report = timer_read32();
+    }
+}
+
+/**
+ * @brief Sets how much each count of motion read from the sensor moves the pointer
+ *
+ * Scales are in 1/POINTING_DEVICE_MOTION_SCALE_ONE, so POINTING_DEVICE_MOTION_SCALE_ONE / 8 moves by one count for
+ * every eight read. Fractions of a count are kept until they add up, rather than dropped.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_MOTION_ACCUMULATE
+ *
+ * @param[in] xy_scale scale applied to x and y
+ * @param[in] hv_scale scale applied to h and v
+ */
+void pointing_device_set_motion_scale(uint16_t xy_scale, uint16_t hv_scale) {
+    xy_motion_scale = xy_scale;
+    hv_motion_scale = hv_scale;
+}
+
+/**
+ * @brief Discards motion the sensor driver holds back for the following reads
+ *
+ * Implemented by drivers that carry motion which doesn't fit in one report over to the next ones.
+ *
+ * NOTE : Only available when using POINTING_DEVICE_MOTION_ACCUMULATE
+ */
+__attribute__((weak)) void pointing_device_driver_clear_motion(void) {}
+
+/**
+ * @brief Discards motion that hasn't been reported yet
+ *
+ * NOTE : Only available when using POINTING_DEVICE_MOTION_ACCUMULATE
+ */
+void pointing_device_clear_motion(void) {
+    memset(&pending_motion, 0, sizeof(pending_motion));
+    pointing_device_driver_clear_motion();
+}
+#endif
+
 /**
  * @brief Adjust mouse report by any optional common pointing configuration defines
  *
@@ -371,6 +473,9 @@ __attribute__((weak)) bool pointing_device_task(void) {
     report_mouse_t mousekey_report = mousekey_get_report();
     local_mouse_report.buttons     = local_mouse_report.buttons | mousekey_report.buttons;
 #endif
+#ifdef POINTING_DEVICE_MOTION_ACCUMULATE
+    pointing_device_accumulate_motion();
+#endif
 
     const bool send_report     = pointing_device_send() || pointing_device_force_send;
     pointing_device_force_send = false;
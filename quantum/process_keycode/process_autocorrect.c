@@ -19,9 +19,60 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+// Headers generated before AUTOCORRECT_DATA_VERSION hold a reversed trie, which is searched back from the end of the
+// typo buffer on every keystroke. Regenerating them gets the incremental lookup.
+#ifndef AUTOCORRECT_DATA_VERSION
+#    define AUTOCORRECT_DATA_LEGACY
+#    ifndef AUTOCORRECT_MAX_CHANGES_LENGTH
+#        define AUTOCORRECT_MAX_CHANGES_LENGTH 10
+#    endif
+#endif
+
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+#    include "flash.h"
+#    include "util.h"
+
+#    ifndef AUTOCORRECT_FLASH_ADDRESS
+#        define AUTOCORRECT_FLASH_ADDRESS 0
+#    endif
+#    ifndef AUTOCORRECT_FLASH_CACHE_LINES
+#        define AUTOCORRECT_FLASH_CACHE_LINES 8
+#    endif
+#    ifndef AUTOCORRECT_FLASH_CACHE_LINE_SIZE
+#        define AUTOCORRECT_FLASH_CACHE_LINE_SIZE 16
+#    endif
+
+// "QAC", the format version, the dictionary size and its CRC32, ahead of the dictionary itself
+#    define AUTOCORRECT_FLASH_HEADER_SIZE 12
+#    define AUTOCORRECT_LINK_SIZE 3
+typedef uint32_t autocorrect_offset_t;
+#else
+#    define AUTOCORRECT_LINK_SIZE 2
+typedef uint16_t autocorrect_offset_t;
+#endif
+
+// The dictionary starts with a link to the first node for each of these, in this order: a-z, ' and word breaks
+#define AUTOCORRECT_ROOT_LINKS 28
+
+// Chain terminators, followed by either the chain's child or a link to it
+#define AUTOCORRECT_CHAIN_INLINE 0
+#define AUTOCORRECT_CHAIN_LINK 1
+
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
 static uint8_t typo_buffer_size                    = 1;
 
+#ifndef AUTOCORRECT_DATA_LEGACY
+// Trie positions of the typos that could still be completed by the next keystrokes, one for each keystroke they started
+// at, and the typo_buffer_size they are up to date with
+static autocorrect_offset_t cursors[AUTOCORRECT_MAX_LENGTH];
+static uint8_t              cursor_count       = 0;
+static uint8_t              cursor_buffer_size = 0;
+#endif
+
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+static void autocorrect_flash_reset(void);
+#endif
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -39,6 +90,9 @@ bool autocorrect_is_enabled(void) {
 void autocorrect_enable(void) {
     keymap_config.autocorrect_enable = true;
     eeconfig_update_keymap(&keymap_config);
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+    autocorrect_flash_reset();
+#endif
 }
 
 /**
@@ -59,6 +113,9 @@ void autocorrect_toggle(void) {
     keymap_config.autocorrect_enable = !keymap_config.autocorrect_enable;
     typo_buffer_size                 = 0;
     eeconfig_update_keymap(&keymap_config);
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+    autocorrect_flash_reset();
+#endif
 }
 
 /**
@@ -189,6 +246,228 @@ __attribute__((weak)) bool apply_autocorrect(uint8_t backspaces, const char *str
     return true;
 }
 
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+typedef struct {
+    uint32_t line; // index of the cached line, plus one so that zero is an empty line
+    uint16_t used;
+    uint8_t  data[AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+} autocorrect_cache_line_t;
+
+static autocorrect_cache_line_t cache[AUTOCORRECT_FLASH_CACHE_LINES];
+static uint16_t                 cache_clock = 0;
+static int8_t                   flash_valid = -1;
+
+// Every keystroke starts a cursor from the root links, so they're kept out of the cache
+static uint8_t root_links[AUTOCORRECT_ROOT_LINKS * AUTOCORRECT_LINK_SIZE];
+
+/**
+ * @brief forgets the cached dictionary, so that it is checked and read again from flash
+ */
+static void autocorrect_flash_reset(void) {
+    memset(cache, 0, sizeof(cache));
+    flash_valid = -1;
+}
+
+static uint32_t autocorrect_read_le32(const uint8_t *data) {
+    return data[0] | (uint32_t)data[1] << 8 | (uint32_t)data[2] << 16 | (uint32_t)data[3] << 24;
+}
+
+/**
+ * @brief checks that the dictionary in external flash is the one this firmware was built for
+ *
+ * @return true if the dictionary can be used
+ */
+static bool autocorrect_flash_valid(void) {
+    if (flash_valid < 0) {
+        uint8_t header[AUTOCORRECT_FLASH_HEADER_SIZE];
+        flash_init();
+        flash_valid = flash_read_range(AUTOCORRECT_FLASH_ADDRESS, header, sizeof(header)) == FLASH_STATUS_SUCCESS && memcmp(header, "QAC", 3) == 0 && header[3] == AUTOCORRECT_DATA_VERSION && autocorrect_read_le32(header + 4) == DICTIONARY_SIZE && autocorrect_read_le32(header + 8) == AUTOCORRECT_DATA_CRC;
+        if (flash_valid) {
+            flash_valid = flash_read_range(AUTOCORRECT_FLASH_ADDRESS + AUTOCORRECT_FLASH_HEADER_SIZE, root_links, sizeof(root_links)) == FLASH_STATUS_SUCCESS;
+        }
+    }
+    return flash_valid;
+}
+
+/**
+ * @brief reads a byte of the dictionary through a small least recently used cache of flash lines
+ */
+static uint8_t autocorrect_read_byte(autocorrect_offset_t offset) {
+    uint32_t                  line   = offset / AUTOCORRECT_FLASH_CACHE_LINE_SIZE + 1;
+    autocorrect_cache_line_t *victim = &cache[0];
+    for (uint8_t i = 0; i < AUTOCORRECT_FLASH_CACHE_LINES; ++i) {
+        if (cache[i].line == line) {
+            cache[i].used = ++cache_clock;
+            return cache[i].data[offset % AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+        }
+        if ((uint16_t)(cache_clock - cache[i].used) > (uint16_t)(cache_clock - victim->used)) {
+            victim = &cache[i];
+        }
+    }
+
+    uint32_t start = offset - offset % AUTOCORRECT_FLASH_CACHE_LINE_SIZE;
+    if (start >= DICTIONARY_SIZE) {
+        return 0;
+    }
+    if (flash_read_range(AUTOCORRECT_FLASH_ADDRESS + AUTOCORRECT_FLASH_HEADER_SIZE + start, victim->data, MIN(AUTOCORRECT_FLASH_CACHE_LINE_SIZE, DICTIONARY_SIZE - start)) != FLASH_STATUS_SUCCESS) {
+        victim->line = 0;
+        return 0;
+    }
+    victim->line = line;
+    victim->used = ++cache_clock;
+    return victim->data[offset % AUTOCORRECT_FLASH_CACHE_LINE_SIZE];
+}
+#else
+#    define autocorrect_read_byte(offset) pgm_read_byte(autocorrect_data + (offset))
+#endif
+
+#ifdef AUTOCORRECT_DATA_LEGACY
+/**
+ * @brief searches the reversed trie of a legacy dictionary for a typo ending the typo buffer
+ *
+ * @return the position of the correction, or 0 if there is none
+ */
+static autocorrect_offset_t autocorrect_find_legacy(void) {
+    if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
+        return 0;
+    }
+
+    autocorrect_offset_t state = 0;
+    uint8_t              code  = autocorrect_read_byte(state);
+    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
+        uint8_t const key_i = typo_buffer[i];
+
+        if (code & 64) { // Check for match in node with multiple children.
+            code &= 63;
+            for (; code != key_i; code = autocorrect_read_byte(state += 3)) {
+                if (!code) return 0;
+            }
+            // Follow link to child node.
+            state = autocorrect_read_byte(state + 1) | autocorrect_read_byte(state + 2) << 8;
+            // Check for match in node with single child.
+        } else if (code != key_i) {
+            return 0;
+        } else if (!(code = autocorrect_read_byte(++state))) {
+            ++state;
+        }
+
+        // Stop if `state` becomes an invalid index. This should not normally
+        // happen, it is a safeguard in case of a bug, data corruption, etc.
+        if (state >= DICTIONARY_SIZE) {
+            return 0;
+        }
+
+        code = autocorrect_read_byte(state);
+        if (code & 128) {
+            return state;
+        }
+    }
+    return 0;
+}
+
+static inline void autocorrect_reset_cursors(void) {}
+#else
+/**
+ * @brief reads a node link from the dictionary
+ */
+static autocorrect_offset_t autocorrect_read_link(autocorrect_offset_t offset) {
+    autocorrect_offset_t link = 0;
+    for (uint8_t i = 0; i < AUTOCORRECT_LINK_SIZE; ++i) {
+        link |= (autocorrect_offset_t)autocorrect_read_byte(offset + i) << (8 * i);
+    }
+    return link;
+}
+
+/**
+ * @brief reads the link to the first node of the typos starting with a keycode
+ */
+static autocorrect_offset_t autocorrect_read_root_link(uint8_t keycode) {
+    uint8_t index = keycode == KC_SPC ? 27 : keycode == KC_QUOTE ? 26 : keycode - KC_A;
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+    const uint8_t *link = root_links + index * AUTOCORRECT_LINK_SIZE;
+    return link[0] | (autocorrect_offset_t)link[1] << 8 | (autocorrect_offset_t)link[2] << 16;
+#else
+    return autocorrect_read_link(index * AUTOCORRECT_LINK_SIZE);
+#endif
+}
+
+/**
+ * @brief moves a trie cursor on by a keycode
+ *
+ * @param state the cursor's position in the dictionary
+ * @param keycode the next keycode in the typo buffer
+ * @return the new position, or 0 if no typo continues with keycode
+ */
+static autocorrect_offset_t autocorrect_advance(autocorrect_offset_t state, uint8_t keycode) {
+    uint8_t code = autocorrect_read_byte(state);
+
+    if (code & 64) { // Check for match in node with multiple children.
+        code &= 63;
+        for (; code != keycode; code = autocorrect_read_byte(state += 1 + AUTOCORRECT_LINK_SIZE)) {
+            if (!code) return 0;
+        }
+        // Follow link to child node.
+        return autocorrect_read_link(state + 1);
+    }
+
+    // Check for match in node with single child.
+    if (code != keycode) {
+        return 0;
+    }
+    code = autocorrect_read_byte(++state);
+    if (code == AUTOCORRECT_CHAIN_INLINE) {
+        return state + 1;
+    } else if (code == AUTOCORRECT_CHAIN_LINK) {
+        return autocorrect_read_link(state + 1);
+    }
+    return state;
+}
+
+/**
+ * @brief feeds a keycode to every cursor, and starts a new one from the root
+ *
+ * @param keycode the keycode appended to the typo buffer
+ * @return the position of the correction for a typo ending with keycode, or 0 if there is none
+ */
+static autocorrect_offset_t autocorrect_step(uint8_t keycode) {
+    autocorrect_offset_t found = 0;
+    uint8_t              count = 0;
+
+    for (uint8_t i = 0; i <= cursor_count; ++i) {
+        autocorrect_offset_t state;
+        if (i < cursor_count) {
+            state = autocorrect_advance(cursors[i], keycode);
+        } else {
+            state = autocorrect_read_root_link(keycode);
+        }
+
+        // Drop cursors that ran out of typos, or that have become an invalid index. That should not normally happen,
+        // it is a safeguard in case of a bug, data corruption, etc.
+        if (!state || state >= DICTIONARY_SIZE) {
+            continue;
+        }
+        if (autocorrect_read_byte(state) & 128) {
+            found = state;
+        } else if (count < AUTOCORRECT_MAX_LENGTH) {
+            cursors[count++] = state;
+        }
+    }
+    cursor_count = count;
+    return found;
+}
+
+/**
+ * @brief rebuilds the cursors from the typo buffer, after it was shortened or cleared
+ */
+static void autocorrect_reset_cursors(void) {
+    cursor_count = 0;
+    for (uint8_t i = 0; i < typo_buffer_size; ++i) {
+        autocorrect_step(typo_buffer[i]);
+    }
+    cursor_buffer_size = typo_buffer_size;
+}
+#endif
+
 /**
  * @brief Process handler for autocorrect feature
  *
@@ -266,110 +545,115 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
     }
 
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+    if (!autocorrect_flash_valid()) {
+        return true;
+    }
+#endif
+
+#ifndef AUTOCORRECT_DATA_LEGACY
+    // Catch up with changes to the buffer made by backspace or the user callback.
+    if (cursor_buffer_size != typo_buffer_size) {
+        autocorrect_reset_cursors();
+    }
+#endif
+
     // Rotate oldest character if buffer is full.
     if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
         memmove(typo_buffer, typo_buffer + 1, AUTOCORRECT_MAX_LENGTH - 1);
         typo_buffer_size = AUTOCORRECT_MAX_LENGTH - 1;
     }
 
-    // Append `keycode` to buffer.
+    // Append `keycode` to buffer, and check whether it completes a typo.
     typo_buffer[typo_buffer_size++] = keycode;
-    // Return if buffer is smaller than the shortest word.
-    if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
-        return true;
-    }
+#ifdef AUTOCORRECT_DATA_LEGACY
+    autocorrect_offset_t state = autocorrect_find_legacy();
+#else
+    cursor_buffer_size         = typo_buffer_size;
+    autocorrect_offset_t state = autocorrect_step(keycode);
+#endif
 
-    // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
+    if (state) { // A typo was found! Apply autocorrect.
+        const uint8_t backspaces = (autocorrect_read_byte(state) & 63) + !record->event.pressed;
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+        char    changes[AUTOCORRECT_MAX_CHANGES_LENGTH + 1];
+        uint8_t changes_len = 0;
+        while (changes_len < AUTOCORRECT_MAX_CHANGES_LENGTH && (changes[changes_len] = autocorrect_read_byte(state + 1 + changes_len))) {
+            ++changes_len;
+        }
+        changes[changes_len] = 0;
+#else
+        const char *changes = (const char *)(autocorrect_data + state + 1);
+#endif
 
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
+        /* Gather info about the typo'd word
+         *
+         * Since buffer may contain several words, delimited by spaces, we
+         * iterate from the end to find the start and length of the typo
+         */
+        char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
+
+        uint8_t typo_len   = 0;
+        uint8_t typo_start = 0;
+        bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+        for (uint8_t i = typo_buffer_size; i > 0; --i) {
+            // stop counting after finding space (unless it is the last thing)
+            if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+                typo_start = i;
+                break;
             }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
 
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
-            return true;
+            ++typo_len;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
-
-        if (code & 128) { // A typo was found! Apply autocorrect.
-            const uint8_t backspaces = (code & 63) + !record->event.pressed;
-            const char   *changes    = (const char *)(autocorrect_data + state + 1);
-
-            /* Gather info about the typo'd word
-             *
-             * Since buffer may contain several words, delimited by spaces, we
-             * iterate from the end to find the start and length of the typo
-             */
-            char typo[AUTOCORRECT_MAX_LENGTH + 1] = {0}; // extra char for null terminator
-
-            uint8_t typo_len   = 0;
-            uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
-            for (uint8_t i = typo_buffer_size; i > 0; --i) {
-                // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
-                    typo_start = i;
-                    break;
-                }
-
-                ++typo_len;
-            }
+        // when detecting 'typo:', reduce the length of the string by one
+        if (space_last) {
+            --typo_len;
+        }
 
-            // when detecting 'typo:', reduce the length of the string by one
-            if (space_last) {
-                --typo_len;
-            }
+        // convert buffer of keycodes into a string
+        for (uint8_t i = 0; i < typo_len; ++i) {
+            typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+        }
 
-            // convert buffer of keycodes into a string
-            for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
-            }
+        /* Gather the corrected word
+         *
+         * A) Correction of 'typo:' -- Code takes into account
+         * an extra backspace to delete the space (which we dont copy)
+         * for this reason the offset is correct to "skip" the null terminator
+         *
+         * B) When correcting 'typo' -- Need extra offset for terminator
+         */
+        char correct[AUTOCORRECT_MAX_LENGTH + AUTOCORRECT_MAX_CHANGES_LENGTH + 1] = {0};
+
+        uint8_t offset = space_last ? backspaces : backspaces + 1;
+        strcpy(correct, typo);
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+        strcpy(correct + typo_len - offset, changes);
+#else
+        strcpy_P(correct + typo_len - offset, changes);
+#endif
 
-            /* Gather the corrected word
-             *
-             * A) Correction of 'typo:' -- Code takes into account
-             * an extra backspace to delete the space (which we dont copy)
-             * for this reason the offset is correct to "skip" the null terminator
-             *
-             * B) When correcting 'typo' -- Need extra offset for terminator
-             */
-            char correct[AUTOCORRECT_MAX_LENGTH + 10] = {0}; // let's hope this is big enough
-
-            uint8_t offset = space_last ? backspaces : backspaces + 1;
-            strcpy(correct, typo);
-            strcpy_P(correct + typo_len - offset, changes);
-
-            if (apply_autocorrect(backspaces, changes, typo, correct)) {
-                for (uint8_t i = 0; i < backspaces; ++i) {
-                    tap_code(KC_BSPC);
-                }
-                send_string_P(changes);
+        if (apply_autocorrect(backspaces, changes, typo, correct)) {
+            for (uint8_t i = 0; i < backspaces; ++i) {
+                tap_code(KC_BSPC);
             }
+#ifdef AUTOCORRECT_DATA_EXTERNAL
+            send_string(changes);
+#else
+            send_string_P(changes);
+#endif
+        }
 
-            if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
-                typo_buffer_size = 1;
-                return true;
-            } else {
-                typo_buffer_size = 0;
-                return false;
-            }
+        if (keycode == KC_SPC) {
+            typo_buffer[0]   = KC_SPC;
+            typo_buffer_size = 1;
+            autocorrect_reset_cursors();
+            return true;
+        } else {
+            typo_buffer_size = 0;
+            autocorrect_reset_cursors();
+            return false;
         }
     }
     return true;
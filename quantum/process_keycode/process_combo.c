@@ -24,8 +24,10 @@
 #include "keymap_common.h"
 #include "action_layer.h"
 #include "action_tapping.h"
+#include "print.h"
 #include "action_util.h"
 #include "keymap_introspection.h"
+#include "debug.h"
 
 __attribute__((weak)) void process_combo_event(uint16_t combo_index, bool pressed) {}
 
@@ -82,8 +84,9 @@ typedef enum { COMBO_KEY_NOT_PRESSED, COMBO_KEY_PRESSED, COMBO_KEY_REPRESSED } c
 #ifndef COMBO_NO_TIMER
 static uint16_t timer = 0;
 #endif
-static bool     b_combo_enable = true; // defaults to enabled
-static uint16_t longest_term   = 0;
+static bool     b_combo_enable    = true; // defaults to enabled
+static uint16_t longest_term      = 0;
+static bool     combo_state_dirty = false; // set once any combo may hold state that clear_combos() has to reset
 
 typedef struct {
     keyrecord_t record;
@@ -202,12 +205,20 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+    if (!combo_state_dirty) {
+        return;
+    }
+
+    bool still_dirty = false;
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
             RESET_COMBO_STATE(combo);
+        } else {
+            still_dirty = true;
         }
     }
+    combo_state_dirty = still_dirty;
 }
 
 static inline void dump_key_buffer(void) {
@@ -426,15 +437,8 @@ static bool keys_pressed_in_order(uint16_t combo_index, combo_t *combo, uint16_t
 }
 #endif
 
-static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
-    uint8_t  key_count = 0;
-    uint16_t key_index = -1;
-    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
-
-    /* Continue processing if key isn't part of current combo. */
-    if (-1 == (int16_t)key_index) {
-        return COMBO_KEY_NOT_PRESSED;
-    }
+static combo_key_action_t process_combo_key(combo_t *combo, uint16_t key_index, uint8_t key_count, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    combo_state_dirty = true;
 
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
@@ -555,6 +559,112 @@ static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode,
     return key_is_part_of_combo ? COMBO_KEY_PRESSED : COMBO_KEY_NOT_PRESSED;
 }
 
+static combo_key_action_t process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *record, uint16_t combo_index) {
+    uint8_t  key_count = 0;
+    uint16_t key_index = -1;
+    _find_key_index_and_count(combo->keys, keycode, &key_index, &key_count);
+
+    /* Continue processing if key isn't part of current combo. */
+    if (-1 == (int16_t)key_index) {
+        return COMBO_KEY_NOT_PRESSED;
+    }
+
+    return process_combo_key(combo, key_index, key_count, keycode, record, combo_index);
+}
+
+#ifdef COMBO_KEY_INDEX
+/* Reverse index from keycode to the combos containing it, sorted by keycode and then combo index so that combos are
+ * still visited in the same order as the linear scan. The storage is sized by keymap introspection. */
+static combo_key_index_entry_t *combo_key_index         = NULL;
+static uint16_t                 combo_key_index_size    = 0;
+static uint16_t                 combo_key_index_count   = 0;
+static bool                     combo_key_index_valid   = false;
+static bool                     combo_key_index_fits    = false;
+static bool                     combo_key_index_enabled = true;
+
+static void combo_key_index_build(void) {
+    combo_key_index       = combo_key_index_storage(&combo_key_index_size);
+    combo_key_index_count = 0;
+    combo_key_index_fits  = true;
+    combo_key_index_valid = true;
+
+    for (uint16_t combo_index = 0; combo_index < combo_count(); ++combo_index) {
+        const uint16_t *keys      = combo_get(combo_index)->keys;
+        uint16_t        first     = combo_key_index_count;
+        uint8_t         key_count = 0;
+        uint16_t        key;
+
+        while ((key = pgm_read_word(&keys[key_count])) != COMBO_END) {
+            // Repeated keys resolve to their last position, same as _find_key_index_and_count()
+            uint16_t entry = first;
+            while (entry < combo_key_index_count && combo_key_index[entry].keycode != key) {
+                ++entry;
+            }
+            if (entry == combo_key_index_count) {
+                if (combo_key_index_count == combo_key_index_size) {
+                    uprintf("combo: %u combos don't fit in COMBO_KEY_INDEX_SIZE (%u), falling back to a linear scan\n", combo_count(), combo_key_index_size);
+                    combo_key_index_fits = false;
+                    return;
+                }
+                ++combo_key_index_count;
+            }
+            combo_key_index[entry] = (combo_key_index_entry_t){
+                .keycode     = key,
+                .combo_index = combo_index,
+                .key_index   = key_count,
+            };
+            ++key_count;
+        }
+
+        for (uint16_t entry = first; entry < combo_key_index_count; ++entry) {
+            combo_key_index[entry].key_count = key_count;
+        }
+    }
+
+    // Stable insertion sort by keycode -- entries are already in combo order, and this only runs once
+    for (uint16_t i = 1; i < combo_key_index_count; ++i) {
+        combo_key_index_entry_t entry = combo_key_index[i];
+        uint16_t                j     = i;
+        while (j > 0 && combo_key_index[j - 1].keycode > entry.keycode) {
+            combo_key_index[j] = combo_key_index[j - 1];
+            --j;
+        }
+        combo_key_index[j] = entry;
+    }
+}
+
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t lo = 0, hi = combo_key_index_count;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_key_index[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static bool combo_key_index_ready(void) {
+    if (!combo_key_index_enabled) {
+        return false;
+    }
+    if (!combo_key_index_valid) {
+        combo_key_index_build();
+    }
+    return combo_key_index_fits;
+}
+
+void combo_key_index_invalidate(void) {
+    combo_key_index_valid = false;
+}
+
+void combo_key_index_set_enabled(bool enabled) {
+    combo_key_index_enabled = enabled;
+}
+#endif
+
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
     uint8_t is_combo_key          = COMBO_KEY_NOT_PRESSED;
     bool    no_combo_keys_pressed = true;
@@ -585,10 +695,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX
+    if (combo_key_index_ready()) {
+        // Only visit the combos that actually contain this keycode
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_count && combo_key_index[i].keycode == keycode; ++i) {
+            const combo_key_index_entry_t *entry = &combo_key_index[i];
+            is_combo_key |= process_combo_key(combo_get(entry->combo_index), entry->key_index, entry->key_count, keycode, record, entry->combo_index);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+            no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -651,6 +772,17 @@ void combo_task(void) {
 #endif
 }
 
+bool combo_next_deadline(uint32_t *deadline) {
+#ifndef COMBO_NO_TIMER
+    if (b_combo_enable && timer) {
+        uint16_t elapsed = timer_elapsed(timer);
+        *deadline        = timer_read32() + (elapsed > longest_term ? 0 : longest_term + 1 - elapsed);
+        return true;
+    }
+#endif
+    return false;
+}
+
 void combo_enable(void) {
     b_combo_enable = true;
 }
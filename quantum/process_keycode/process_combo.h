@@ -73,9 +73,25 @@ typedef struct combo_t {
 
 bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
+bool combo_next_deadline(uint32_t *deadline);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
+
+#ifdef COMBO_KEY_INDEX
+/* Entry of the reverse index from keycode to the combos containing it. */
+typedef struct combo_key_index_entry_t {
+    uint16_t keycode;
+    uint16_t combo_index;
+    uint8_t  key_index;
+    uint8_t  key_count;
+} combo_key_index_entry_t;
+
+/* Rebuilds the keycode index on the next key event, needed if combo_get() starts returning different combos. */
+void combo_key_index_invalidate(void);
+/* Switches between the keycode index and the linear scan of all combos, mainly useful for benchmarking. */
+void combo_key_index_set_enabled(bool enabled);
+#endif
 bool is_combo_enabled(void);
@@ -18,11 +18,19 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
+#include "compiler_support.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
+#include "util.h"
 #include "wait.h"
 
+#ifdef DYNAMIC_MACRO_PERSIST
+#    include "nvm_dynamic_macro.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -82,12 +90,305 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+/* Convenience macro used for retrieving the debug info. It needs a
+ * `direction` variable accessible at the call site.
  */
 #define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+
+/* Both macros share a byte buffer but read/write on different ends
+ * of it.
+ *
+ * Macro1 is written left-to-right starting from the beginning of
+ * the buffer.
+ *
+ * Macro2 is written right-to-left starting from the end of the
+ * buffer.
+ *
+ *  macro_buffer    macro_length[0]
+ *  v                   v
+ * +------------------------------------------------------------+
+ * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
+ * +------------------------------------------------------------+
+ *                           ^                                 ^
+ *                    macro_length[1]       macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - 1
+ *
+ * During the recording when one macro encounters the end of the
+ * other macro, the recording is stopped. Apart from this, there
+ * are no arbitrary limits for the macros' length in relation to
+ * each other: for example one can either have two medium sized
+ * macros or one long macro and one short macro. Or even one empty
+ * and one using the whole buffer.
+ *
+ * Events are stored as a variable number of bytes, read in the
+ * direction of the macro they belong to:
+ *
+ *   flags    [pressed:1][tap:1][keycode:1][delta bytes:2][event type:3]
+ *   delta    0-2 bytes, milliseconds since the previous event, only
+ *            recorded with DYNAMIC_MACRO_PRESERVE_TIMING
+ *   key      key events use the key index row * MATRIX_COLS + col
+ *            when it fits in one byte, everything else row and column
+ *   tap      the tap_t state, when not zero
+ *   keycode  the record keycode, when set (combos, repeat key)
+ *
+ * All multi-byte fields are little endian.
+ */
+STATIC_ASSERT(DYNAMIC_MACRO_BUFFER_SIZE <= UINT16_MAX, "DYNAMIC_MACRO_BUFFER_SIZE must be less than 65536");
+
+#define DYNAMIC_MACRO_FLAG_PRESSED 0x80
+#define DYNAMIC_MACRO_FLAG_TAP 0x40
+#define DYNAMIC_MACRO_FLAG_KEYCODE 0x20
+#define DYNAMIC_MACRO_DELTA_SHIFT 3
+#define DYNAMIC_MACRO_DELTA_MASK 0x18
+#define DYNAMIC_MACRO_TYPE_MASK 0x07
+#define DYNAMIC_MACRO_MAX_EVENT_SIZE 8
+
+#if MATRIX_ROWS * MATRIX_COLS <= 256
+#    define DYNAMIC_MACRO_KEY_INDEX
+#endif
+
+// Identifies the encoding in persisted macros, so a firmware with a different encoding discards them
+#define DYNAMIC_MACRO_FORMAT (0x10 | DYNAMIC_MACRO_FORMAT_TIMING | DYNAMIC_MACRO_FORMAT_KEY_INDEX)
+#ifdef DYNAMIC_MACRO_PRESERVE_TIMING
+#    define DYNAMIC_MACRO_FORMAT_TIMING 0x01
+#else
+#    define DYNAMIC_MACRO_FORMAT_TIMING 0x00
+#endif
+#ifdef DYNAMIC_MACRO_KEY_INDEX
+#    define DYNAMIC_MACRO_FORMAT_KEY_INDEX 0x02
+#else
+#    define DYNAMIC_MACRO_FORMAT_KEY_INDEX 0x00
+#endif
+
+static uint8_t macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+
+/* Length in bytes of each macro. */
+static uint16_t macro_length[2] = {0, 0};
+
+/* 0   - no macro is being recorded right now
+ * 1,2 - either macro 1 or 2 is being recorded */
+static uint8_t macro_id = 0;
+
+/* Recording state: the number of bytes written so far, the length
+ * up to and including the last key-up event, the time of the
+ * previous event, and whether an event has already been dropped
+ * for lack of space. */
+static uint16_t record_length;
+static uint16_t record_trim_length;
+static uint16_t record_last_time;
+static bool     record_full;
+
+/* A playback in progress. A macro played from another macro is
+ * stacked on top of it, deeper nesting is ignored. */
+typedef struct {
+    layer_state_t saved_layer_state;
+    uint16_t      position;
+    uint16_t      length;
+    uint16_t      last_time;
+    int8_t        direction;
+} dynamic_macro_playback_t;
+
+#define DYNAMIC_MACRO_MAX_NESTING 2
+
+static dynamic_macro_playback_t playback[DYNAMIC_MACRO_MAX_NESTING];
+static uint8_t                  playback_depth = 0;
+
+#ifdef DYNAMIC_MACRO_PERSIST
+static bool     save_pending = false;
+static uint16_t save_offset;
+#endif
+
+/* Buffer index of a byte of a macro, counting from its beginning. */
+static inline uint16_t macro_index(int8_t direction, uint16_t offset) {
+    return direction > 0 ? offset : DYNAMIC_MACRO_BUFFER_SIZE - 1 - offset;
+}
+
+static inline int8_t macro_direction(uint8_t id) {
+    return id == 1 ? +1 : -1;
+}
+
+/**
+ * Encode a key event.
+ *
+ * @param[out] data   Buffer of at least DYNAMIC_MACRO_MAX_EVENT_SIZE bytes.
+ * @param[in]  record The key event.
+ * @param[in]  delta  Milliseconds since the previous event.
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *data, const keyrecord_t *record, uint16_t delta) {
+    uint8_t flags = record->event.type & DYNAMIC_MACRO_TYPE_MASK;
+    uint8_t size  = 1;
+
+    if (record->event.pressed) {
+        flags |= DYNAMIC_MACRO_FLAG_PRESSED;
+    }
+
+    if (delta > 0) {
+        data[size++] = delta & 0xFF;
+        if (delta > 0xFF) {
+            data[size++] = delta >> 8;
+        }
+        flags |= (size - 1) << DYNAMIC_MACRO_DELTA_SHIFT;
+    }
+
+#ifdef DYNAMIC_MACRO_KEY_INDEX
+    if (record->event.type == KEY_EVENT) {
+        data[size++] = record->event.key.row * MATRIX_COLS + record->event.key.col;
+    } else
+#endif
+    {
+        data[size++] = record->event.key.row;
+        data[size++] = record->event.key.col;
+    }
+
+#ifndef NO_ACTION_TAPPING
+    uint8_t tap;
+    memcpy(&tap, &record->tap, sizeof(tap));
+    if (tap) {
+        flags |= DYNAMIC_MACRO_FLAG_TAP;
+        data[size++] = tap;
+    }
+#endif
+
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    if (record->keycode) {
+        flags |= DYNAMIC_MACRO_FLAG_KEYCODE;
+        data[size++] = record->keycode & 0xFF;
+        data[size++] = record->keycode >> 8;
+    }
+#endif
+
+    data[0] = flags;
+    return size;
+}
+
+/**
+ * Decode the key event at the given position of a macro.
+ *
+ * @param[in]     direction Either +1 or -1, which macro to read.
+ * @param[in,out] position  Offset of the event, advanced past it.
+ * @param[out]    record    The key event, with the current time.
+ * @param[out]    delta     Milliseconds since the previous event.
+ */
+static void dynamic_macro_decode(int8_t direction, uint16_t *position, keyrecord_t *record, uint16_t *delta) {
+#define NEXT_BYTE() macro_buffer[macro_index(direction, (*position)++)]
+    uint8_t flags = NEXT_BYTE();
+
+    memset(record, 0, sizeof(*record));
+    record->event.type    = flags & DYNAMIC_MACRO_TYPE_MASK;
+    record->event.pressed = flags & DYNAMIC_MACRO_FLAG_PRESSED;
+    record->event.time    = timer_read();
+
+    *delta = 0;
+    for (uint8_t i = 0; i < ((flags & DYNAMIC_MACRO_DELTA_MASK) >> DYNAMIC_MACRO_DELTA_SHIFT); i++) {
+        *delta |= NEXT_BYTE() << (8 * i);
+    }
+
+#ifdef DYNAMIC_MACRO_KEY_INDEX
+    if (record->event.type == KEY_EVENT) {
+        uint8_t index        = NEXT_BYTE();
+        record->event.key.row = index / MATRIX_COLS;
+        record->event.key.col = index % MATRIX_COLS;
+    } else
+#endif
+    {
+        record->event.key.row = NEXT_BYTE();
+        record->event.key.col = NEXT_BYTE();
+    }
+
+    if (flags & DYNAMIC_MACRO_FLAG_TAP) {
+        uint8_t tap = NEXT_BYTE();
+#ifndef NO_ACTION_TAPPING
+        memcpy(&record->tap, &tap, sizeof(tap));
+#else
+        (void)tap;
+#endif
+    }
+
+    if (flags & DYNAMIC_MACRO_FLAG_KEYCODE) {
+        uint16_t keycode = NEXT_BYTE();
+        keycode |= NEXT_BYTE() << 8;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+        record->keycode = keycode;
+#else
+        (void)keycode;
+#endif
+    }
+#undef NEXT_BYTE
+}
+
+#ifdef DYNAMIC_MACRO_PERSIST
+/**
+ * Schedule writing both macros to non-volatile memory. The stored
+ * macros are invalidated until the write completes.
+ */
+static void dynamic_macro_save(void) {
+    nvm_dynamic_macro_invalidate();
+    save_pending = false;
+
+    if ((uint32_t)macro_length[0] + macro_length[1] > nvm_dynamic_macro_size()) {
+        dprintf("dynamic macro: %u bytes don't fit the %lu bytes of EEPROM, not saved\n", macro_length[0] + macro_length[1], (unsigned long)nvm_dynamic_macro_size());
+        return;
+    }
+
+    save_offset  = 0;
+    save_pending = true;
+}
+
+/**
+ * Write the next chunk of a scheduled save. Macro1 is stored first,
+ * followed by the bytes of macro2 in buffer order.
+ */
+static void dynamic_macro_save_task(void) {
+    if (!save_pending || macro_id != 0) {
+        return;
+    }
+
+    uint16_t total = macro_length[0] + macro_length[1];
+    if (save_offset >= total) {
+        nvm_dynamic_macro_update_header(DYNAMIC_MACRO_FORMAT, macro_length[0], macro_length[1]);
+        save_pending = false;
+        dprintln("dynamic macro: saved");
+        return;
+    }
+
+    const uint8_t *source;
+    uint16_t       remaining;
+    if (save_offset < macro_length[0]) {
+        source    = macro_buffer + save_offset;
+        remaining = macro_length[0] - save_offset;
+    } else {
+        source    = macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - total + save_offset;
+        remaining = total - save_offset;
+    }
+    uint16_t chunk = MIN(remaining, DYNAMIC_MACRO_SAVE_CHUNK_SIZE);
+    nvm_dynamic_macro_update_buffer(save_offset, chunk, source);
+    save_offset += chunk;
+}
+#endif
+
+/**
+ * Reset both macros, and load them from non-volatile memory with
+ * DYNAMIC_MACRO_PERSIST.
+ */
+void dynamic_macro_init(void) {
+    macro_id        = 0;
+    playback_depth  = 0;
+    macro_length[0] = 0;
+    macro_length[1] = 0;
+
+#ifdef DYNAMIC_MACRO_PERSIST
+    save_pending = false;
+
+    uint16_t length1, length2;
+    if (nvm_dynamic_macro_read_header(DYNAMIC_MACRO_FORMAT, &length1, &length2) && (uint32_t)length1 + length2 <= DYNAMIC_MACRO_BUFFER_SIZE) {
+        nvm_dynamic_macro_read_buffer(0, length1, macro_buffer);
+        nvm_dynamic_macro_read_buffer(length1, length2, macro_buffer + DYNAMIC_MACRO_BUFFER_SIZE - length2);
+        macro_length[0] = length1;
+        macro_length[1] = length2;
+        dprintf("dynamic macro: loaded, lengths: %u, %u\n", length1, length2);
+    }
+#endif
+}
 
 #ifdef DYNAMIC_MACRO_KEEP_ORIGINAL_LAYER_STATE
 static layer_state_t dm1_layer_state;
@@ -97,10 +398,9 @@ static layer_state_t dm2_layer_state;
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[in] direction Either +1 or -1, which macro to record.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(int8_t direction) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_kb(direction);
@@ -115,20 +415,32 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     layer_clear();
 #endif
     clear_keyboard();
-    *macro_pointer = macro_buffer;
+    macro_length[direction > 0 ? 0 : 1] = 0;
+    record_length                       = 0;
+    record_trim_length                  = 0;
+    record_full                         = false;
 }
 
 /**
- * Play the dynamic macro.
+ * Start playing the dynamic macro. Its events are sent from
+ * dynamic_macro_task(), so that the rest of the keyboard keeps running.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param[in] direction Either +1 or -1, which macro to play.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(int8_t direction) {
+    if (playback_depth >= DYNAMIC_MACRO_MAX_NESTING) {
+        dprintln("dynamic macro: ignoring nested playback");
+        return;
+    }
+
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
-    layer_state_t saved_layer_state = layer_state;
+    dynamic_macro_playback_t *macro = &playback[playback_depth++];
+    macro->saved_layer_state        = layer_state;
+    macro->position                 = 0;
+    macro->length                   = macro_length[direction > 0 ? 0 : 1];
+    macro->last_time                = timer_read();
+    macro->direction                = direction;
 
     clear_keyboard();
 #ifdef DYNAMIC_MACRO_KEEP_ORIGINAL_LAYER_STATE
@@ -140,129 +452,211 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
 #else
     layer_clear();
 #endif
+}
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
+/**
+ * Finish playing the innermost dynamic macro.
+ */
+static void dynamic_macro_play_end(void) {
+    dynamic_macro_playback_t *macro = &playback[--playback_depth];
+
+    clear_keyboard();
+
+    layer_state_set(macro->saved_layer_state);
+
+    dynamic_macro_play_kb(macro->direction);
+}
+
+/**
+ * Decode the next event of a macro being played.
+ *
+ * @param[in]  macro    The macro being played.
+ * @param[out] position Buffer offset of the event after it.
+ * @param[out] record   The event.
+ * @return How long after the previous event it is due, in milliseconds.
+ */
+static uint16_t dynamic_macro_play_decode(const dynamic_macro_playback_t *macro, uint16_t *position, keyrecord_t *record) {
+    uint16_t delay;
+    *position = macro->position;
+    dynamic_macro_decode(macro->direction, position, record, &delay);
 #ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
+    delay = MAX(delay, DYNAMIC_MACRO_DELAY);
 #endif
+    return delay;
+}
+
+/**
+ * Send the next event of the innermost dynamic macro being played,
+ * once it is due.
+ */
+static void dynamic_macro_play_task(void) {
+    dynamic_macro_playback_t *macro = &playback[playback_depth - 1];
+
+    if (macro->position >= macro->length) {
+        dynamic_macro_play_end();
+        return;
     }
 
-    clear_keyboard();
+    keyrecord_t record;
+    uint16_t    position;
+    uint16_t    delay = dynamic_macro_play_decode(macro, &position, &record);
 
-    layer_state_set(saved_layer_state);
+    if (timer_elapsed(macro->last_time) < delay) {
+        return;
+    }
 
-    dynamic_macro_play_kb(direction);
+    // Schedule from when the event was due rather than when it was sent, so that delays don't add up
+    macro->last_time += delay;
+    macro->position = position;
+    process_record(&record);
+}
+
+bool dynamic_macro_is_playing(void) {
+    return playback_depth > 0;
 }
 
 /**
- * Record a single key in a dynamic macro.
+ * Stop all macros being played, releasing any keys they hold.
+ */
+void dynamic_macro_stop_playing(void) {
+    while (playback_depth > 0) {
+        dynamic_macro_play_end();
+    }
+}
+
+/**
+ * Record a single key in the dynamic macro being recorded.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param[in] direction Either +1 or -1, which macro to record.
+ * @param[in] record    The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && record_length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
-     */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    /* Once an event has been dropped, record nothing more: a smaller
+     * event that still fits could be the release of a dropped press. */
+    if (record_full) {
+        dynamic_macro_record_key_kb(direction, record);
+        return;
+    }
+
+    uint16_t delta = 0;
+#ifdef DYNAMIC_MACRO_PRESERVE_TIMING
+    if (record_length > 0) {
+        delta = TIMER_DIFF_16(record->event.time, record_last_time);
+    }
+#endif
+    record_last_time = record->event.time;
+
+    uint8_t  data[DYNAMIC_MACRO_MAX_EVENT_SIZE];
+    uint8_t  size      = dynamic_macro_encode(data, record, delta);
+    uint16_t available = DYNAMIC_MACRO_BUFFER_SIZE - macro_length[direction > 0 ? 1 : 0] - record_length;
+
+    /* Stop growing the macro once it would run into the other one,
+     * it is trimmed back to the last key-up event when the recording
+     * ends. */
+    if (size > available) {
+        dprintln("dynamic macro: buffer full");
+        record_full = true;
+        dynamic_macro_record_key_kb(direction, record);
+        return;
+    }
+
+    for (uint8_t i = 0; i < size; i++) {
+        macro_buffer[macro_index(direction, record_length++)] = data[i];
+    }
+    if (!record->event.pressed) {
+        record_trim_length = record_length;
     }
     dynamic_macro_record_key_kb(direction, record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %u/%u bytes\n", DYNAMIC_MACRO_CURRENT_SLOT(), record_length, record_length + available - size);
 }
 
 /**
  * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * length of the macro.
+ *
+ * @param[in] direction Either +1 or -1, which macro was recorded.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(int8_t direction) {
     dynamic_macro_record_end_kb(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    if (record_trim_length != record_length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dprintf("dynamic macro: slot %d saved, length: %u\n", DYNAMIC_MACRO_CURRENT_SLOT(), record_trim_length);
 
-    *macro_end = macro_pointer;
+    macro_length[direction > 0 ? 0 : 1] = record_trim_length;
+
+#ifdef DYNAMIC_MACRO_PERSIST
+    dynamic_macro_save();
+#endif
 }
 
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
+/**
+ * If a dynamic macro is currently being recorded, stop recording.
  */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
-
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+void dynamic_macro_stop_recording(void) {
+    if (macro_id != 0) {
+        dynamic_macro_record_end(macro_direction(macro_id));
+    }
+    macro_id = 0;
+}
 
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+/**
+ * Play the dynamic macros and save them, a step at a time. Invoked
+ * from the main loop.
+ */
+void dynamic_macro_task(void) {
+    if (playback_depth > 0) {
+        dynamic_macro_play_task();
+    }
 
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
+#ifdef DYNAMIC_MACRO_PERSIST
+    dynamic_macro_save_task();
+#endif
+}
 
 /**
- * If a dynamic macro is currently being recorded, stop recording.
+ * Report when dynamic_macro_task() next has work to do: the next event
+ * of the macro being played, or the next chunk of a save.
+ *
+ * @param[out] deadline Timer value by which the task has to run.
+ * @return Whether there is any work pending.
  */
-void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
+bool dynamic_macro_next_deadline(uint32_t *deadline) {
+#ifdef DYNAMIC_MACRO_PERSIST
+    if (save_pending && macro_id == 0) {
+        *deadline = timer_read32();
+        return true;
     }
-    macro_id = 0;
+#endif
+
+    if (playback_depth == 0) {
+        return false;
+    }
+
+    const dynamic_macro_playback_t *macro = &playback[playback_depth - 1];
+    if (macro->position >= macro->length) {
+        *deadline = timer_read32();
+        return true;
+    }
+
+    keyrecord_t record;
+    uint16_t    position;
+    uint16_t    delay   = dynamic_macro_play_decode(macro, &position, &record);
+    uint16_t    elapsed = timer_elapsed(macro->last_time);
+    *deadline           = timer_read32() + (elapsed >= delay ? 0 : delay - elapsed);
+    return true;
 }
 
 /* Handle the key events related to the dynamic macros.
@@ -273,18 +667,18 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
+                    dynamic_macro_record_start(+1);
                     macro_id = 1;
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
+                    dynamic_macro_record_start(-1);
                     macro_id = 2;
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(+1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(-1);
                     return false;
             }
         }
@@ -310,14 +704,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_kb(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(macro_direction(macro_id), record);
                 }
                 return true;
                 break;
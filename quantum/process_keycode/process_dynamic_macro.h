@@ -22,10 +22,12 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
+/* May be overridden with a custom value. Sets the memory available to
+ * the macros, in the number of key events that fitted in it before
+ * events were stored compactly: the macro buffer takes about as much RAM
+ * as an array of DYNAMIC_MACRO_SIZE `keyrecord_t`, and typically holds
+ * several times as many events. Each keypress takes two events, one
+ * for the key-down and one for the key-up.
  *
  * Usually it should be fine to set the macro size to at least 256 but
  * there have been reports of it being too much in some users' cases,
@@ -35,6 +37,20 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Size of the macro buffer in bytes. A key event takes 2 to 8 bytes,
+ * usually 2, or 3 with DYNAMIC_MACRO_PRESERVE_TIMING.
+ */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * 8)
+#endif
+
+/* Number of bytes written to non-volatile memory per main loop
+ * iteration when saving the macros with DYNAMIC_MACRO_PERSIST.
+ */
+#ifndef DYNAMIC_MACRO_SAVE_CHUNK_SIZE
+#    define DYNAMIC_MACRO_SAVE_CHUNK_SIZE 16
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_record_start_kb(int8_t direction);
@@ -48,3 +64,8 @@ bool dynamic_macro_record_end_user(int8_t direction);
 bool dynamic_macro_valid_key_kb(uint16_t keycode, keyrecord_t *record);
 bool dynamic_macro_valid_key_user(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_stop_recording(void);
+void dynamic_macro_init(void);
+void dynamic_macro_task(void);
+bool dynamic_macro_next_deadline(uint32_t *deadline);
+bool dynamic_macro_is_playing(void);
+void dynamic_macro_stop_playing(void);
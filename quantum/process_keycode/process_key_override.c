@@ -244,147 +244,314 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_override_count() == 0) {
-        return true;
+/** Returns whether `override` should activate for this key event. */
+static bool key_override_should_activate(const key_override_t *const override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0; i < key_override_count(); i++) {
-        const key_override_t *const override = key_override_get(i);
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
-
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    return true;
+}
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+/** Activates `override`, which passed key_override_should_activate(). Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *const override, const uint16_t keycode, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    const bool no_trigger   = override->trigger == KC_NO;
+    const bool trigger_down = override->trigger == keycode && key_down;
 
-        key_override_printf("Activating override\n");
+    key_override_printf("Activating override\n");
 
-        clear_active_override(false);
+    clear_active_override(false);
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
+
+    set_suppressed_override_mods(override->suppressed_mods);
+
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
+
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+#ifdef KEY_OVERRIDE_KEY_INDEX
+/* Index of the key overrides by trigger keycode, sorted by trigger and then override index so that overrides are still
+ * tried in the same order as the linear scan. Each entry keeps a copy of the override's modifier masks, so overrides whose
+ * modifiers don't match are skipped without fetching them. */
+typedef struct {
+    uint16_t trigger;
+    uint16_t override_index;
+    uint8_t  trigger_mods;
+    uint8_t  negative_mod_mask;
+    uint8_t  one_sided_required_mods; // 0 with ko_option_one_mod, where any one of the trigger mods is enough
+} key_override_key_index_entry_t;
+
+static key_override_key_index_entry_t key_override_key_index[KEY_OVERRIDE_KEY_INDEX_SIZE];
+static uint16_t                       key_override_key_index_count   = 0;
+static bool                           key_override_key_index_valid   = false;
+static bool                           key_override_key_index_fits    = false;
+static bool                           key_override_key_index_enabled = true;
+
+static void key_override_key_index_build(void) {
+    key_override_key_index_count = 0;
+    key_override_key_index_fits  = true;
+    key_override_key_index_valid = true;
+
+    for (uint16_t i = 0; i < key_override_count(); i++) {
+        const key_override_t *const override = key_override_get(i);
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+        // End of array
+        if (override == NULL) {
+            break;
         }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+        if (key_override_key_index_count == KEY_OVERRIDE_KEY_INDEX_SIZE) {
+            dprintf("key override: %u overrides don't fit in KEY_OVERRIDE_KEY_INDEX_SIZE, falling back to a linear scan\n", key_override_count());
+            key_override_key_index_fits = false;
+            return;
+        }
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
+        const uint8_t trigger_mods = override->trigger_mods;
+
+        key_override_key_index[key_override_key_index_count++] = (key_override_key_index_entry_t){
+            .trigger                 = override->trigger,
+            .override_index          = i,
+            .trigger_mods            = trigger_mods,
+            .negative_mod_mask       = override->negative_mod_mask,
+            .one_sided_required_mods = (override->options & ko_option_one_mod) ? 0 : (trigger_mods & 0b1111) | (trigger_mods >> 4),
+        };
+    }
+
+    // Stable insertion sort by trigger -- entries are already in override order, and this only runs once
+    for (uint16_t i = 1; i < key_override_key_index_count; ++i) {
+        key_override_key_index_entry_t entry = key_override_key_index[i];
+        uint16_t                       j     = i;
+        while (j > 0 && key_override_key_index[j - 1].trigger > entry.trigger) {
+            key_override_key_index[j] = key_override_key_index[j - 1];
+            --j;
+        }
+        key_override_key_index[j] = entry;
+    }
+}
+
+static bool key_override_key_index_ready(void) {
+    if (!key_override_key_index_enabled) {
+        return false;
+    }
+    if (!key_override_key_index_valid) {
+        key_override_key_index_build();
+    }
+    return key_override_key_index_fits;
+}
+
+static uint16_t key_override_key_index_find(const uint16_t trigger) {
+    uint16_t lo = 0, hi = key_override_key_index_count;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (key_override_key_index[mid].trigger < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Same as key_override_matches_active_modifiers(), using the masks copied into the index
+static bool key_override_key_index_matches_mods(const key_override_key_index_entry_t *const entry, const uint8_t mods) {
+    if ((entry->negative_mod_mask & mods) != 0) {
+        return false;
+    }
+    if (entry->trigger_mods == 0) {
+        return true;
+    }
+
+    const uint8_t active_required_mods = entry->trigger_mods & mods;
+    if (entry->one_sided_required_mods == 0) {
+        return active_required_mods != 0;
+    }
+    return ((active_required_mods & 0b1111) | (active_required_mods >> 4)) == entry->one_sided_required_mods;
+}
+
+void key_override_key_index_invalidate(void) {
+    key_override_key_index_valid = false;
+}
+
+void key_override_key_index_set_enabled(bool enabled) {
+    key_override_key_index_enabled = enabled;
+}
+#endif
+
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_override_count() == 0) {
+        return true;
+    }
+
+#ifdef KEY_OVERRIDE_KEY_INDEX
+    if (key_override_key_index_ready()) {
+        // Only overrides without a trigger, triggered by this key, or triggered by the last key pressed down can activate. Walk
+        // those three runs of the index together, in override order.
+        const uint16_t triggers[] = {KC_NO, keycode, last_key_down};
+        uint16_t       next[3], end[3];
+        uint8_t        runs = 0;
+
+        for (uint8_t i = 0; i < 3; i++) {
+            if (i > 0 && (triggers[i] == KC_NO || (i == 2 && triggers[i] == keycode))) {
+                continue;
+            }
+            next[runs] = end[runs] = key_override_key_index_find(triggers[i]);
+            while (end[runs] < key_override_key_index_count && key_override_key_index[end[runs]].trigger == triggers[i]) {
+                ++end[runs];
+            }
+            ++runs;
+        }
+
+        while (true) {
+            int8_t run = -1;
+            for (uint8_t i = 0; i < runs; i++) {
+                if (next[i] < end[i] && (run < 0 || key_override_key_index[next[i]].override_index < key_override_key_index[next[run]].override_index)) {
+                    run = i;
                 }
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
+            if (run < 0) {
+                break;
+            }
+
+            const key_override_key_index_entry_t *const entry = &key_override_key_index[next[run]++];
+            if (!key_override_key_index_matches_mods(entry, active_mods)) {
+                continue;
+            }
+
+            const key_override_t *const override = key_override_get(entry->override_index);
+            if (override != NULL && key_override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+                *activated = true;
+                return activate_override(override, keycode, key_down, is_mod, active_mods);
+            }
         }
+    } else
+#endif
+    {
+        for (uint16_t i = 0; i < key_override_count(); i++) {
+            const key_override_t *const override = key_override_get(i);
 
-        *activated = true;
+            // End of array
+            if (override == NULL) {
+                break;
+            }
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+            if (key_override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+                *activated = true;
+                return activate_override(override, keycode, key_down, is_mod, active_mods);
+            }
+        }
     }
 
     *activated = false;
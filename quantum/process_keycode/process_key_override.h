@@ -22,6 +22,10 @@
 #include "action.h"
 #include "action_layer.h"
 
+#ifndef KEY_OVERRIDE_KEY_INDEX_SIZE
+#    define KEY_OVERRIDE_KEY_INDEX_SIZE 64
+#endif
+
 /**
  * Key overrides allow you to send a different key-modifier combination or perform a custom action when a certain modifier-key combination is pressed.
  *
@@ -105,6 +109,14 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+#ifdef KEY_OVERRIDE_KEY_INDEX
+/** Rebuilds the trigger index on the next key event, needed if key_override_get() starts returning different overrides */
+void key_override_key_index_invalidate(void);
+
+/** Switches between the trigger index and the linear scan of all overrides, mainly useful for benchmarking */
+void key_override_key_index_set_enabled(bool enabled);
+#endif
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -244,6 +244,17 @@ void tap_dance_task(void) {
     }
 }
 
+bool tap_dance_next_deadline(uint32_t *deadline) {
+    if (!active_td) {
+        return false;
+    }
+
+    uint16_t term    = GET_TAPPING_TERM(active_td, &(keyrecord_t){});
+    uint16_t elapsed = timer_elapsed(last_tap_time);
+    *deadline        = timer_read32() + (elapsed > term ? 0 : term + 1 - elapsed);
+    return true;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset(tap_dance_get(state->index), state);
@@ -249,6 +249,14 @@ extern layer_state_t layer_state;
 #    include "layer_lock.h"
 #endif
 
+#ifdef LATENCY_TRACE_ENABLE
+#    include "latency_trace.h"
+#endif
+
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 #ifdef COMMUNITY_MODULES_ENABLE
 #    include "community_modules.h"
 #endif
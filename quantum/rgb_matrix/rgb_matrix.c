@@ -38,6 +38,43 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_frame(const hsv_t *hsv, rgb_t *rgb, uint16_t count) {
+    hsv_to_rgb_frame(hsv, rgb, count);
+}
+
+#ifdef RGB_MATRIX_HSV_FRAME
+// Effect runners collect their colors here, and convert them to RGB a batch at a time
+static union {
+    hsv_t hsv;
+    rgb_t rgb;
+} hsv_frame[RGB_MATRIX_HSV_FRAME_SIZE];
+static uint8_t hsv_frame_led[RGB_MATRIX_HSV_FRAME_SIZE];
+static uint8_t hsv_frame_count = 0;
+
+static void rgb_matrix_flush_hsv_frame(void) {
+    rgb_matrix_hsv_to_rgb_frame(&hsv_frame[0].hsv, &hsv_frame[0].rgb, hsv_frame_count);
+    for (uint8_t i = 0; i < hsv_frame_count; i++) {
+        rgb_matrix_set_color(hsv_frame_led[i], hsv_frame[i].rgb.r, hsv_frame[i].rgb.g, hsv_frame[i].rgb.b);
+    }
+    hsv_frame_count = 0;
+}
+
+static void rgb_matrix_set_hsv_frame(uint8_t index, hsv_t hsv) {
+    hsv_frame[hsv_frame_count].hsv = hsv;
+    hsv_frame_led[hsv_frame_count] = index;
+    if (++hsv_frame_count == RGB_MATRIX_HSV_FRAME_SIZE) {
+        rgb_matrix_flush_hsv_frame();
+    }
+}
+#else
+static inline void rgb_matrix_flush_hsv_frame(void) {}
+
+static inline void rgb_matrix_set_hsv_frame(uint8_t index, hsv_t hsv) {
+    rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
+    rgb_matrix_set_color(index, rgb.r, rgb.g, rgb.b);
+}
+#endif
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -411,6 +448,10 @@ void rgb_matrix_task(void) {
             }
             break;
         case FLUSHING:
+            // Keep the frame until the hardware has sent the previous one, rather than wait for it
+            if (rgb_matrix_driver.busy && rgb_matrix_driver.busy()) {
+                break;
+            }
             rgb_task_flush(effect);
             break;
         case SYNCING:
@@ -419,6 +460,18 @@ void rgb_matrix_task(void) {
     }
 }
 
+bool rgb_matrix_next_deadline(uint32_t *deadline) {
+    uint32_t now = timer_read32();
+    if (rgb_task_state != SYNCING) {
+        // Rendering and flushing are spread over consecutive iterations
+        *deadline = now;
+    } else {
+        uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+        *deadline        = now + (elapsed >= RGB_MATRIX_LED_FLUSH_LIMIT ? 0 : RGB_MATRIX_LED_FLUSH_LIMIT - elapsed);
+    }
+    return true;
+}
+
 __attribute__((weak)) bool rgb_matrix_indicators_modules(void) {
     return true;
 }
@@ -90,6 +90,10 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifndef RGB_MATRIX_HSV_FRAME_SIZE
+#    define RGB_MATRIX_HSV_FRAME_SIZE 32
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -156,9 +160,13 @@ int rgb_matrix_led_index(int index);
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+// Converts a batch of colors the way the effects do, for use with rgb_matrix_set_color(). `rgb` may alias `hsv`.
+void rgb_matrix_hsv_to_rgb_frame(const hsv_t *hsv, rgb_t *rgb, uint16_t count);
+
 void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
+bool rgb_matrix_next_deadline(uint32_t *deadline);
 
 // This runs after another backlight effect and replaces
 // colors already set
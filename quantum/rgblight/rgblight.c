@@ -119,6 +119,8 @@ rgblight_segment_t const *const *rgblight_layers = NULL;
 static bool deferred_set_layer_state = false;
 #endif
 
+static bool deferred_flush = false;
+
 rgblight_ranges_t rgblight_ranges = {0, RGBLIGHT_LED_COUNT, 0, RGBLIGHT_LED_COUNT, RGBLIGHT_LED_COUNT};
 
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds) {
@@ -877,6 +879,12 @@ void rgblight_set(void) {
     }
 #endif
 
+    // Rather than wait for the previous frame to be sent, flush from rgblight_task() once it has been
+    if (rgblight_driver.busy && rgblight_driver.busy()) {
+        deferred_flush = true;
+        return;
+    }
+    deferred_flush = false;
     rgblight_driver.flush();
 }
 
@@ -1430,6 +1438,11 @@ void rgblight_task(void) {
     rgblight_timer_task();
 #endif
 
+    if (deferred_flush && !rgblight_driver.busy()) {
+        deferred_flush = false;
+        rgblight_driver.flush();
+    }
+
 #ifdef VELOCIKEY_ENABLE
     if (rgblight_velocikey_enabled()) {
         rgblight_velocikey_decelerate();
@@ -11,6 +11,7 @@ const rgblight_driver_t rgblight_driver = {
     .set_color     = ws2812_set_color,
     .set_color_all = ws2812_set_color_all,
     .flush         = ws2812_flush,
+    .busy          = ws2812_busy,
 };
 
 #elif defined(RGBLIGHT_APA102)
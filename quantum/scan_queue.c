@@ -0,0 +1,101 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "scan_queue.h"
+
+#ifdef SCAN_QUEUE_THREAD
+#    include <ch.h>
+#    ifdef TICKLESS_IDLE_ENABLE
+#        include "tickless_idle.h"
+#    endif
+
+#    ifndef SCAN_QUEUE_THREAD_STACK_SIZE
+#        define SCAN_QUEUE_THREAD_STACK_SIZE 512
+#    endif
+
+#    ifndef SCAN_QUEUE_THREAD_PRIORITY
+#        define SCAN_QUEUE_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+
+#    if SCAN_QUEUE_MIN_SLEEP_US <= 0
+#        error "SCAN_QUEUE_MIN_SLEEP_US must be positive, or the scan thread can starve the main loop"
+#    endif
+#endif
+
+#define SCAN_QUEUE_MASK (SCAN_QUEUE_SIZE - 1)
+
+// The producer only ever writes `queue_head` and the consumer only ever writes `queue_tail`. Each publishes its index
+// with release semantics after touching the slot, and reads the other's with acquire semantics, so no locking is needed
+// between the scan thread (or interrupt) and the main loop.
+static keyevent_t queue[SCAN_QUEUE_SIZE];
+static uint8_t    queue_head = 0;
+static uint8_t    queue_tail = 0;
+
+bool scan_queue_push(keyevent_t event) {
+    const uint8_t head = queue_head;
+    const uint8_t next = (head + 1) & SCAN_QUEUE_MASK;
+    if (next == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    queue[head] = event;
+    __atomic_store_n(&queue_head, next, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool scan_queue_pop(keyevent_t *event) {
+    const uint8_t tail = queue_tail;
+    if (tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE)) {
+        return false;
+    }
+    *event = queue[tail];
+    __atomic_store_n(&queue_tail, (tail + 1) & SCAN_QUEUE_MASK, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool scan_queue_is_empty(void) {
+    return queue_tail == __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+}
+
+#ifdef SCAN_QUEUE_THREAD
+static MUTEX_DECL(scan_queue_mutex);
+static THD_WORKING_AREA(waScanQueueThread, SCAN_QUEUE_THREAD_STACK_SIZE);
+
+static THD_FUNCTION(ScanQueueThread, arg) {
+    (void)arg;
+    chRegSetThreadName("scan_queue");
+
+    systime_t next = chVTGetSystemTimeX();
+    while (true) {
+        // The thread runs above the main loop, so it always has to block for a while. If the last scan ran so long
+        // that too little of its slot is left, the cadence restarts after a minimum sleep instead.
+        systime_t now    = chVTGetSystemTimeX();
+        systime_t target = chTimeAddX(next, TIME_US2I(SCAN_QUEUE_INTERVAL_US));
+        if (chTimeIsInRangeX(now, next, target) && chTimeDiffX(now, target) >= TIME_US2I(SCAN_QUEUE_MIN_SLEEP_US)) {
+            next = chThdSleepUntilWindowed(next, target);
+        } else {
+            chThdSleep(TIME_US2I(SCAN_QUEUE_MIN_SLEEP_US));
+            next = chVTGetSystemTimeX();
+        }
+        if (scan_queue_produce()) {
+#    ifdef TICKLESS_IDLE_ENABLE
+            // The main loop may be asleep until its next deadline, which is far too late for a key event
+            tickless_idle_wakeup();
+#    endif
+        }
+    }
+}
+
+void scan_queue_lock(void) {
+    chMtxLock(&scan_queue_mutex);
+}
+
+void scan_queue_unlock(void) {
+    chMtxUnlock(&scan_queue_mutex);
+}
+
+void scan_queue_init(void) {
+    chThdCreateStatic(waScanQueueThread, sizeof(waScanQueueThread), SCAN_QUEUE_THREAD_PRIORITY, ScanQueueThread, NULL);
+}
+#else
+void scan_queue_init(void) {}
+#endif
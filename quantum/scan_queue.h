@@ -0,0 +1,94 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "keyboard.h"
+
+/**
+ * \file
+ *
+ * \defgroup scan_queue Decoupled matrix scanning
+ *
+ * Matrix scanning and debouncing produce timestamped key events into a single-producer/single-consumer ring, which
+ * `matrix_task()` drains into `action_exec()`. On ChibiOS the producer runs on its own thread at a fixed interval, so
+ * the scan cadence doesn't depend on how long the keymap takes to process events, and each event carries the time
+ * the key actually changed. Elsewhere the producer runs at the start of `matrix_task()`.
+ * \{
+ */
+
+#ifndef SCAN_QUEUE_SIZE
+#    define SCAN_QUEUE_SIZE 16
+#endif
+
+#if (SCAN_QUEUE_SIZE & (SCAN_QUEUE_SIZE - 1)) != 0 || SCAN_QUEUE_SIZE > 128
+#    error "SCAN_QUEUE_SIZE must be a power of two no larger than 128"
+#endif
+
+// Split keyboards exchange matrix state with the other half as part of matrix_scan(), which has to stay on the main loop
+#if defined(PROTOCOL_CHIBIOS) && !defined(SPLIT_KEYBOARD) && !defined(SCAN_QUEUE_NO_THREAD)
+#    define SCAN_QUEUE_THREAD
+#endif
+
+#ifndef SCAN_QUEUE_INTERVAL_US
+#    define SCAN_QUEUE_INTERVAL_US 250
+#endif
+
+// Shortest time the scan thread sleeps between scans, so the main loop always gets to run even if scans overrun
+#ifndef SCAN_QUEUE_MIN_SLEEP_US
+#    define SCAN_QUEUE_MIN_SLEEP_US (SCAN_QUEUE_INTERVAL_US / 2)
+#endif
+
+/**
+ * \brief Starts the scan thread, if there is one. Invoked from keyboard_init().
+ */
+void scan_queue_init(void);
+
+/**
+ * \brief Scans the matrix and queues an event for each key that changed.
+ *
+ * Called from the scan thread, or from `matrix_task()` without one. Changes that don't fit in the queue are picked up
+ * again by the next scan rather than dropped.
+ *
+ * \return true if any key changes were queued
+ */
+bool scan_queue_produce(void);
+
+/**
+ * \brief Adds an event to the queue. Only to be called by the producer.
+ *
+ * \return false if the queue is full
+ */
+bool scan_queue_push(keyevent_t event);
+
+/**
+ * \brief Takes the oldest event off the queue. Only to be called by the consumer.
+ *
+ * \return false if the queue is empty
+ */
+bool scan_queue_pop(keyevent_t *event);
+
+/**
+ * \brief Whether there are events waiting for the consumer.
+ */
+bool scan_queue_is_empty(void);
+
+#if defined(SCAN_QUEUE_THREAD) || defined(__DOXYGEN__)
+/**
+ * \brief Keeps the scan thread away from the matrix, for code on the main loop that has to scan it directly or read
+ * more than one row of it consistently.
+ */
+void scan_queue_lock(void);
+
+/**
+ * \brief Lets the scan thread back at the matrix.
+ */
+void scan_queue_unlock(void);
+#else
+static inline void scan_queue_lock(void) {}
+static inline void scan_queue_unlock(void) {}
+#endif
+
+/** \} */
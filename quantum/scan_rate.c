@@ -0,0 +1,166 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "scan_rate.h"
+#include "timestamp.h"
+#include "debug.h"
+#include "print.h"
+#include "compiler_support.h"
+
+// The budget of one iteration has to be at least one timestamp tick, a millisecond timebase cannot limit to more than 1kHz
+STATIC_ASSERT(SCAN_RATE_TARGET_HZ <= TIMESTAMP_TICKS_PER_SECOND, "SCAN_RATE_TARGET_HZ is higher than the timestamp resolution can express");
+
+// Current window, in timestamp ticks
+static uint32_t window_start;
+static bool     window_valid;
+static uint32_t window_scans;
+static uint32_t window_max_scan;
+static uint32_t window_task[SCAN_RATE_TASK_COUNT];
+static uint32_t window_task_max[SCAN_RATE_TASK_COUNT];
+static uint16_t window_deferred[SCAN_RATE_TASK_COUNT];
+
+// Current iteration
+static uint32_t iteration_start;
+static uint32_t last_mark;
+
+// Controller state, the budget is the length of one iteration at the target rate in ticks
+static uint32_t target_hz = SCAN_RATE_TARGET_HZ;
+#if SCAN_RATE_TARGET_HZ > 0
+static uint32_t budget = TIMESTAMP_TICKS_PER_SECOND / SCAN_RATE_TARGET_HZ;
+#else
+static uint32_t budget = 0;
+#endif
+static uint32_t task_cost[SCAN_RATE_TASK_COUNT];
+static uint8_t  task_deferrals[SCAN_RATE_TASK_COUNT];
+
+static scan_rate_stats_t stats;
+
+static void publish_window(void) {
+    stats.scans_per_second = window_scans;
+    stats.max_scan_us      = timestamp_to_us(window_max_scan);
+    for (uint8_t task = 0; task < SCAN_RATE_TASK_COUNT; ++task) {
+        stats.task_us[task]     = timestamp_to_us(window_task[task]);
+        stats.task_max_us[task] = timestamp_to_us(window_task_max[task]);
+        stats.deferred[task]    = window_deferred[task];
+    }
+
+    window_scans    = 0;
+    window_max_scan = 0;
+    memset(window_task, 0, sizeof(window_task));
+    memset(window_task_max, 0, sizeof(window_task_max));
+    memset(window_deferred, 0, sizeof(window_deferred));
+}
+
+void scan_rate_begin(void) {
+    uint32_t now = timestamp_read();
+
+    if (!window_valid) {
+        window_start = now;
+        window_valid = true;
+    } else if (now - window_start >= TIMESTAMP_TICKS_PER_SECOND) {
+        publish_window();
+        window_start = now;
+    }
+
+    iteration_start = now;
+    last_mark       = now;
+}
+
+static void account(scan_rate_task_t task, uint32_t now) {
+    uint32_t elapsed = now - last_mark;
+    last_mark        = now;
+
+    window_task[task] += elapsed;
+    if (elapsed > window_task_max[task]) {
+        window_task_max[task] = elapsed;
+    }
+
+    // Decaying peak, so that a task whose cost varies between runs is judged by its expensive runs
+    uint32_t decayed = task_cost[task] - (task_cost[task] >> 4);
+    task_cost[task]  = elapsed > decayed ? elapsed : decayed;
+}
+
+void scan_rate_mark(scan_rate_task_t task) {
+    account(task, timestamp_read());
+}
+
+void scan_rate_end(void) {
+    uint32_t now = timestamp_read();
+    account(SCAN_RATE_TASK_OTHER, now);
+
+    uint32_t duration = now - iteration_start;
+    if (duration > window_max_scan) {
+        window_max_scan = duration;
+    }
+    ++window_scans;
+}
+
+bool scan_rate_should_run(scan_rate_task_t task) {
+    account(SCAN_RATE_TASK_OTHER, timestamp_read());
+
+    if (budget == 0 || (last_mark - iteration_start) + task_cost[task] <= budget || task_deferrals[task] >= SCAN_RATE_MAX_DEFERRALS) {
+        task_deferrals[task] = 0;
+        return true;
+    }
+
+    ++task_deferrals[task];
+    if (window_deferred[task] < UINT16_MAX) {
+        ++window_deferred[task];
+    }
+    return false;
+}
+
+bool scan_rate_set_target(uint32_t hz) {
+    if (hz > TIMESTAMP_TICKS_PER_SECOND) {
+        dprintf("scan rate: target %luHz exceeds the %luHz timestamp resolution\n", (unsigned long)hz, (unsigned long)TIMESTAMP_TICKS_PER_SECOND);
+        return false;
+    }
+
+    target_hz = hz;
+    budget    = hz ? TIMESTAMP_TICKS_PER_SECOND / hz : 0;
+    memset(task_deferrals, 0, sizeof(task_deferrals));
+    return true;
+}
+
+uint32_t scan_rate_get_target(void) {
+    return target_hz;
+}
+
+const scan_rate_stats_t *scan_rate_get_stats(void) {
+    return &stats;
+}
+
+void scan_rate_reset(void) {
+    window_valid = false;
+    publish_window();
+    memset(&stats, 0, sizeof(stats));
+    memset(task_cost, 0, sizeof(task_cost));
+    memset(task_deferrals, 0, sizeof(task_deferrals));
+}
+
+void scan_rate_print(void) {
+#ifdef CONSOLE_ENABLE
+    static const char *const task_names[SCAN_RATE_TASK_COUNT] = {
+        [SCAN_RATE_TASK_MATRIX]          = "matrix",
+        [SCAN_RATE_TASK_QUANTUM]         = "quantum",
+        [SCAN_RATE_TASK_RGBLIGHT]        = "rgblight",
+        [SCAN_RATE_TASK_LED_MATRIX]      = "led_matrix",
+        [SCAN_RATE_TASK_RGB_MATRIX]      = "rgb_matrix",
+        [SCAN_RATE_TASK_ENCODER]         = "encoder",
+        [SCAN_RATE_TASK_POINTING_DEVICE] = "pointing_device",
+        [SCAN_RATE_TASK_OLED]            = "oled",
+        [SCAN_RATE_TASK_ST7565]          = "st7565",
+        [SCAN_RATE_TASK_HAPTIC]          = "haptic",
+        [SCAN_RATE_TASK_OTHER]           = "other",
+    };
+
+    dprintf("scan rate: %lu scans/s, max %luus, target %luHz\n", (unsigned long)stats.scans_per_second, (unsigned long)stats.max_scan_us, (unsigned long)target_hz);
+    for (uint8_t task = 0; task < SCAN_RATE_TASK_COUNT; ++task) {
+        if (stats.task_us[task] == 0 && stats.deferred[task] == 0) {
+            continue;
+        }
+        dprintf("%-15s total=%luus max=%luus deferred=%u\n", task_names[task], (unsigned long)stats.task_us[task], (unsigned long)stats.task_max_us[task], stats.deferred[task]);
+    }
+#endif
+}
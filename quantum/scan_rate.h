@@ -0,0 +1,122 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * \defgroup scan_rate Scan rate telemetry and adaptive scan rate control
+ *
+ * Measures how often `keyboard_task()` runs, how long each iteration takes, and how that time is split between its
+ * subsystems. Optionally keeps a target scan rate by deferring low-priority tasks to a later iteration when running
+ * them would exceed the time budget of the current one.
+ * \{
+ */
+
+/**
+ * \brief The `keyboard_task()` subsystems that are timed individually.
+ */
+typedef enum {
+    SCAN_RATE_TASK_MATRIX,          ///< matrix_task()
+    SCAN_RATE_TASK_QUANTUM,         ///< quantum_task()
+    SCAN_RATE_TASK_RGBLIGHT,        ///< rgblight_task(), deferrable
+    SCAN_RATE_TASK_LED_MATRIX,      ///< led_matrix_task(), deferrable
+    SCAN_RATE_TASK_RGB_MATRIX,      ///< rgb_matrix_task(), deferrable
+    SCAN_RATE_TASK_ENCODER,         ///< encoder_task()
+    SCAN_RATE_TASK_POINTING_DEVICE, ///< pointing_device_task()
+    SCAN_RATE_TASK_OLED,            ///< oled_task(), deferrable
+    SCAN_RATE_TASK_ST7565,          ///< st7565_task(), deferrable
+    SCAN_RATE_TASK_HAPTIC,          ///< haptic_task(), deferrable
+    SCAN_RATE_TASK_OTHER,           ///< Everything else in keyboard_task()
+    SCAN_RATE_TASK_COUNT,
+} scan_rate_task_t;
+
+/**
+ * \brief Telemetry for the last complete one second window.
+ */
+typedef struct {
+    uint32_t scans_per_second;                  ///< Number of keyboard_task() iterations
+    uint32_t max_scan_us;                       ///< Longest keyboard_task() iteration
+    uint32_t task_us[SCAN_RATE_TASK_COUNT];     ///< Total time spent in each subsystem
+    uint32_t task_max_us[SCAN_RATE_TASK_COUNT]; ///< Longest single run of each subsystem
+    uint16_t deferred[SCAN_RATE_TASK_COUNT];    ///< Number of times each subsystem was deferred
+} scan_rate_stats_t;
+
+#ifndef SCAN_RATE_TARGET_HZ
+#    define SCAN_RATE_TARGET_HZ 0
+#endif
+
+#ifndef SCAN_RATE_MAX_DEFERRALS
+#    define SCAN_RATE_MAX_DEFERRALS 8
+#endif
+
+/**
+ * \brief Marks the start of a keyboard_task() iteration.
+ */
+void scan_rate_begin(void);
+
+/**
+ * \brief Attributes the time since the previous mark to the given subsystem.
+ */
+void scan_rate_mark(scan_rate_task_t task);
+
+/**
+ * \brief Marks the end of a keyboard_task() iteration.
+ */
+void scan_rate_end(void);
+
+/**
+ * \brief Decides whether a deferrable subsystem runs in this iteration.
+ *
+ * The subsystem is deferred if its recent cost would take the iteration past the budget of the target scan rate,
+ * unless it has already been deferred `SCAN_RATE_MAX_DEFERRALS` times in a row. Time since the previous mark is
+ * attributed to `SCAN_RATE_TASK_OTHER`.
+ *
+ * \return true if the subsystem should run now
+ */
+bool scan_rate_should_run(scan_rate_task_t task);
+
+/**
+ * \brief Sets the scan rate the controller aims for. `0` disables deferral.
+ *
+ * \return false if the rate is finer than the timestamp source can resolve, the previous target is kept
+ */
+bool scan_rate_set_target(uint32_t hz);
+
+/**
+ * \brief Returns the scan rate the controller aims for, `0` if disabled.
+ */
+uint32_t scan_rate_get_target(void);
+
+/**
+ * \brief Retrieves the telemetry of the last complete one second window.
+ */
+const scan_rate_stats_t *scan_rate_get_stats(void);
+
+/**
+ * \brief Clears the telemetry and the controller state, and starts a new window.
+ */
+void scan_rate_reset(void);
+
+/**
+ * \brief Prints the telemetry of the last complete window over console.
+ */
+void scan_rate_print(void);
+
+#ifdef SCAN_RATE_ENABLE
+#    define SCAN_RATE_BEGIN() scan_rate_begin()
+#    define SCAN_RATE_MARK(task) scan_rate_mark(SCAN_RATE_TASK_##task)
+#    define SCAN_RATE_END() scan_rate_end()
+#    define SCAN_RATE_SHOULD_RUN(task) scan_rate_should_run(SCAN_RATE_TASK_##task)
+#else
+#    define SCAN_RATE_BEGIN()
+#    define SCAN_RATE_MARK(task)
+#    define SCAN_RATE_END()
+#    define SCAN_RATE_SHOULD_RUN(task) true
+#endif
+
+/** \} */
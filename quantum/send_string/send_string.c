@@ -18,12 +18,17 @@
 
 #include <ctype.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "quantum_keycodes.h"
 #include "keycode.h"
 #include "action.h"
 #include "wait.h"
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "deferred_exec.h"
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -150,6 +155,18 @@ void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
+#ifdef SEND_STRING_ASYNC_ENABLE
+static bool send_string_async_enqueue(char (*getter)(void *), const void *arg, size_t arg_size, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+
+void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
+    // Queue behind any asynchronous strings so the output is never interleaved, then type everything out
+    if (!send_string_async_enqueue(getter, arg, 0, interval, NULL, NULL)) {
+        send_string_async_flush();
+        send_string_async_enqueue(getter, arg, 0, interval, NULL, NULL);
+    }
+    send_string_async_flush();
+}
+#else
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval) {
     while (1) {
         char ascii_code = getter(arg);
@@ -192,6 +209,7 @@ void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t inte
         }
     }
 }
+#endif
 
 typedef struct send_string_memory_state_t {
     const char *string;
@@ -326,3 +344,256 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
     send_string_with_delay_impl(send_string_get_next_progmem, &state, interval);
 }
 #endif
+
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    ifndef SEND_STRING_ASYNC_QUEUE_SIZE
+#        define SEND_STRING_ASYNC_QUEUE_SIZE 4
+#    endif
+#    ifndef SEND_STRING_ASYNC_STATE_SIZE
+#        define SEND_STRING_ASYNC_STATE_SIZE 8
+#    endif
+#    ifndef SEND_STRING_ASYNC_BURST
+#        define SEND_STRING_ASYNC_BURST 8
+#    endif
+
+typedef struct send_string_async_job_t {
+    char (*getter)(void *);
+    void                        *arg;
+    send_string_async_callback_t callback;
+    void                        *cb_arg;
+    uint8_t                      interval;
+    union {
+        uint8_t  bytes[SEND_STRING_ASYNC_STATE_SIZE];
+        void    *align_ptr;
+        uint32_t align_u32;
+    } state;
+} send_string_async_job_t;
+
+enum {
+    SEND_STRING_OP_DOWN      = 1 << 0,
+    SEND_STRING_OP_UP        = 1 << 1,
+    SEND_STRING_OP_TAP_DELAY = 1 << 2, // wait the tap delay afterwards, rather than the interval
+};
+
+typedef struct send_string_op_t {
+    uint8_t keycode;
+    uint8_t flags;
+} send_string_op_t;
+
+static send_string_async_job_t async_queue[SEND_STRING_ASYNC_QUEUE_SIZE];
+static uint8_t                 async_head  = 0;
+static uint8_t                 async_count = 0;
+static deferred_token          async_token = INVALID_DEFERRED_TOKEN;
+
+// Key events the current character of the string at the head of the queue expands to
+static send_string_op_t async_ops[8];
+static uint8_t          async_op_count    = 0;
+static uint8_t          async_op_index    = 0;
+static uint32_t         async_op_delay    = 0; // SS_DELAY() time, waited on top of the interval
+static bool             async_source_done = false;
+
+// Keys pressed by queued strings and not yet released, so cancellation can release them
+static uint8_t async_held[32];
+
+static void send_string_async_push_op(uint8_t keycode, uint8_t flags) {
+    async_ops[async_op_count++] = (send_string_op_t){.keycode = keycode, .flags = flags};
+}
+
+// Reads the string at the head of the queue until it expands to at least one key event, returning false at its end
+static bool send_string_async_load(send_string_async_job_t *job) {
+    async_op_count = 0;
+    async_op_index = 0;
+    while (!async_source_done && !async_op_count) {
+        char ascii_code = job->getter(job->arg);
+        if (!ascii_code) {
+            async_source_done = true;
+        } else if (ascii_code == SS_QMK_PREFIX) {
+            ascii_code = job->getter(job->arg);
+
+            if (ascii_code == SS_TAP_CODE) {
+                uint8_t keycode = job->getter(job->arg);
+                send_string_async_push_op(keycode, SEND_STRING_OP_DOWN | SEND_STRING_OP_TAP_DELAY);
+                send_string_async_push_op(keycode, SEND_STRING_OP_UP);
+            } else if (ascii_code == SS_DOWN_CODE) {
+                send_string_async_push_op(job->getter(job->arg), SEND_STRING_OP_DOWN);
+            } else if (ascii_code == SS_UP_CODE) {
+                send_string_async_push_op(job->getter(job->arg), SEND_STRING_OP_UP);
+            } else {
+                if (ascii_code == SS_DELAY_CODE) {
+                    async_op_delay = 0;
+                    ascii_code     = job->getter(job->arg);
+                    while (isdigit(ascii_code)) {
+                        async_op_delay *= 10;
+                        async_op_delay += ascii_code - '0';
+                        ascii_code = job->getter(job->arg);
+                    }
+                }
+                send_string_async_push_op(KC_NO, 0);
+            }
+
+            // if we had a delay that terminated with a null, we're done
+            if (ascii_code == 0) async_source_done = true;
+        } else {
+#    if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+            if (ascii_code == '\a') { // BEL
+                PLAY_SONG(bell_song);
+                continue;
+            }
+#    endif
+
+            uint8_t keycode    = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+            bool    is_shifted = PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code);
+            bool    is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code);
+            bool    is_dead    = PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code);
+
+            if (is_shifted) send_string_async_push_op(KC_LEFT_SHIFT, SEND_STRING_OP_DOWN);
+            if (is_altgred) send_string_async_push_op(KC_RIGHT_ALT, SEND_STRING_OP_DOWN);
+            send_string_async_push_op(keycode, SEND_STRING_OP_DOWN);
+            send_string_async_push_op(keycode, SEND_STRING_OP_UP);
+            if (is_altgred) send_string_async_push_op(KC_RIGHT_ALT, SEND_STRING_OP_UP);
+            if (is_shifted) send_string_async_push_op(KC_LEFT_SHIFT, SEND_STRING_OP_UP);
+            if (is_dead) {
+                send_string_async_push_op(KC_SPACE, SEND_STRING_OP_DOWN | SEND_STRING_OP_TAP_DELAY);
+                send_string_async_push_op(KC_SPACE, SEND_STRING_OP_UP);
+            }
+        }
+    }
+    return async_op_count > 0;
+}
+
+static void send_string_async_finish(bool completed) {
+    send_string_async_callback_t callback = async_queue[async_head].callback;
+    void                        *cb_arg   = async_queue[async_head].cb_arg;
+
+    async_head = (async_head + 1) % SEND_STRING_ASYNC_QUEUE_SIZE;
+    --async_count;
+    async_op_count    = 0;
+    async_op_index    = 0;
+    async_op_delay    = 0;
+    async_source_done = false;
+
+    // Invoked last, as the callback may queue another string
+    if (callback) {
+        callback(completed, cb_arg);
+    }
+}
+
+// Types out queued strings until the next wait, returning false once the queue is empty. A zero delay means the burst
+// limit was reached and typing should carry on at the next opportunity.
+static bool send_string_async_run(uint8_t max_ops, uint32_t *delay) {
+    while (async_count) {
+        send_string_async_job_t *job = &async_queue[async_head];
+        if (async_op_index == async_op_count && !send_string_async_load(job)) {
+            send_string_async_finish(true);
+            continue;
+        }
+
+        if (max_ops == 0) {
+            *delay = 0;
+            return true;
+        }
+        --max_ops;
+
+        send_string_op_t op   = async_ops[async_op_index++];
+        uint32_t         wait = job->interval;
+        if (op.flags & SEND_STRING_OP_TAP_DELAY) {
+            wait = op.keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY;
+        }
+
+        if (op.flags & SEND_STRING_OP_DOWN) {
+            async_held[op.keycode / 8] |= 1 << (op.keycode % 8);
+            register_code(op.keycode);
+        } else if (op.flags & SEND_STRING_OP_UP) {
+            async_held[op.keycode / 8] &= ~(1 << (op.keycode % 8));
+            unregister_code(op.keycode);
+        } else {
+            wait += async_op_delay;
+            async_op_delay = 0;
+        }
+
+        if (wait) {
+            *delay = wait;
+            return true;
+        }
+    }
+    return false;
+}
+
+static uint32_t send_string_async_task(uint32_t trigger_time, void *cb_arg) {
+    uint32_t delay;
+    if (send_string_async_run(SEND_STRING_ASYNC_BURST, &delay)) {
+        return delay ? delay : 1;
+    }
+    async_token = INVALID_DEFERRED_TOKEN;
+    return 0;
+}
+
+static bool send_string_async_enqueue(char (*getter)(void *), const void *arg, size_t arg_size, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    if (async_count >= SEND_STRING_ASYNC_QUEUE_SIZE || arg_size > SEND_STRING_ASYNC_STATE_SIZE) {
+        return false;
+    }
+
+    send_string_async_job_t *job = &async_queue[(async_head + async_count) % SEND_STRING_ASYNC_QUEUE_SIZE];
+    job->getter                  = getter;
+    job->callback                = callback;
+    job->cb_arg                  = cb_arg;
+    job->interval                = interval;
+    if (arg_size) {
+        memcpy(job->state.bytes, arg, arg_size);
+        job->arg = job->state.bytes;
+    } else {
+        job->arg = (void *)arg;
+    }
+    ++async_count;
+    return true;
+}
+
+bool send_string_async_impl(char (*getter)(void *), const void *arg, size_t arg_size, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    if (async_token == INVALID_DEFERRED_TOKEN) {
+        async_token = defer_exec(1, send_string_async_task, NULL);
+        if (async_token == INVALID_DEFERRED_TOKEN) {
+            return false;
+        }
+    }
+    return send_string_async_enqueue(getter, arg, arg_size, interval, callback, cb_arg);
+}
+
+bool send_string_async(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_impl(send_string_get_next_ram, &state, sizeof(state), interval, callback, cb_arg);
+}
+
+#    if defined(__AVR__)
+bool send_string_async_P(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg) {
+    send_string_memory_state_t state = {string};
+    return send_string_async_impl(send_string_get_next_progmem, &state, sizeof(state), interval, callback, cb_arg);
+}
+#    endif
+
+uint8_t send_string_async_pending(void) {
+    return async_count;
+}
+
+void send_string_async_cancel(void) {
+    for (uint16_t keycode = 0; keycode < 256; ++keycode) {
+        if (async_held[keycode / 8] & (1 << (keycode % 8))) {
+            unregister_code(keycode);
+        }
+    }
+    memset(async_held, 0, sizeof(async_held));
+
+    // Callbacks may queue new strings, which are left alone
+    for (uint8_t count = async_count; count; --count) {
+        send_string_async_finish(false);
+    }
+}
+
+void send_string_async_flush(void) {
+    uint32_t delay;
+    while (send_string_async_run(UINT8_MAX, &delay)) {
+        if (delay) {
+            wait_ms(delay);
+        }
+    }
+}
+#endif
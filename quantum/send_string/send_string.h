@@ -23,6 +23,8 @@
  * \{
  */
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -169,4 +171,69 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 void send_string_with_delay_impl(char (*getter)(void *), void *arg, uint8_t interval);
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Callback invoked once an asynchronous string has finished.
+ *
+ * \param completed `true` if the whole string was typed, `false` if it was cancelled.
+ * \param cb_arg The argument given when the string was queued.
+ */
+typedef void (*send_string_async_callback_t)(bool completed, void *cb_arg);
+
+/**
+ * \brief Queue a string of ASCII characters to be typed out from the main loop.
+ *
+ * The string is not copied, and must remain valid until the callback is invoked.
+ *
+ * \param string The string to type out.
+ * \param interval The amount of time, in milliseconds, to wait between each key event.
+ * \param callback The function to invoke once the string has been typed or cancelled. May be NULL.
+ * \param cb_arg The argument to pass to the callback.
+ * \return `false` if the queue is full, in which case the string is dropped and the callback is not invoked.
+ */
+bool send_string_async(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+
+#    if defined(__AVR__) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a PROGMEM string of ASCII characters to be typed out from the main loop.
+ *
+ * On ARM devices, this function is simply an alias for send_string_async().
+ */
+bool send_string_async_P(const char *string, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+#    else
+#        define send_string_async_P(string, interval, callback, cb_arg) send_string_async(string, interval, callback, cb_arg)
+#    endif
+
+/**
+ * \brief Shortcut macro for send_string_async_P(PSTR(string), 0, NULL, NULL).
+ */
+#    define SEND_STRING_ASYNC(string) send_string_async_P(PSTR(string), 0, NULL, NULL)
+
+/**
+ * \brief Queue a string read through a getter, as send_string_with_delay_impl() does.
+ *
+ * The `arg_size` bytes at `arg` are copied into the queue, so the getter's state does not need to outlive this call.
+ *
+ * \return `false` if the queue is full or the state is larger than `SEND_STRING_ASYNC_STATE_SIZE`.
+ */
+bool send_string_async_impl(char (*getter)(void *), const void *arg, size_t arg_size, uint8_t interval, send_string_async_callback_t callback, void *cb_arg);
+
+/**
+ * \brief The number of strings queued, including the one being typed.
+ */
+uint8_t send_string_async_pending(void);
+
+/**
+ * \brief Stop typing, release any keys held by queued strings, and drop everything queued.
+ *
+ * Callbacks of the dropped strings are invoked with `completed` set to `false`.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Block until every queued string has been typed.
+ */
+void send_string_async_flush(void);
+#endif
+
 /** \} */
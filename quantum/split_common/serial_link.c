@@ -0,0 +1,341 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "serial_link.h"
+#include "crc.h"
+#include "timer.h"
+
+#define SERIAL_LINK_TYPE_MASK 0x0F
+#define SERIAL_LINK_FLAGS_MASK 0xF0
+
+enum serial_link_frame_type {
+    SERIAL_LINK_DATA = 1,
+    SERIAL_LINK_ACK,
+    SERIAL_LINK_RESET,
+    SERIAL_LINK_RESET_ACK,
+};
+
+enum serial_link_header {
+    SERIAL_LINK_HEADER_TYPE,
+    SERIAL_LINK_HEADER_SEQ,
+    SERIAL_LINK_HEADER_ACK,
+    SERIAL_LINK_HEADER_SACK,
+    SERIAL_LINK_HEADER_ID,
+    SERIAL_LINK_HEADER_LENGTH,
+};
+
+#define serial_link_tx_slot(link, seq) (&(link)->tx[(uint8_t)(seq) % SERIAL_LINK_WINDOW])
+#define serial_link_rx_slot(link, seq) (&(link)->rx[(uint8_t)(seq) % SERIAL_LINK_WINDOW])
+#define serial_link_in_flight(link) ((uint8_t)((link)->tx_next - (link)->tx_base))
+
+static void serial_link_clear(serial_link_t *link) {
+    link->tx_base     = 0;
+    link->tx_next     = 0;
+    link->rx_next     = 0;
+    link->backoff     = 0;
+    link->ack_pending = false;
+    memset(link->tx, 0, sizeof(link->tx));
+    memset(link->rx, 0, sizeof(link->rx));
+}
+
+void serial_link_init(serial_link_t *link, bool initiator, serial_link_write_t write, serial_link_receive_t receive, serial_link_reset_t reset) {
+    memset(link, 0, sizeof(*link));
+    link->write         = write;
+    link->receive       = receive;
+    link->reset         = reset;
+    link->initiator     = initiator;
+    link->session       = 1;
+    link->last_sent     = timer_read();
+    link->last_received = link->last_sent;
+}
+
+// Bitmap of the data frames received after rx_next, bit 0 being rx_next + 1
+static uint8_t serial_link_sack(const serial_link_t *link) {
+    uint8_t sack = 0;
+    for (uint8_t i = 0; i < SERIAL_LINK_WINDOW - 1; ++i) {
+        uint8_t seq  = link->rx_next + 1 + i;
+        const serial_link_rx_slot_t *slot = serial_link_rx_slot(link, seq);
+        if (slot->valid && slot->seq == seq) {
+            sack |= 1 << i;
+        }
+    }
+    return sack;
+}
+
+static void serial_link_write_frame(serial_link_t *link, uint8_t type, uint8_t seq, uint8_t id, const uint8_t *data, uint8_t length) {
+    uint8_t frame[SERIAL_LINK_FRAME_SIZE];
+    uint8_t frame_length = SERIAL_LINK_HEADER_SIZE + length;
+
+    frame[SERIAL_LINK_HEADER_TYPE]   = type;
+    frame[SERIAL_LINK_HEADER_SEQ]    = seq;
+    frame[SERIAL_LINK_HEADER_ACK]    = link->rx_next;
+    frame[SERIAL_LINK_HEADER_SACK]   = serial_link_sack(link);
+    frame[SERIAL_LINK_HEADER_ID]     = id;
+    frame[SERIAL_LINK_HEADER_LENGTH] = length;
+    memcpy(&frame[SERIAL_LINK_HEADER_SIZE], data, length);
+    frame[frame_length] = crc8(frame, frame_length);
+    ++frame_length;
+
+    // Worst case every byte is escaped, plus a flag at either end
+    uint8_t buffer[2 * SERIAL_LINK_FRAME_SIZE + 2];
+    size_t  buffer_length     = 0;
+    buffer[buffer_length++] = SERIAL_LINK_FLAG;
+    for (uint8_t i = 0; i < frame_length; ++i) {
+        if (frame[i] == SERIAL_LINK_FLAG || frame[i] == SERIAL_LINK_ESCAPE) {
+            buffer[buffer_length++] = SERIAL_LINK_ESCAPE;
+            buffer[buffer_length++] = frame[i] ^ 0x20;
+        } else {
+            buffer[buffer_length++] = frame[i];
+        }
+    }
+    buffer[buffer_length++] = SERIAL_LINK_FLAG;
+
+    link->write(link, buffer, buffer_length);
+    link->last_sent   = timer_read();
+    link->ack_pending = false;
+    ++link->stats.frames_sent;
+}
+
+static void serial_link_transmit(serial_link_t *link, uint8_t seq) {
+    serial_link_tx_slot_t *slot = serial_link_tx_slot(link, seq);
+    serial_link_write_frame(link, SERIAL_LINK_DATA | slot->flags, seq, slot->id, slot->data, slot->length);
+    slot->sent = timer_read();
+}
+
+static void serial_link_retransmit(serial_link_t *link, uint8_t seq) {
+    serial_link_transmit(link, seq);
+    ++link->stats.retransmits;
+}
+
+// Brings the link up, on both sides, once the reset handshake is done
+static void serial_link_connect(serial_link_t *link) {
+    serial_link_clear(link);
+    link->connected      = true;
+    link->reset_received = false;
+    link->last_received  = timer_read();
+    ++link->stats.resets;
+    if (link->reset) {
+        link->reset(link);
+    }
+}
+
+static void serial_link_disconnect(serial_link_t *link) {
+    serial_link_clear(link);
+    link->connected      = false;
+    link->reset_received = false;
+    ++link->session;
+    ++link->stats.timeouts;
+}
+
+static void serial_link_handle_ack(serial_link_t *link, uint8_t ack, uint8_t sack) {
+    uint8_t in_flight = serial_link_in_flight(link);
+    uint8_t acked     = ack - link->tx_base;
+
+    // Acknowledges something that was never sent, so it must belong to an earlier session
+    if (acked > in_flight) {
+        return;
+    }
+    link->tx_base = ack;
+    in_flight -= acked;
+
+    // The line is getting frames across, so the ones still in flight are queued behind them rather than lost. Their
+    // timeouts start over, as otherwise a window that takes longer than SERIAL_LINK_RETRANSMIT_MS to send is sent twice.
+    if (acked) {
+        uint16_t now  = timer_read();
+        link->backoff = 0;
+        for (uint8_t offset = 0; offset < in_flight; ++offset) {
+            serial_link_tx_slot(link, ack + offset)->sent = now;
+        }
+    }
+
+    uint8_t last_sacked = 0;
+    for (uint8_t i = 0; i < SERIAL_LINK_WINDOW - 1; ++i) {
+        uint8_t offset = 1 + i;
+        if ((sack & (1 << i)) && offset < in_flight) {
+            serial_link_tx_slot(link, ack + offset)->acked = true;
+            last_sacked                                     = offset;
+        }
+    }
+
+    // Frames that are missing ahead of one that arrived were lost, so send them again without waiting for the timeout.
+    // Each frame only gets this once, as every frame that follows carries the same bitmap.
+    for (uint8_t offset = 0; offset < last_sacked; ++offset) {
+        serial_link_tx_slot_t *slot = serial_link_tx_slot(link, ack + offset);
+        if (!slot->acked && !slot->resent) {
+            slot->resent = true;
+            serial_link_retransmit(link, ack + offset);
+        }
+    }
+}
+
+static void serial_link_handle_data(serial_link_t *link, uint8_t seq, uint8_t flags, uint8_t id, const uint8_t *data, uint8_t length) {
+    uint8_t offset = seq - link->rx_next;
+
+    // Also acknowledges frames received before, in case the acknowledgement was lost
+    link->ack_pending = true;
+
+    if (offset == 0) {
+        ++link->rx_next;
+        link->receive(link, id, flags, data, length);
+
+        // Hand over the frames that were held back behind this one
+        serial_link_rx_slot_t *slot = serial_link_rx_slot(link, link->rx_next);
+        while (slot->valid && slot->seq == link->rx_next) {
+            slot->valid = false;
+            ++link->rx_next;
+            link->receive(link, slot->id, slot->flags, slot->data, slot->length);
+            slot = serial_link_rx_slot(link, link->rx_next);
+        }
+    } else if (offset < SERIAL_LINK_WINDOW) {
+        serial_link_rx_slot_t *slot = serial_link_rx_slot(link, seq);
+        slot->valid                   = true;
+        slot->seq                     = seq;
+        slot->id                      = id;
+        slot->flags                   = flags;
+        slot->length                  = length;
+        memcpy(slot->data, data, length);
+    }
+    // Anything else has been received already
+}
+
+static void serial_link_handle_frame(serial_link_t *link, const uint8_t *frame, uint8_t length) {
+    if (length < SERIAL_LINK_HEADER_SIZE + 1 || frame[SERIAL_LINK_HEADER_LENGTH] != length - SERIAL_LINK_HEADER_SIZE - 1 || crc8(frame, length - 1) != frame[length - 1]) {
+        ++link->stats.crc_errors;
+        return;
+    }
+
+    uint8_t type = frame[SERIAL_LINK_HEADER_TYPE] & SERIAL_LINK_TYPE_MASK;
+    uint8_t seq  = frame[SERIAL_LINK_HEADER_SEQ];
+
+    switch (type) {
+        case SERIAL_LINK_RESET:
+            if (!link->initiator) {
+                // Drop everything, and wait for the initiator to show it got the reply before sending anything
+                serial_link_clear(link);
+                link->connected      = false;
+                link->reset_received = true;
+                link->session        = seq;
+                serial_link_write_frame(link, SERIAL_LINK_RESET_ACK, seq, 0, NULL, 0);
+            }
+            return;
+        case SERIAL_LINK_RESET_ACK:
+            if (link->initiator && !link->connected && seq == link->session) {
+                serial_link_connect(link);
+                // Lets the other side know the handshake is done
+                link->ack_pending = true;
+            }
+            return;
+        case SERIAL_LINK_DATA:
+        case SERIAL_LINK_ACK:
+            break;
+        default:
+            return;
+    }
+
+    if (!link->connected) {
+        // The first frame after the reset reply means no more resets of that handshake are on the way
+        if (!link->reset_received) {
+            return;
+        }
+        serial_link_connect(link);
+    }
+    link->last_received = timer_read();
+
+    serial_link_handle_ack(link, frame[SERIAL_LINK_HEADER_ACK], frame[SERIAL_LINK_HEADER_SACK]);
+    if (type == SERIAL_LINK_DATA) {
+        serial_link_handle_data(link, seq, frame[SERIAL_LINK_HEADER_TYPE] & SERIAL_LINK_FLAGS_MASK, frame[SERIAL_LINK_HEADER_ID], &frame[SERIAL_LINK_HEADER_SIZE], frame[SERIAL_LINK_HEADER_LENGTH]);
+    }
+}
+
+void serial_link_receive_bytes(serial_link_t *link, const uint8_t *data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        uint8_t byte = data[i];
+
+        if (byte == SERIAL_LINK_FLAG) {
+            if (link->frame_length > 0 && !link->frame_overflow && !link->frame_escape) {
+                serial_link_handle_frame(link, link->frame, link->frame_length);
+            } else if (link->frame_length > 0 || link->frame_overflow) {
+                ++link->stats.crc_errors;
+            }
+            link->frame_length   = 0;
+            link->frame_escape   = false;
+            link->frame_overflow = false;
+            continue;
+        }
+        if (link->frame_overflow) {
+            continue;
+        }
+        if (byte == SERIAL_LINK_ESCAPE) {
+            link->frame_escape = true;
+            continue;
+        }
+        if (link->frame_escape) {
+            byte ^= 0x20;
+            link->frame_escape = false;
+        }
+        if (link->frame_length == sizeof(link->frame)) {
+            link->frame_overflow = true;
+            continue;
+        }
+        link->frame[link->frame_length++] = byte;
+    }
+}
+
+void serial_link_task(serial_link_t *link) {
+    if (!link->connected) {
+        if (link->initiator && timer_elapsed(link->last_sent) >= SERIAL_LINK_RETRANSMIT_MS) {
+            serial_link_write_frame(link, SERIAL_LINK_RESET, link->session, 0, NULL, 0);
+        }
+        return;
+    }
+
+    // Nothing heard for too long, or the oldest frame is getting nowhere
+    if (timer_elapsed(link->last_received) > SERIAL_LINK_TIMEOUT_MS || (link->tx_base != link->tx_next && timer_elapsed(serial_link_tx_slot(link, link->tx_base)->first_sent) > SERIAL_LINK_TIMEOUT_MS)) {
+        serial_link_disconnect(link);
+        return;
+    }
+
+    bool timed_out = false;
+    for (uint8_t seq = link->tx_base; seq != link->tx_next; ++seq) {
+        serial_link_tx_slot_t *slot = serial_link_tx_slot(link, seq);
+        if (!slot->acked && timer_elapsed(slot->sent) >= (SERIAL_LINK_RETRANSMIT_MS << link->backoff)) {
+            serial_link_retransmit(link, seq);
+            timed_out = true;
+        }
+    }
+    if (timed_out && link->backoff < SERIAL_LINK_RETRANSMIT_BACKOFF) {
+        ++link->backoff;
+    }
+
+    if (link->ack_pending || timer_elapsed(link->last_sent) >= SERIAL_LINK_KEEPALIVE_MS) {
+        serial_link_write_frame(link, SERIAL_LINK_ACK, 0, 0, NULL, 0);
+    }
+}
+
+bool serial_link_can_send(const serial_link_t *link) {
+    return link->connected && serial_link_in_flight(link) < SERIAL_LINK_WINDOW;
+}
+
+bool serial_link_is_idle(const serial_link_t *link) {
+    return link->tx_base == link->tx_next;
+}
+
+bool serial_link_send(serial_link_t *link, uint8_t id, uint8_t flags, const void *data, uint8_t length) {
+    if (length > SERIAL_LINK_PAYLOAD_SIZE || !serial_link_can_send(link)) {
+        return false;
+    }
+
+    serial_link_tx_slot_t *slot = serial_link_tx_slot(link, link->tx_next);
+    slot->id                      = id;
+    slot->flags                   = flags & SERIAL_LINK_FLAGS_MASK;
+    slot->length                  = length;
+    slot->acked                   = false;
+    slot->resent                  = false;
+    slot->first_sent              = timer_read();
+    memcpy(slot->data, data, length);
+
+    serial_link_transmit(link, link->tx_next++);
+    return true;
+}
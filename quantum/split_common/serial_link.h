@@ -0,0 +1,176 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Framed, full duplex link between the two halves of a split keyboard.
+ *
+ * Frames are delimited by SERIAL_LINK_FLAG bytes, with any flag or escape byte inside a frame escaped, so the receiver
+ * finds the start of the next frame again after line noise. Every frame ends in a CRC8 of its contents and frames
+ * that fail it are dropped.
+ *
+ * Data frames are numbered and up to SERIAL_LINK_WINDOW of them can be in flight at once. Every frame sent back
+ * acknowledges all data frames received in order, plus a bitmap of the ones that arrived after a gap, so only the
+ * frames that were actually lost get sent again. Data is handed over in the order it was sent.
+ *
+ * Either side can send data at any time. The initiator starts, and restarts, the link with a reset handshake.
+ */
+
+#ifndef SERIAL_LINK_WINDOW
+#    define SERIAL_LINK_WINDOW 4
+#endif
+
+// Frames are kept in the slot of their 8 bit sequence number modulo the window, which only stays in step across the
+// wrap from 255 to 0 when the window divides 256
+#if (SERIAL_LINK_WINDOW != 1) && (SERIAL_LINK_WINDOW != 2) && (SERIAL_LINK_WINDOW != 4) && (SERIAL_LINK_WINDOW != 8)
+#    error "SERIAL_LINK_WINDOW must be 1, 2, 4 or 8"
+#endif
+
+#ifndef SERIAL_LINK_PAYLOAD_SIZE
+#    define SERIAL_LINK_PAYLOAD_SIZE 64
+#endif
+
+// Frames, with their header and CRC, have to fit in 255 bytes
+#if SERIAL_LINK_PAYLOAD_SIZE > 248
+#    error "SERIAL_LINK_PAYLOAD_SIZE must be 248 or less"
+#endif
+
+// Time before a frame that hasn't been acknowledged is sent again. It doubles every time this happens without the line
+// making progress, up to SERIAL_LINK_RETRANSMIT_BACKOFF doublings, so a busy line isn't flooded with copies.
+#ifndef SERIAL_LINK_RETRANSMIT_MS
+#    define SERIAL_LINK_RETRANSMIT_MS 5
+#endif
+
+#ifndef SERIAL_LINK_RETRANSMIT_BACKOFF
+#    define SERIAL_LINK_RETRANSMIT_BACKOFF 2
+#endif
+
+// Longest time without sending anything, after which a bare acknowledgement is sent to show the link is up
+#ifndef SERIAL_LINK_KEEPALIVE_MS
+#    define SERIAL_LINK_KEEPALIVE_MS 10
+#endif
+
+// Time without a valid frame, or without progress on the oldest frame in flight, after which the link is down
+#ifndef SERIAL_LINK_TIMEOUT_MS
+#    define SERIAL_LINK_TIMEOUT_MS 50
+#endif
+
+#define SERIAL_LINK_FLAG 0x7E
+#define SERIAL_LINK_ESCAPE 0x7D
+
+// Flags passed through with data, for the layer above
+#define SERIAL_LINK_REQUEST 0x10
+#define SERIAL_LINK_REPLY 0x20
+
+// Frame type and flags, sequence number, acknowledgement, selective acknowledgement bitmap, id and payload length
+#define SERIAL_LINK_HEADER_SIZE 6
+#define SERIAL_LINK_FRAME_SIZE (SERIAL_LINK_HEADER_SIZE + SERIAL_LINK_PAYLOAD_SIZE + 1)
+
+typedef struct serial_link_t serial_link_t;
+
+// Writes bytes to the line
+typedef void (*serial_link_write_t)(serial_link_t *link, const uint8_t *data, size_t length);
+// Handles data received in order
+typedef void (*serial_link_receive_t)(serial_link_t *link, uint8_t id, uint8_t flags, const uint8_t *data, uint8_t length);
+// Handles the link coming up after a reset, which drops any data that was still in flight
+typedef void (*serial_link_reset_t)(serial_link_t *link);
+
+typedef struct {
+    uint16_t frames_sent;
+    uint16_t retransmits;
+    uint16_t crc_errors;
+    uint16_t resets;
+    uint16_t timeouts;
+} serial_link_stats_t;
+
+typedef struct {
+    uint8_t  id;
+    uint8_t  flags;
+    uint8_t  length;
+    bool     acked;
+    bool     resent;
+    uint16_t first_sent;
+    uint16_t sent;
+    uint8_t  data[SERIAL_LINK_PAYLOAD_SIZE];
+} serial_link_tx_slot_t;
+
+typedef struct {
+    bool    valid;
+    uint8_t seq;
+    uint8_t id;
+    uint8_t flags;
+    uint8_t length;
+    uint8_t data[SERIAL_LINK_PAYLOAD_SIZE];
+} serial_link_rx_slot_t;
+
+struct serial_link_t {
+    serial_link_write_t   write;
+    serial_link_receive_t receive;
+    serial_link_reset_t   reset;
+    bool                  initiator;
+    bool                  connected;
+    bool                  reset_received;
+    bool                  ack_pending;
+    uint8_t               session;
+    uint8_t               backoff;
+    uint16_t              last_sent;
+    uint16_t              last_received;
+
+    // Data frames sent and not yet acknowledged, tx_base up to tx_next
+    uint8_t                tx_base;
+    uint8_t                tx_next;
+    serial_link_tx_slot_t tx[SERIAL_LINK_WINDOW];
+
+    // Data frames received ahead of rx_next, held back until the gap is filled
+    uint8_t                rx_next;
+    serial_link_rx_slot_t rx[SERIAL_LINK_WINDOW];
+
+    // Frame being received
+    uint8_t frame[SERIAL_LINK_FRAME_SIZE];
+    uint8_t frame_length;
+    bool    frame_escape;
+    bool    frame_overflow;
+
+    serial_link_stats_t stats;
+};
+
+/**
+ * @brief Sets up a link. The initiator starts the reset handshake from serial_link_task().
+ */
+void serial_link_init(serial_link_t *link, bool initiator, serial_link_write_t write, serial_link_receive_t receive, serial_link_reset_t reset);
+
+/**
+ * @brief Feeds bytes read from the line to the link.
+ */
+void serial_link_receive_bytes(serial_link_t *link, const uint8_t *data, size_t length);
+
+/**
+ * @brief Sends retransmissions, acknowledgements and keepalives that are due, and notices a dead link.
+ */
+void serial_link_task(serial_link_t *link);
+
+/**
+ * @brief Queues data for the other side and sends it.
+ *
+ * @return false if the link is down, the window is full or the data doesn't fit in a frame.
+ */
+bool serial_link_send(serial_link_t *link, uint8_t id, uint8_t flags, const void *data, uint8_t length);
+
+/**
+ * @brief Whether another data frame can be sent right now.
+ */
+bool serial_link_can_send(const serial_link_t *link);
+
+/**
+ * @brief Whether every data frame sent has been acknowledged.
+ */
+bool serial_link_is_idle(const serial_link_t *link);
+
+static inline bool serial_link_is_connected(const serial_link_t *link) {
+    return link->connected;
+}
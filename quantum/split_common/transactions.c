@@ -85,6 +85,13 @@
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 #define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
 
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+static bool sync_frame_stage(int8_t trans_id, const void *source, size_t length);
+#    define transport_put(id, data, length) sync_frame_stage(id, data, length)
+#else
+#    define transport_put(id, data, length) transport_write(id, data, length)
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
@@ -159,7 +166,7 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
     bool okay = true;
     if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
-        okay &= transport_write(trans_id, source, length);
+        okay &= transport_put(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
         }
@@ -175,6 +182,7 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifndef SPLIT_TRANSPORT_SYNC_FRAME
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -189,6 +197,7 @@ static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_ro
     memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
     return okay;
 }
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
 
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
@@ -196,13 +205,168 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+// The slave matrix is returned as part of the sync frame exchange instead
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER()
+#else
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+////////////////////////////////////////////////////
+// Sync frame
+
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+
+#    define SYNC_FRAME_CHECKSUM_OFFSET offsetof(split_sync_frame_t, sequence)
+#    define SYNC_FRAME_HEADER_SIZE offsetof(split_sync_frame_t, data)
+
+#    define SYNC_FRAME_REPLY_SIZE (offsetof(split_shared_memory_t, sync_frame_ack) + sizeof(split_sync_frame_ack_t) - offsetof(split_shared_memory_t, smatrix))
+
+STATIC_ASSERT(sizeof(split_sync_frame_t) <= UINT8_MAX, "SPLIT_SYNC_FRAME_SIZE too large");
+STATIC_ASSERT(offsetof(split_shared_memory_t, sync_frame_ack) == offsetof(split_shared_memory_t, smatrix) + sizeof(split_slave_matrix_sync_t), "sync_frame_ack must directly follow smatrix");
+
+// Layout of the sync frame reply, as it sits in shared memory
+typedef struct {
+    split_slave_matrix_sync_t smatrix;
+    split_sync_frame_ack_t    ack;
+} split_sync_frame_reply_t;
+
+// Frame under construction on the master, kept and resent until the slave acknowledges applying it
+static split_sync_frame_t pending_frame          = {0};
+static bool               pending_frame_modified = false;
+
+static inline bool sync_frame_is_dirty(const split_sync_frame_t *frame, int8_t trans_id) {
+    return (frame->dirty[trans_id / 8] & (1 << (trans_id % 8))) != 0;
+}
+
+// Number of data bytes taken up by the dirty regions preceding the given transaction
+static uint16_t sync_frame_data_offset(const split_sync_frame_t *frame, int8_t trans_id) {
+    uint16_t offset = 0;
+    for (int8_t id = 0; id < trans_id; ++id) {
+        if (sync_frame_is_dirty(frame, id)) {
+            offset += split_transaction_table[id].initiator2target_buffer_size;
+        }
+    }
+    return offset;
+}
+
+static inline uint8_t sync_frame_checksum(const split_sync_frame_t *frame) {
+    return crc8((const uint8_t *)frame + SYNC_FRAME_CHECKSUM_OFFSET, SYNC_FRAME_HEADER_SIZE - SYNC_FRAME_CHECKSUM_OFFSET + frame->length);
+}
+
+static bool sync_frame_is_valid(const split_sync_frame_t *frame) {
+    if (frame->length > SPLIT_SYNC_FRAME_SIZE || sync_frame_data_offset(frame, NUM_TOTAL_TRANSACTIONS) != frame->length) {
+        return false;
+    }
+    return sync_frame_checksum(frame) == frame->checksum;
+}
+
+// Copies each region in the frame to its place in shared memory
+static void sync_frame_apply(const split_sync_frame_t *frame) {
+    uint8_t offset = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (sync_frame_is_dirty(frame, id)) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            memcpy(split_trans_initiator2target_buffer(trans), &frame->data[offset], trans->initiator2target_buffer_size);
+            offset += trans->initiator2target_buffer_size;
+        }
+    }
+}
+
+static bool sync_frame_stage(int8_t trans_id, const void *source, size_t length) {
+    split_transaction_desc_t *trans  = &split_transaction_table[trans_id];
+    uint8_t                   offset = sync_frame_data_offset(&pending_frame, trans_id);
+
+    bool                      added  = !sync_frame_is_dirty(&pending_frame, trans_id);
+
+    if (added) {
+        // Anything that needs a slave callback or doesn't fit in the frame is sent on its own
+        if (trans->slave_callback || length != trans->initiator2target_buffer_size || pending_frame.length + length > SPLIT_SYNC_FRAME_SIZE) {
+            return transport_write(trans_id, source, length);
+        }
+        memmove(&pending_frame.data[offset + length], &pending_frame.data[offset], pending_frame.length - offset);
+        pending_frame.dirty[trans_id / 8] |= (1 << (trans_id % 8));
+        pending_frame.length += length;
+    }
+
+    // Restaging a region that is still waiting to be acknowledged, unchanged, must not start a new frame, or the
+    // acknowledgement for the one in flight would never match
+    if (added || memcmp(&pending_frame.data[offset], source, length) != 0) {
+        memcpy(&pending_frame.data[offset], source, length);
+        pending_frame_modified = true;
+    }
+    return true;
+}
+
+static bool sync_frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t      last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+    split_sync_frame_reply_t reply;
+
+    // Retries resend the same sequence number, so the slave only applies a frame once. Zero is what a freshly started
+    // slave reports as applied, so it's never used.
+    if (pending_frame_modified) {
+        if (++pending_frame.sequence == 0) {
+            pending_frame.sequence = 1;
+        }
+        pending_frame.checksum = sync_frame_checksum(&pending_frame);
+        pending_frame_modified = false;
+    }
+
+    bool okay = transport_execute_transaction(CMD_SYNC_FRAME, &pending_frame, SYNC_FRAME_HEADER_SIZE + pending_frame.length, &reply, SYNC_FRAME_REPLY_SIZE);
+    if (okay) {
+        // The slave applies frames from its main loop, so a frame only counts as delivered once a later exchange
+        // reports it applied. Until then it is sent again with every exchange, along with anything staged since.
+        if (pending_frame.length && reply.ack.checksum == crc8(&reply.ack.sequence, sizeof(reply.ack.sequence)) && reply.ack.sequence == pending_frame.sequence) {
+            // Bring the local copy of shared memory in line with the slave
+            sync_frame_apply(&pending_frame);
+            memset(pending_frame.dirty, 0, sizeof(pending_frame.dirty));
+            pending_frame.length = 0;
+        }
+
+        okay = reply.smatrix.checksum == crc8(reply.smatrix.matrix, sizeof(reply.smatrix.matrix));
+        if (okay) {
+            memcpy(last_matrix, reply.smatrix.matrix, sizeof(last_matrix));
+        }
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void sync_frame_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t      last_sequence = 0;
+    split_sync_frame_t *frame         = &split_shmem->sync_frame;
+
+    if (frame->sequence != last_sequence && sync_frame_is_valid(frame)) {
+        last_sequence = frame->sequence;
+        sync_frame_apply(frame);
+    }
+
+    // Reported back with the next exchange, so the master stops resending the frame
+    split_shmem->sync_frame_ack.sequence = last_sequence;
+    split_shmem->sync_frame_ack.checksum = crc8(&last_sequence, sizeof(last_sequence));
+}
+
+// clang-format off
+#    define TRANSACTIONS_SYNC_FRAME_MASTER() TRANSACTION_HANDLER_MASTER(sync_frame)
+#    define TRANSACTIONS_SYNC_FRAME_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(sync_frame)
+#    define TRANSACTIONS_SYNC_FRAME_REGISTRATIONS \
+    [CMD_SYNC_FRAME] = {sizeof_member(split_shared_memory_t, sync_frame), offsetof(split_shared_memory_t, sync_frame), SYNC_FRAME_REPLY_SIZE, offsetof(split_shared_memory_t, smatrix), NULL},
+// clang-format on
+
+#else // SPLIT_TRANSPORT_SYNC_FRAME
+
+#    define TRANSACTIONS_SYNC_FRAME_MASTER()
+#    define TRANSACTIONS_SYNC_FRAME_SLAVE()
+#    define TRANSACTIONS_SYNC_FRAME_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -344,6 +508,8 @@ static bool layer_state_handlers_master(matrix_row_t master_matrix[], matrix_row
 }
 
 static void layer_state_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Mirrored without going through the setters, so that layer callbacks only run on the master
+    effective_layer_cache_update(layer_state | default_layer_state, split_shmem->layers.layer_state | split_shmem->layers.default_layer_state);
     layer_state         = split_shmem->layers.layer_state;
     default_layer_state = split_shmem->layers.default_layer_state;
 }
@@ -424,7 +590,7 @@ static bool mods_handlers_master(matrix_row_t master_matrix[], matrix_row_t slav
 
     bool okay = true;
     if (mods_need_sync) {
-        okay &= transport_write(PUT_MODS, &new_mods, sizeof(new_mods));
+        okay &= transport_put(PUT_MODS, &new_mods, sizeof(new_mods));
         if (okay) {
             last_update = timer_read32();
         }
@@ -923,6 +1089,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 
     // clang-format off
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
+    TRANSACTIONS_SYNC_FRAME_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
     TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
@@ -971,10 +1138,14 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_HAPTIC_MASTER();
     TRANSACTIONS_ACTIVITY_MASTER();
     TRANSACTIONS_DETECTED_OS_MASTER();
+    // Must come last, so that it carries everything staged by the handlers above
+    TRANSACTIONS_SYNC_FRAME_MASTER();
     return true;
 }
 
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Must come first, so that the handlers below see the latest state from the master
+    TRANSACTIONS_SYNC_FRAME_SLAVE();
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
@@ -22,6 +22,7 @@
 #include "transport.h"
 #include "transaction_id_define.h"
 #include "atomic_util.h"
+#include "synchronization_util.h"
 
 #ifdef USE_I2C
 
@@ -114,6 +115,8 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
 
     if (target2initiator_length > 0) {
         size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        // The protocol may write incoming data from its own thread, so don't read it mid update
+        split_shared_memory_lock_autounlock();
         memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
     }
 
@@ -57,6 +57,30 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+#    include "transaction_id_define.h"
+
+#    ifndef SPLIT_SYNC_FRAME_SIZE
+#        define SPLIT_SYNC_FRAME_SIZE 16
+#    endif // SPLIT_SYNC_FRAME_SIZE
+
+// Master to slave state changes coalesced into a single transaction. Only the
+// regions flagged in `dirty` are present in `data`, packed in transaction ID order.
+typedef struct _split_sync_frame_t {
+    uint8_t checksum;
+    uint8_t sequence;
+    uint8_t length;
+    uint8_t dirty[(NUM_TOTAL_TRANSACTIONS + 7) / 8];
+    uint8_t data[SPLIT_SYNC_FRAME_SIZE];
+} split_sync_frame_t;
+
+// Sequence number of the last frame the slave applied, read back along with the slave matrix
+typedef struct _split_sync_frame_ack_t {
+    uint8_t checksum;
+    uint8_t sequence;
+} split_sync_frame_ack_t;
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -154,6 +178,12 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_TRANSPORT_SYNC_FRAME
+    // Must directly follow the slave matrix, both are returned by the sync frame transaction
+    split_sync_frame_ack_t sync_frame_ack;
+    split_sync_frame_t     sync_frame;
+#endif // SPLIT_TRANSPORT_SYNC_FRAME
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -0,0 +1,180 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tickless_idle.h"
+#include "keyboard.h"
+#include "matrix.h"
+#include "debounce.h"
+#include "timer.h"
+
+#ifdef DEFERRED_EXEC_ENABLE
+#    include "deferred_exec.h"
+#endif
+#ifdef RGB_MATRIX_ENABLE
+#    include "rgb_matrix.h"
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+// Covers the animation and LVGL executor tables, which don't live in the basic deferred_exec wheel
+bool qp_internal_next_deadline(uint32_t *deadline);
+#endif
+#ifdef OLED_ENABLE
+#    include "oled_driver.h"
+#endif
+#ifdef MOUSEKEY_ENABLE
+#    include "mousekey.h"
+#endif
+#ifdef COMBO_ENABLE
+#    include "process_combo.h"
+#endif
+#ifdef TAP_DANCE_ENABLE
+#    include "process_tap_dance.h"
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+#    include "process_dynamic_macro.h"
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_WRITE_BEHIND)
+#    include "wear_leveling.h"
+#endif
+#ifdef SCAN_QUEUE_ENABLE
+#    include "scan_queue.h"
+#endif
+
+#ifdef TICKLESS_IDLE_MATRIX_INTERRUPT
+#    define TICKLESS_IDLE_LONGEST_SLEEP TICKLESS_IDLE_MAX_SLEEP
+#else
+#    define TICKLESS_IDLE_LONGEST_SLEEP TICKLESS_IDLE_POLL_INTERVAL
+#endif
+
+static bool                  keep_awake = false;
+static tickless_idle_stats_t stats;
+
+__attribute__((weak)) uint32_t tickless_idle_timeout_user(uint32_t timeout_ms) {
+    return timeout_ms;
+}
+
+__attribute__((weak)) uint32_t tickless_idle_timeout_kb(uint32_t timeout_ms) {
+    return tickless_idle_timeout_user(timeout_ms);
+}
+
+void tickless_idle_keep_awake(void) {
+    keep_awake = true;
+}
+
+const tickless_idle_stats_t *tickless_idle_get_stats(void) {
+    return &stats;
+}
+
+void tickless_idle_reset_stats(void) {
+    stats = (tickless_idle_stats_t){0};
+}
+
+static inline uint32_t clamp_to_deadline(uint32_t timeout, uint32_t now, uint32_t deadline) {
+    int32_t remaining = (int32_t)(deadline - now);
+    if (remaining <= 0) {
+        return 0;
+    }
+    return ((uint32_t)remaining < timeout) ? (uint32_t)remaining : timeout;
+}
+
+static bool any_key_held(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        if (matrix_get_row(row)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t tickless_idle_timeout(void) {
+    if (keep_awake) {
+        return 0;
+    }
+
+    uint32_t timeout = TICKLESS_IDLE_LONGEST_SLEEP;
+
+    // Tapping, one shot, leader etc. all run off ad-hoc timers -- tick every millisecond while the user is active
+    if (timeout > 1 && (any_key_held() || last_input_activity_elapsed() < TICKLESS_IDLE_ACTIVITY_TIMEOUT)) {
+        timeout = 1;
+    }
+
+    // A pin-change wakeup lands before the debounced matrix shows the press, so keep ticking until it settles
+    if (timeout > 1 && debounce_pending()) {
+        timeout = 1;
+    }
+
+    uint32_t now      = timer_read32();
+    uint32_t deadline = now;
+    (void)deadline;
+
+#ifdef DEFERRED_EXEC_ENABLE
+    if (deferred_exec_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef QUANTUM_PAINTER_ENABLE
+    if (qp_internal_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef OLED_ENABLE
+    if (oled_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef MOUSEKEY_ENABLE
+    if (mousekey_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef COMBO_ENABLE
+    if (combo_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef TAP_DANCE_ENABLE
+    if (tap_dance_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#ifdef DYNAMIC_MACRO_ENABLE
+    if (dynamic_macro_next_deadline(&deadline)) {
+        timeout = clamp_to_deadline(timeout, now, deadline);
+    }
+#endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_WRITE_BEHIND)
+    // Queued flash writes are serviced a slice per iteration
+    if (wear_leveling_pending()) {
+        timeout = 0;
+    }
+#endif
+#ifdef SCAN_QUEUE_ENABLE
+    // The scan thread may have queued events since matrix_task() drained the queue
+    if (!scan_queue_is_empty()) {
+        timeout = 0;
+    }
+#endif
+
+    if (timeout == 0) {
+        return 0;
+    }
+    return tickless_idle_timeout_kb(timeout);
+}
+
+void tickless_idle_task(void) {
+    uint32_t timeout = tickless_idle_timeout();
+    keep_awake       = false;
+
+    ++stats.iterations;
+    if (timeout == 0) {
+        return;
+    }
+
+    ++stats.sleeps;
+    stats.slept_ms += timeout;
+    tickless_idle_platform_sleep(timeout);
+}
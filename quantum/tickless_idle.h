@@ -0,0 +1,107 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \file
+ *
+ * \defgroup tickless_idle Tickless idle main loop
+ *
+ * Instead of spinning the main loop as fast as the MCU allows, each subsystem with time-based work reports when it
+ * next needs to run, and the main loop sleeps until the earliest of those deadlines. A matrix or encoder pin-change
+ * interrupt can cut the sleep short through `tickless_idle_wakeup_from_isr()`.
+ * \{
+ */
+
+#ifndef TICKLESS_IDLE_POLL_INTERVAL
+/**
+ * \brief Longest sleep, in milliseconds, when the matrix is polled rather than interrupt driven.
+ */
+#    define TICKLESS_IDLE_POLL_INTERVAL 1
+#endif
+
+#ifndef TICKLESS_IDLE_MAX_SLEEP
+/**
+ * \brief Longest sleep, in milliseconds, when `TICKLESS_IDLE_MATRIX_INTERRUPT` is defined.
+ */
+#    define TICKLESS_IDLE_MAX_SLEEP 100
+#endif
+
+#ifndef TICKLESS_IDLE_ACTIVITY_TIMEOUT
+/**
+ * \brief Time after the last input activity, in milliseconds, during which the loop keeps ticking every millisecond.
+ */
+#    define TICKLESS_IDLE_ACTIVITY_TIMEOUT 1000
+#endif
+
+/**
+ * \brief Sleep accounting, mainly useful for benchmarking.
+ */
+typedef struct {
+    uint32_t iterations; ///< Number of times `tickless_idle_task()` was invoked
+    uint32_t sleeps;     ///< Number of iterations that went to sleep
+    uint32_t slept_ms;   ///< Total requested sleep time
+} tickless_idle_stats_t;
+
+/**
+ * \brief Works out how long the main loop may sleep for, and sleeps. Invoked at the end of every main loop iteration.
+ */
+void tickless_idle_task(void);
+
+/**
+ * \brief Computes the number of milliseconds until the earliest subsystem deadline, capped to the configured maximum.
+ *
+ * \return The permitted sleep time, or 0 if the next iteration must run immediately
+ */
+uint32_t tickless_idle_timeout(void);
+
+/**
+ * \brief Prevents the next main loop iteration from sleeping.
+ *
+ * Intended for work that completes over several iterations without a timer of its own.
+ */
+void tickless_idle_keep_awake(void);
+
+/**
+ * \brief Cuts a sleep in progress short. Safe to call from a matrix or encoder pin-change interrupt handler.
+ */
+void tickless_idle_wakeup_from_isr(void);
+
+/**
+ * \brief Cuts a sleep in progress short. For other threads handing work to the main loop, such as the scan queue.
+ */
+void tickless_idle_wakeup(void);
+
+/**
+ * \brief Platform specific sleep, returns early on `tickless_idle_wakeup_from_isr()` or any other wakeup source.
+ */
+void tickless_idle_platform_sleep(uint32_t timeout_ms);
+
+/**
+ * \brief Retrieves the sleep accounting collected so far.
+ */
+const tickless_idle_stats_t *tickless_idle_get_stats(void);
+
+/**
+ * \brief Clears the sleep accounting.
+ */
+void tickless_idle_reset_stats(void);
+
+/**
+ * \brief Keyboard level hook to shorten the sleep time.
+ *
+ * \param timeout_ms The sleep time computed from the core subsystems
+ * \return The sleep time to use, which should not exceed `timeout_ms`
+ */
+uint32_t tickless_idle_timeout_kb(uint32_t timeout_ms);
+
+/**
+ * \brief Keymap level hook to shorten the sleep time, see `tickless_idle_timeout_kb()`.
+ */
+uint32_t tickless_idle_timeout_user(uint32_t timeout_ms);
+
+/** \} */
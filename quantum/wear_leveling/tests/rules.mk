@@ -64,3 +64,18 @@ wear_leveling_8byte_SRC := \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
 	$(wear_leveling_common_INC)
+
+wear_leveling_write_behind_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=1024 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=256 \
+	-DWEAR_LEVELING_WRITE_BEHIND \
+	-DWEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE=4 \
+	-DWEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK=8
+wear_leveling_write_behind_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_write_behind.cpp
+wear_leveling_write_behind_INC := \
+	$(wear_leveling_common_INC) \
+	tests/test_common
@@ -0,0 +1,222 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <algorithm>
+#include <numeric>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+#include "test_benchmark.hpp"
+#include "test_random.hpp"
+
+// Rough costs of flash operations, used to turn backing store invocations into blocking time
+using ERASE_COST_US = std::integral_constant<std::uint64_t, 20000>;
+using WRITE_COST_US = std::integral_constant<std::uint64_t, 50>;
+
+class WearLevelingWriteBehind : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+        verify_data.fill(0);
+    }
+
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> verify_data;
+
+    wear_leveling_status_t test_write(const uint32_t address, const void* value, size_t length) {
+        memcpy(&verify_data[address], value, length);
+        return wear_leveling_write(address, value, length);
+    }
+
+    void verify_readback() {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+        EXPECT_EQ(wear_leveling_read(0, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the data";
+        EXPECT_TRUE(readback == verify_data) << "Readback did not match the written data";
+    }
+};
+
+/**
+ * Blocking time of the backing store operations performed while invoking the supplied function.
+ */
+template <typename F>
+static std::uint64_t blocking_us(F&& func) {
+    auto&         inst   = MockBackingStore::Instance();
+    std::uint64_t erases = inst.erase_invoke_count();
+    std::uint64_t writes = inst.write_invoke_count();
+    func();
+    return (inst.erase_invoke_count() - erases) * ERASE_COST_US::value + (inst.write_invoke_count() - writes) * WRITE_COST_US::value;
+}
+
+/**
+ * This test verifies that writes only touch the cache, and reach the backing store once the queue is serviced.
+ */
+TEST_F(WearLevelingWriteBehind, WriteIsDeferred) {
+    auto& inst = MockBackingStore::Instance();
+
+    uint8_t test_value = 0x15;
+    EXPECT_EQ(test_write(0x82, &test_value, sizeof(test_value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Write should not have touched the backing store";
+    EXPECT_TRUE(wear_leveling_pending()) << "Write should have been queued";
+    verify_readback();
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+    EXPECT_FALSE(wear_leveling_pending()) << "Queue should be empty after a flush";
+    EXPECT_EQ(inst.log_begin()->address, WEAR_LEVELING_LOGICAL_SIZE + 8) << "Invalid first write address";
+    EXPECT_TRUE(inst.is_locked()) << "Backing store should be locked after a flush";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that re-writing a queued range does not grow the queue, and only the latest value is logged.
+ */
+TEST_F(WearLevelingWriteBehind, RepeatedWritesCoalesce) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t i = 1; i <= 10; ++i) {
+        EXPECT_EQ(test_write(0x80, &i, sizeof(i)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS) << "Flush returned incorrect status";
+
+    // A single 1-byte multibyte log entry is two backing store writes
+    EXPECT_EQ(inst.write_invoke_count(), 2) << "Only the final value should have been written";
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "No consolidation should have occurred";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that overflowing the queue falls back to a consolidation.
+ */
+TEST_F(WearLevelingWriteBehind, QueueOverflowConsolidates) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t i = 0; i <= WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE; ++i) {
+        uint8_t value = 0x30 + i;
+        EXPECT_EQ(test_write(0x80 + 0x10 * i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(inst.write_invoke_count(), 0) << "Writes should not have touched the backing store";
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 1) << "Exactly one consolidation should have occurred";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that each step either erases, or performs a bounded number of writes, even when the write log fills.
+ */
+TEST_F(WearLevelingWriteBehind, LogFullConsolidatesInSlices) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::uint64_t max_writes   = 0;
+    bool          consolidated = false;
+    for (uint32_t i = 0; i < 512 && !consolidated; ++i) {
+        uint8_t value[3] = {(uint8_t)i, (uint8_t)(i >> 8), 0xA5};
+        test_write(0x80 + (i % 32) * 3, value, sizeof(value));
+        while (wear_leveling_pending()) {
+            std::uint64_t          erases = inst.erase_invoke_count();
+            std::uint64_t          writes = inst.write_invoke_count();
+            wear_leveling_status_t status = wear_leveling_task();
+            EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Step returned incorrect status";
+            consolidated |= (status == WEAR_LEVELING_CONSOLIDATED);
+            if (inst.erase_invoke_count() != erases) {
+                EXPECT_EQ(inst.write_invoke_count(), writes) << "An erase step should not also write";
+            }
+            max_writes = std::max(max_writes, inst.write_invoke_count() - writes);
+        }
+    }
+
+    EXPECT_TRUE(consolidated) << "The write log should have filled up";
+    EXPECT_LE(max_writes, WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK + 6) << "Too many writes in a single step";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that writes made part way through a consolidation are persisted, whether or not that part of the
+ * cache has been written out yet.
+ */
+TEST_F(WearLevelingWriteBehind, WritesDuringConsolidationPersist) {
+    auto& inst = MockBackingStore::Instance();
+
+    for (uint8_t i = 0; i <= WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE; ++i) {
+        uint8_t value = 0x30 + i;
+        test_write(0x10 * i, &value, sizeof(value));
+    }
+
+    // Erase, then the first slice of the consolidated area
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Step returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 1) << "First step should have erased";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Step returned incorrect status";
+
+    uint8_t early = 0x77;
+    uint8_t late  = 0x88;
+    test_write(0x00, &early, sizeof(early));
+    test_write(WEAR_LEVELING_LOGICAL_SIZE - 1, &late, sizeof(late));
+    verify_readback();
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_CONSOLIDATED) << "Flush returned incorrect status";
+    EXPECT_EQ(inst.erase_invoke_count(), 1) << "No further consolidation should have occurred";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    verify_readback();
+}
+
+/**
+ * This test verifies that an erase discards anything still queued.
+ */
+TEST_F(WearLevelingWriteBehind, EraseDiscardsQueue) {
+    uint8_t test_value = 0x15;
+    test_write(0x82, &test_value, sizeof(test_value));
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase returned incorrect status";
+    EXPECT_FALSE(wear_leveling_pending()) << "Queue should be empty after an erase";
+
+    verify_data.fill(0);
+    verify_readback();
+}
+
+/**
+ * Measures the worst-case blocking time of a single call under a mixed write workload, comparing the write-behind queue
+ * serviced once per main loop iteration against writing through to the backing store inline.
+ */
+TEST_F(WearLevelingWriteBehind, BenchmarkWorstCaseBlocking) {
+    auto run_workload = [this](bool inline_writes) {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+
+        std::uint64_t worst   = 0;
+        TestRandom    random(12345);
+        for (int i = 0; i < 4000; ++i) {
+            uint8_t  value[4];
+            uint32_t length  = 1 + random.next(sizeof(value));
+            uint32_t address = random.next(WEAR_LEVELING_LOGICAL_SIZE - length);
+            for (auto& v : value) {
+                v = random.next() >> 8;
+            }
+            worst = std::max(worst, blocking_us([&] {
+                                 test_write(address, value, length);
+                                 if (inline_writes) {
+                                     wear_leveling_flush();
+                                 }
+                             }));
+            worst = std::max(worst, blocking_us([] { wear_leveling_task(); }));
+        }
+        EXPECT_NE(wear_leveling_flush(), WEAR_LEVELING_FAILED) << "Flush returned incorrect status";
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        verify_readback();
+        return worst;
+    };
+
+    std::uint64_t inline_worst       = run_workload(true);
+    std::uint64_t write_behind_worst = run_workload(false);
+
+    record_benchmark("inline_worst_us", inline_worst);
+    record_benchmark("write_behind_worst_us", write_behind_worst);
+
+    // Nothing is cheaper than a single erase, but the rest of the consolidation must be spread over later calls
+    EXPECT_LE(write_behind_worst, ERASE_COST_US::value);
+    EXPECT_LT(write_behind_worst, inline_worst);
+}
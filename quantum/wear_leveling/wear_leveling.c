@@ -62,6 +62,10 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_WRITE_BEHIND: Optional. Defers all backing store
+            accesses made on behalf of writes to wear_leveling_task(), see
+            below.
+
     General algorithm:
 
         During initialization:
@@ -77,6 +81,21 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        During writes, with WEAR_LEVELING_WRITE_BEHIND:
+            * The cache is updated with the new data.
+            * The modified range is queued, unless an already-queued range
+                covers it. If the queue is full, the queue is discarded and a
+                consolidation is requested instead, as that writes the entire
+                cache anyway.
+
+        During wear_leveling_task(), with WEAR_LEVELING_WRITE_BEHIND:
+            * If a consolidation is needed, the backing store is erased. The
+                cache is then written to the consolidated area a slice at a time
+                over subsequent invocations, hashing as it goes, with the
+                checksum written last.
+            * Otherwise, queued ranges are appended to the write log a slice at
+                a time, taking their values from the cache.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -165,6 +184,32 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     bool                                                           unlocked;
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+STATIC_ASSERT(WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE > 0 && WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE <= 255, "Write-behind queue size must be between 1 and 255");
+STATIC_ASSERT(WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK > 0, "Write-behind writes per task must be nonzero");
+
+/**
+ * A logical range waiting to be appended to the write log. Values are taken from the cache at the time of writing.
+ */
+typedef struct write_behind_entry_t {
+    uint32_t address;
+    uint32_t length;
+} write_behind_entry_t;
+
+/**
+ * Storage area for the write-behind queue.
+ */
+static struct {
+    write_behind_entry_t queue[(WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE)];
+    uint8_t              head;
+    uint8_t              count;
+    bool                 consolidation_requested;
+    bool                 consolidating;
+    uint32_t             consolidate_offset;
+    uint64_t             consolidate_hash;
+} write_behind;
+#endif // WEAR_LEVELING_WRITE_BEHIND
+
 /**
  * Locking helper: status
  */
@@ -249,6 +294,22 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     return status;
 }
 
+/**
+ * Writes the FNV1a_64 of the consolidated data directly after the consolidated area.
+ */
+static bool wear_leveling_write_checksum(uint64_t hash) {
+    write_log_entry_t entry;
+    entry.raw64 = hash;
+    wl_dprintf("Writing checksum\n");
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64);
+#endif
+}
+
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -266,27 +327,9 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
 
     if (status != WEAR_LEVELING_FAILED) {
         // Write out the FNV1a_64 result of the consolidated data
-        write_log_entry_t entry;
-        entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
-        wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_checksum(fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT))) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -331,7 +374,13 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
     if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+        // Left to wear_leveling_task(), which consolidates in slices
+        write_behind.consolidation_requested = true;
+        return WEAR_LEVELING_SUCCESS;
+#else
         return wear_leveling_consolidate_force();
+#endif
     }
 
     return WEAR_LEVELING_SUCCESS;
@@ -612,12 +661,196 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     return status;
 }
 
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+/**
+ * Worst-case write log usage of a single slice of a queued range. On 2-byte backing stores, a slice straddling the
+ * optimized encodings can be split across several small log entries, so leave room for two full-size entries.
+ */
+#    define WRITE_BEHIND_SLICE_LOG_SIZE (2 * sizeof(write_log_entry_t))
+
+/**
+ * Queues a modified logical range for appending to the write log.
+ */
+static void write_behind_enqueue(uint32_t address, size_t length) {
+    // A pending consolidation captures the whole cache before anything else is appended
+    if (write_behind.consolidation_requested && !write_behind.consolidating) {
+        return;
+    }
+
+    // Values are taken from the cache when appended, so a range already covered by the queue needs no entry of its own
+    for (uint8_t i = 0; i < write_behind.count; ++i) {
+        const write_behind_entry_t *entry = &write_behind.queue[(write_behind.head + i) % (WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE)];
+        if (address >= entry->address && address + length <= entry->address + entry->length) {
+            return;
+        }
+    }
+
+    // Out of space -- a consolidation writes the entire cache, which supersedes anything in the queue
+    if (write_behind.count == (WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE)) {
+        wl_dprintf("Write-behind queue full, requesting consolidation\n");
+        write_behind.count                   = 0;
+        write_behind.consolidation_requested = true;
+        return;
+    }
+
+    write_behind_entry_t *entry = &write_behind.queue[(write_behind.head + write_behind.count) % (WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE)];
+    entry->address              = address;
+    entry->length               = (uint32_t)length;
+    ++write_behind.count;
+}
+
+/**
+ * Erases the backing store and starts writing the cache to the consolidated area.
+ * Anything queued so far is captured by the consolidation, so the queue is discarded.
+ */
+static wear_leveling_status_t write_behind_begin_consolidation(void) {
+    wl_dprintf("Erasing backing store\n");
+    if (!backing_store_erase()) {
+        wl_dprintf("Failed to erase backing store\n");
+        return WEAR_LEVELING_FAILED;
+    }
+
+    write_behind.count                   = 0;
+    write_behind.consolidation_requested = false;
+    write_behind.consolidating           = true;
+    write_behind.consolidate_offset      = 0;
+    write_behind.consolidate_hash        = FNV1A_64_INIT;
+    wear_leveling.write_address          = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Writes the next slice of the cache to the consolidated area, or the checksum once all of it has been written.
+ * The checksum is accumulated from the data as written, so cache updates made part way through only affect the write log.
+ */
+static wear_leveling_status_t write_behind_continue_consolidation(void) {
+    const uint32_t offset    = write_behind.consolidate_offset;
+    const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+    if (remaining > 0) {
+        uint32_t length = (WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK) * (BACKING_STORE_WRITE_SIZE);
+        if (length > remaining) {
+            length = remaining;
+        }
+        if (!backing_store_write_bulk(offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / (BACKING_STORE_WRITE_SIZE))) {
+            wl_dprintf("Failed to write to backing store\n");
+            return WEAR_LEVELING_FAILED;
+        }
+        write_behind.consolidate_hash   = fnv_64a_buf(&wear_leveling.cache[offset], length, write_behind.consolidate_hash);
+        write_behind.consolidate_offset = offset + length;
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    if (!wear_leveling_write_checksum(write_behind.consolidate_hash)) {
+        return WEAR_LEVELING_FAILED;
+    }
+    write_behind.consolidating = false;
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Appends queued ranges to the write log, until roughly the configured number of backing store writes have been made.
+ */
+static wear_leveling_status_t write_behind_append(void) {
+    const uint32_t budget_end = wear_leveling.write_address + (WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK) * (BACKING_STORE_WRITE_SIZE);
+    while (write_behind.count > 0 && wear_leveling.write_address < budget_end) {
+        if ((WEAR_LEVELING_BACKING_SIZE) - wear_leveling.write_address < WRITE_BEHIND_SLICE_LOG_SIZE) {
+            write_behind.consolidation_requested = true;
+            break;
+        }
+
+        write_behind_entry_t  *entry  = &write_behind.queue[write_behind.head];
+        const uint32_t         length = entry->length > LOG_ENTRY_MULTIBYTE_MAX_BYTES ? LOG_ENTRY_MULTIBYTE_MAX_BYTES : entry->length;
+        wear_leveling_status_t status = wear_leveling_write_raw(entry->address, &wear_leveling.cache[entry->address], length);
+
+        entry->address += length;
+        entry->length -= length;
+        if (entry->length == 0 || status == WEAR_LEVELING_FAILED) {
+            write_behind.head = (write_behind.head + 1) % (WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE);
+            --write_behind.count;
+        }
+        if (status == WEAR_LEVELING_FAILED) {
+            return status;
+        }
+    }
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Services queued writes and consolidation in small steps.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    if (!wear_leveling_pending()) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // Consolidation runs to completion before any further appends, as the write log is full or has been erased
+    wear_leveling_status_t status;
+    if (write_behind.consolidating) {
+        status = write_behind_continue_consolidation();
+        if (status == WEAR_LEVELING_FAILED) {
+            // Start over with a fresh erase next time around
+            write_behind.consolidating           = false;
+            write_behind.consolidation_requested = true;
+        }
+    } else if (write_behind.consolidation_requested) {
+        status = write_behind_begin_consolidation();
+    } else {
+        status = write_behind_append();
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * Blocks until all queued writes have reached the backing store.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+    wear_leveling_status_t result = WEAR_LEVELING_SUCCESS;
+    while (wear_leveling_pending()) {
+        wear_leveling_status_t status = wear_leveling_task();
+        if (status == WEAR_LEVELING_FAILED) {
+            return status;
+        }
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            result = status;
+        }
+    }
+    return result;
+}
+
+/**
+ * Whether there are queued writes or an unfinished consolidation.
+ */
+bool wear_leveling_pending(void) {
+    return write_behind.count > 0 || write_behind.consolidation_requested || write_behind.consolidating;
+}
+#endif // WEAR_LEVELING_WRITE_BEHIND
+
 /**
  * Wear-leveling initialization
  */
 wear_leveling_status_t wear_leveling_init(void) {
     wl_dprintf("Init\n");
 
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+    // Don't lose anything still queued from before a re-init
+    wear_leveling_flush();
+    memset(&write_behind, 0, sizeof(write_behind));
+#endif
+
     // Reset the cache
     wear_leveling_clear_cache();
 
@@ -663,6 +896,9 @@ wear_leveling_status_t wear_leveling_erase(void) {
     // Perform the erase
     bool ret = backing_store_erase();
     wear_leveling_clear_cache();
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+    memset(&write_behind, 0, sizeof(write_behind));
+#endif
 
     // Lock the backing store if we acquired the lock successfully
     if (lock_status == STATUS_SUCCESS) {
@@ -692,6 +928,11 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
     memcpy(&wear_leveling.cache[address], value, length);
 
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+    // Reads are served from the cache, so the backing store can catch up later from wear_leveling_task()
+    write_behind_enqueue(address, length);
+    return WEAR_LEVELING_SUCCESS;
+#else
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -725,6 +966,7 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     return status;
+#endif // WEAR_LEVELING_WRITE_BEHIND
 }
 
 /**
@@ -1,9 +1,19 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+#    ifndef WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE
+#        define WEAR_LEVELING_WRITE_BEHIND_QUEUE_SIZE 16
+#    endif
+#    ifndef WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK
+#        define WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK 8
+#    endif
+#endif // WEAR_LEVELING_WRITE_BEHIND
+
 /**
  * @typedef Status returned from any wear-leveling API.
  */
@@ -36,6 +46,8 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * With WEAR_LEVELING_WRITE_BEHIND defined, only the cache is updated and the write is queued for wear_leveling_task().
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -52,3 +64,29 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+#ifdef WEAR_LEVELING_WRITE_BEHIND
+/**
+ * Services queued writes and consolidation in small steps. Invoked from the main loop.
+ *
+ * Each invocation performs either a single erase of the backing store, or up to roughly
+ * WEAR_LEVELING_WRITE_BEHIND_WRITES_PER_TASK backing store writes.
+ *
+ * @return Status of the step
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Blocks until all queued writes have reached the backing store.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
+/**
+ * Whether there are queued writes or an unfinished consolidation.
+ *
+ * @return true if wear_leveling_task() still has work to do
+ */
+bool wear_leveling_pending(void);
+#endif // WEAR_LEVELING_WRITE_BEHIND
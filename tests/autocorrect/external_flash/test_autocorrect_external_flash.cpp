@@ -0,0 +1,129 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "replay_typing.hpp"
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "flash.h"
+#include "process_autocorrect.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+/**
+ * SPI flash holding autocorrect_data.bin, as written by `qmk generate-autocorrect-data --external`, at
+ * AUTOCORRECT_FLASH_ADDRESS. Counts the read transactions that the dictionary cache couldn't avoid.
+ */
+static struct {
+    std::vector<uint8_t> memory;
+    uint32_t             reads;
+    uint32_t             bytes_read;
+} flash;
+
+extern "C" void flash_init(void) {}
+
+extern "C" flash_status_t flash_read_range(uint32_t addr, void *buf, size_t len) {
+    if (addr + len > flash.memory.size()) {
+        return FLASH_STATUS_BAD_ADDRESS;
+    }
+    memcpy(buf, flash.memory.data() + addr, len);
+    ++flash.reads;
+    flash.bytes_read += len;
+    return FLASH_STATUS_SUCCESS;
+}
+
+// clang-format off
+static const ReplayLayout autocorrect_layout = {
+    {KC_Q,   KC_W,    KC_E,   KC_R,    KC_T, KC_Y, KC_U, KC_I,    KC_O,   KC_P},
+    {KC_A,   KC_S,    KC_D,   KC_F,    KC_G, KC_H, KC_J, KC_K,    KC_L,   KC_QUOT},
+    {KC_Z,   KC_X,    KC_C,   KC_V,    KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH},
+    {KC_SPC, KC_BSPC, KC_ENT, KC_LCTL, KC_1, KC_2, KC_3, KC_4,    KC_5,   KC_6},
+};
+// clang-format on
+
+class AutocorrectExternalFlash : public TestFixture {
+   public:
+    void SetUp() override {
+        std::string   path = __FILE__;
+        std::ifstream file(path.substr(0, path.find_last_of('/') + 1) + "autocorrect_data.bin", std::ios::binary);
+        ASSERT_TRUE(file.good());
+        std::vector<uint8_t> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        flash.memory.assign(AUTOCORRECT_FLASH_ADDRESS, 0xFF);
+        flash.memory.insert(flash.memory.end(), image.begin(), image.end());
+        flash.reads      = 0;
+        flash.bytes_read = 0;
+
+        autocorrect_enable();
+        replay_add_layout(*this, autocorrect_layout);
+    }
+
+    // Types `text` a key at a time, and returns what the host ends up with
+    std::string type(const std::string &text) {
+        return ReplaySimulator(100).replay(replay_type_trace(autocorrect_layout, text)).output;
+    }
+};
+
+TEST_F(AutocorrectExternalFlash, CorrectsTypos) {
+    EXPECT_EQ(type("the fitler is ouput "), "the filter is output ");
+    EXPECT_EQ(type("see thier "), "see their ");
+    EXPECT_EQ(type("wealthier "), "wealthier ");
+    EXPECT_EQ(type("it's ture "), "it's true ");
+    EXPECT_EQ(type("aparrent apparant "), "apparent apparent ");
+    EXPECT_EQ(type("fitlx\ber "), "filter ");
+    EXPECT_EQ(type("prefixedwithlotsoflettersthenaccomodate "), "prefixedwithlotsoflettersthenaccommodate ");
+}
+
+TEST_F(AutocorrectExternalFlash, SharedEndings) {
+    // Both typos end in a subtrie that is stored once, and linked to from the end of their own chain of letters
+    EXPECT_EQ(type("refered widht "), "referred width ");
+}
+
+TEST_F(AutocorrectExternalFlash, MismatchedDictionaryIsIgnored) {
+    // A dictionary generated from a different file than autocorrect_data.h
+    flash.memory[AUTOCORRECT_FLASH_ADDRESS + 8] ^= 1;
+    autocorrect_enable();
+    EXPECT_EQ(type("the fitler "), "the fitler ");
+
+    flash.memory[AUTOCORRECT_FLASH_ADDRESS + 8] ^= 1;
+    autocorrect_enable();
+    EXPECT_EQ(type("the fitler "), "the filter ");
+}
+
+TEST_F(AutocorrectExternalFlash, MissingDictionaryIsIgnored) {
+    flash.memory.assign(flash.memory.size(), 0xFF);
+    autocorrect_enable();
+    EXPECT_EQ(type("the fitler "), "the fitler ");
+}
+
+// Runs a stream of words through the matcher, and counts the flash transactions that missed the cache
+TEST_F(AutocorrectExternalFlash, BenchmarkFlashReadsPerKeystroke) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    std::string text = replay_benchmark_text(20000);
+
+    keyrecord_t record   = {};
+    record.event.type    = KEY_EVENT;
+    record.event.pressed = true;
+    record.tap.count     = 1;
+    for (char c : text) {
+        process_autocorrect(replay_keycode_of(c), &record);
+    }
+
+    double reads = (double)flash.reads / text.size();
+    record_benchmark("flash_reads_per_1000_keystrokes", reads * 1000);
+    record_benchmark("flash_bytes_per_keystroke", (double)flash.bytes_read / text.size());
+
+    // Most keystrokes only touch nodes that are already cached
+    EXPECT_LT(reads, 1.5);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,79 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using ::testing::AnyNumber;
+using ::testing::InSequence;
+
+// autocorrect_data.h is the default dictionary as generated before AUTOCORRECT_DATA_VERSION, with a reversed trie
+class AutoCorrectLegacy : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+
+    template <typename... Ts>
+    void TapKeys(Ts... keys) {
+        for (KeymapKey key : {keys...}) {
+            tap_key(key);
+        }
+    }
+};
+
+TEST_F(AutoCorrectLegacy, fales_to_false_autocorrection) {
+    TestDriver driver;
+    auto       key_f = KeymapKey(0, 0, 0, KC_F);
+    auto       key_a = KeymapKey(0, 1, 0, KC_A);
+    auto       key_l = KeymapKey(0, 2, 0, KC_L);
+    auto       key_e = KeymapKey(0, 3, 0, KC_E);
+    auto       key_s = KeymapKey(0, 4, 0, KC_S);
+
+    set_keymap({key_f, key_a, key_l, key_e, key_s});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_F)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_A)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_L)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_BACKSPACE)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_S)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys(key_f, key_a, key_l, key_e, key_s);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(AutoCorrectLegacy, overture_should_not_autocorrect) {
+    TestDriver driver;
+    auto       key_t_code = KeymapKey(0, 0, 0, KC_T);
+    auto       key_r      = KeymapKey(0, 1, 0, KC_R);
+    auto       key_u      = KeymapKey(0, 2, 0, KC_U);
+    auto       key_e      = KeymapKey(0, 3, 0, KC_E);
+    auto       key_o      = KeymapKey(0, 4, 0, KC_O);
+    auto       key_v      = KeymapKey(0, 5, 0, KC_V);
+
+    set_keymap({key_t_code, key_r, key_u, key_e, key_o, key_v});
+
+    EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_O)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_V)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_R)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_T)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_U)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_R)));
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(KC_E)));
+    }
+
+    TapKeys(key_o, key_v, key_e, key_r, key_t_code, key_u, key_r, key_e);
+
+    VERIFY_AND_CLEAR(driver);
+}
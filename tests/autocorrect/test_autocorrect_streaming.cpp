@@ -0,0 +1,91 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include "replay_typing.hpp"
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_autocorrect.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+// clang-format off
+static const ReplayLayout autocorrect_layout = {
+    {KC_Q,   KC_W,    KC_E,   KC_R,    KC_T, KC_Y, KC_U, KC_I,    KC_O,   KC_P},
+    {KC_A,   KC_S,    KC_D,   KC_F,    KC_G, KC_H, KC_J, KC_K,    KC_L,   KC_QUOT},
+    {KC_Z,   KC_X,    KC_C,   KC_V,    KC_B, KC_N, KC_M, KC_COMM, KC_DOT, KC_SLSH},
+    {KC_SPC, KC_BSPC, KC_ENT, KC_LCTL, KC_1, KC_2, KC_3, KC_4,    KC_5,   KC_6},
+};
+// clang-format on
+
+class AutocorrectStreaming : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+        replay_add_layout(*this, autocorrect_layout);
+    }
+
+    // Types `text` a key at a time, and returns what the host ends up with
+    std::string type(const std::string &text) {
+        return ReplaySimulator(100).replay(replay_type_trace(autocorrect_layout, text)).output;
+    }
+};
+
+TEST_F(AutocorrectStreaming, CorrectsTyposWithinText) {
+    EXPECT_EQ(type("the fitler is ouput "), "the filter is output ");
+}
+
+TEST_F(AutocorrectStreaming, SharedEndings) {
+    // Both typos end in a subtrie that is stored once, and linked to from the end of their own chain of letters
+    EXPECT_EQ(type("refered widht "), "referred width ");
+}
+
+TEST_F(AutocorrectStreaming, WordBreaks) {
+    EXPECT_EQ(type("see thier "), "see their ");
+    EXPECT_EQ(type("wealthier "), "wealthier ");
+    EXPECT_EQ(type("it's ture "), "it's true ");
+    EXPECT_EQ(type("overture "), "overture ");
+}
+
+TEST_F(AutocorrectStreaming, OverlappingTypos) {
+    // "aparent" and "apparant" share a prefix that is still being matched when the other one ends
+    EXPECT_EQ(type("aparrent apparant "), "apparent apparent ");
+}
+
+TEST_F(AutocorrectStreaming, BackspaceResumesMatching) {
+    EXPECT_EQ(type("fitlx\ber "), "filter ");
+    EXPECT_EQ(type("fitle\b\bler "), "filter ");
+}
+
+TEST_F(AutocorrectStreaming, LongWordsRotateTheBuffer) {
+    EXPECT_EQ(type("prefixedwithlotsoflettersthenlenght "), "prefixedwithlotsoflettersthenlength ");
+}
+
+TEST_F(AutocorrectStreaming, CtrlStopsTheTypo) {
+    EXPECT_EQ(type("fitl^er "), "fitler ");
+}
+
+// Runs a stream of words through the matcher, with no typos in it so that only the lookups are timed
+TEST_F(AutocorrectStreaming, BenchmarkLookupsPerKeystroke) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    std::string text = replay_benchmark_text(20000);
+
+    keyrecord_t record   = {};
+    record.event.type    = KEY_EVENT;
+    record.event.pressed = true;
+    record.tap.count     = 1;
+
+    double ns = benchmark_ns([&] {
+        for (char c : text) {
+            process_autocorrect(replay_keycode_of(c), &record);
+        }
+    });
+    record_benchmark("keystroke_ns", ns / text.size());
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,147 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_benchmark.hpp"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "process_combo.h"
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+static uint32_t combos_visited = 0;
+
+// Counts the combos each path looks at, both of them go through combo_get() for every combo they visit
+extern "C" combo_t *combo_get(uint16_t combo_idx) {
+    ++combos_visited;
+    return combo_get_raw(combo_idx);
+}
+
+class ComboKeyIndex : public TestFixture, public testing::WithParamInterface<bool> {
+   public:
+    void SetUp() override {
+        combo_key_index_set_enabled(GetParam());
+    }
+
+    void TearDown() override {
+        combo_key_index_set_enabled(true);
+    }
+};
+
+TEST_P(ComboKeyIndex, FirstCombo) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    KeymapKey  key_b(0, 0, 2, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_F1));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_a, key_b});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(ComboKeyIndex, LaterComboSharingAKey) {
+    TestDriver driver;
+    KeymapKey  key_b(0, 0, 1, KC_B);
+    KeymapKey  key_c(0, 0, 2, KC_C);
+    set_keymap({key_b, key_c});
+
+    // (B, C) is the first pair not starting with A, i.e. combo 35
+    EXPECT_REPORT(driver, (KC_F12));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_b, key_c});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(ComboKeyIndex, SingleComboKeyFallsThrough) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 1, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(ComboKeyIndex, KeyOutsideAllCombos) {
+    TestDriver driver;
+    KeymapKey  key_space(0, 0, 1, KC_SPACE);
+    set_keymap({key_space});
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_space);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(ComboKeyIndex, OnlyVisitsCombosContainingTheKey) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_a});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(testing::AnyNumber());
+
+    keyrecord_t record   = {};
+    record.event.key     = {1, 0};
+    record.event.type    = KEY_EVENT;
+    record.event.pressed = true;
+
+    // Builds the index on first use
+    process_combo(KC_SPACE, &record);
+
+    combos_visited = 0;
+    process_combo(KC_SPACE, &record);
+    EXPECT_EQ(combos_visited, GetParam() ? 0 : combo_count());
+
+    // KC_A is paired with each of the 35 other keys, which make up the only combos it is part of
+    combos_visited = 0;
+    process_combo(KC_A, &record);
+    EXPECT_EQ(combos_visited, GetParam() ? 35 : combo_count());
+
+    // Drops the half pressed combos
+    combo_disable();
+    combo_enable();
+}
+
+INSTANTIATE_TEST_CASE_P(IndexedAndLinear, ComboKeyIndex, testing::Bool(), [](const testing::TestParamInfo<bool> &info) { return info.param ? "Indexed" : "Linear"; });
+
+class ComboKeyIndexBenchmark : public TestFixture {};
+
+static double time_events(uint32_t events) {
+    keyrecord_t record   = {};
+    record.event.key     = {1, 0};
+    record.event.type    = KEY_EVENT;
+    record.event.pressed = true;
+
+    double ns = benchmark_ns([&] {
+        for (uint32_t i = 0; i < events; ++i) {
+            record.event.pressed = !(i & 1);
+            process_combo((i & 2) ? KC_SPACE : KC_ENTER, &record);
+        }
+    });
+    return ns / events;
+}
+
+// Feeds the same stream of non-combo key events through both matching paths, with 300 combos defined
+TEST_F(ComboKeyIndexBenchmark, IndexedVersusLinear) {
+    const uint32_t events = 20000;
+
+    combo_key_index_set_enabled(false);
+    time_events(events / 10);
+    double linear_ns = time_events(events);
+
+    combo_key_index_set_enabled(true);
+    time_events(events / 10);
+    double indexed_ns = time_events(events);
+
+    record_benchmark("linear_ns", linear_ns);
+    record_benchmark("indexed_ns", indexed_ns);
+}
@@ -0,0 +1,22 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+#define KEY_INDEX_COMBO_COUNT 300
+#define KEY_INDEX_COMBO_KEYS 36
+
+// Every pair out of KC_A..KC_Z and KC_1..KC_0 in lexicographic order, up to KEY_INDEX_COMBO_COUNT combos
+static uint16_t combo_keys[KEY_INDEX_COMBO_COUNT][3];
+combo_t         key_combos[KEY_INDEX_COMBO_COUNT];
+
+__attribute__((constructor)) static void key_index_combos_init(void) {
+    uint16_t combo = 0;
+    for (uint8_t first = 0; first < KEY_INDEX_COMBO_KEYS && combo < KEY_INDEX_COMBO_COUNT; ++first) {
+        for (uint8_t second = first + 1; second < KEY_INDEX_COMBO_KEYS && combo < KEY_INDEX_COMBO_COUNT; ++second, ++combo) {
+            combo_keys[combo][0] = KC_A + first;
+            combo_keys[combo][1] = KC_A + second;
+            combo_keys[combo][2] = COMBO_END;
+            key_combos[combo]    = (combo_t)COMBO(combo_keys[combo], KC_F1 + (combo % 12));
+        }
+    }
+}
@@ -0,0 +1,273 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+struct fired_t {
+    uint32_t now;
+    uint32_t trigger_time;
+    intptr_t id;
+};
+
+static std::vector<fired_t> fired;
+static uint32_t             repeat_delay = 0;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    fired.push_back({timer_read32(), trigger_time, (intptr_t)cb_arg});
+    return repeat_delay;
+}
+
+class DeferredExec : public ::testing::Test {
+   protected:
+    std::vector<deferred_token> tokens;
+
+    void SetUp() override {
+        fired.clear();
+        repeat_delay = 0;
+        set_time(1000);
+        deferred_exec_task();
+    }
+
+    void TearDown() override {
+        for (auto token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        EXPECT_FALSE(deferred_exec_next_deadline(nullptr));
+    }
+
+    deferred_token schedule(uint32_t delay_ms, intptr_t id) {
+        deferred_token token = defer_exec(delay_ms, record_callback, (void *)id);
+        tokens.push_back(token);
+        return token;
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            advance_time(1);
+            deferred_exec_task();
+        }
+    }
+};
+
+TEST_F(DeferredExec, RejectsInvalidRequests) {
+    EXPECT_EQ(defer_exec(0, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(defer_exec(10, NULL, NULL), INVALID_DEFERRED_TOKEN);
+    EXPECT_FALSE(extend_deferred_exec(INVALID_DEFERRED_TOKEN, 10));
+    EXPECT_FALSE(cancel_deferred_exec(INVALID_DEFERRED_TOKEN));
+}
+
+TEST_F(DeferredExec, FiresAtTheRequestedTimeInOrder) {
+    const uint32_t delays[] = {5, 1, 31, 32, 33, 1023, 1024, 1500, 40000};
+    for (auto delay : delays) {
+        schedule(delay, delay);
+    }
+
+    run_for(40000);
+
+    ASSERT_EQ(fired.size(), sizeof(delays) / sizeof(delays[0]));
+    for (size_t i = 1; i < fired.size(); ++i) {
+        EXPECT_LT(fired[i - 1].id, fired[i].id);
+    }
+    for (auto &f : fired) {
+        EXPECT_EQ(f.now, 1000 + (uint32_t)f.id);
+        EXPECT_EQ(f.trigger_time, 1000 + (uint32_t)f.id);
+    }
+}
+
+TEST_F(DeferredExec, FiresOnCascadeBoundaries) {
+    // Triggers landing exactly where an upper level slot's window starts get cascaded on the tick they're due
+    const uint32_t delays[] = {56, 1048, 32768 - 1000};
+    for (auto delay : delays) {
+        schedule(delay, delay);
+    }
+
+    run_for(32768);
+
+    ASSERT_EQ(fired.size(), sizeof(delays) / sizeof(delays[0]));
+    for (auto &f : fired) {
+        EXPECT_EQ(f.now, f.trigger_time);
+    }
+}
+
+TEST_F(DeferredExec, CatchesUpAfterAStall) {
+    schedule(10, 1);
+    schedule(700, 2);
+
+    advance_time(2000);
+    deferred_exec_task();
+
+    ASSERT_EQ(fired.size(), 2);
+    EXPECT_EQ(fired[0].id, 1);
+    EXPECT_EQ(fired[1].id, 2);
+}
+
+TEST_F(DeferredExec, FastForwardsThroughALongSuspend) {
+    const uint32_t suspend = 8UL * 60 * 60 * 1000;
+    schedule(5, 1);
+    schedule(suspend + 20, 2);
+    schedule(suspend - 5, 3);
+
+    advance_time(suspend);
+    deferred_exec_task();
+
+    ASSERT_EQ(fired.size(), 2);
+    EXPECT_EQ(fired[0].id, 1);
+    EXPECT_EQ(fired[1].id, 3);
+
+    // Executors still pending fire on time from the new position
+    run_for(19);
+    EXPECT_EQ(fired.size(), 2);
+    run_for(1);
+    ASSERT_EQ(fired.size(), 3);
+    EXPECT_EQ(fired[2].now, fired[2].trigger_time);
+}
+
+TEST_F(DeferredExec, FastForwardKeepsOverdueExecutorsInOrder) {
+    const uint32_t suspend = 60UL * 1000;
+    schedule(suspend - 10, 1);
+    schedule(300, 2);
+    schedule(suspend - 200, 3);
+    schedule(40, 4);
+
+    advance_time(suspend);
+    deferred_exec_task();
+
+    ASSERT_EQ(fired.size(), 4);
+    EXPECT_EQ(fired[0].id, 4);
+    EXPECT_EQ(fired[1].id, 2);
+    EXPECT_EQ(fired[2].id, 3);
+    EXPECT_EQ(fired[3].id, 1);
+}
+
+TEST_F(DeferredExec, CancelPreventsExecution) {
+    deferred_token token = schedule(50, 1);
+    schedule(60, 2);
+
+    EXPECT_TRUE(cancel_deferred_exec(token));
+    EXPECT_FALSE(cancel_deferred_exec(token));
+    EXPECT_FALSE(extend_deferred_exec(token, 10));
+
+    run_for(100);
+
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0].id, 2);
+}
+
+TEST_F(DeferredExec, StaleTokenDoesNotCancelReusedSlot) {
+    deferred_token first = schedule(50, 1);
+    EXPECT_TRUE(cancel_deferred_exec(first));
+
+    deferred_token second = schedule(50, 2);
+    EXPECT_NE(first, second);
+    EXPECT_FALSE(cancel_deferred_exec(first));
+
+    run_for(50);
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0].id, 2);
+}
+
+TEST_F(DeferredExec, StaleTokenSurvivesSlotReuses) {
+    deferred_token stale = schedule(50, 1);
+    EXPECT_TRUE(cancel_deferred_exec(stale));
+
+    // The free list hands the same slot straight back, so every one of these reuses it until the generations wrap
+    for (intptr_t i = 0; i < (255 / MAX_DEFERRED_EXECUTORS) - 1; ++i) {
+        deferred_token token = schedule(50, i);
+        EXPECT_NE(token, stale);
+        EXPECT_FALSE(cancel_deferred_exec(stale));
+        EXPECT_TRUE(cancel_deferred_exec(token));
+    }
+}
+
+TEST_F(DeferredExec, ExtendMovesTheDeadline) {
+    deferred_token token = schedule(20, 1);
+
+    run_for(10);
+    EXPECT_TRUE(extend_deferred_exec(token, 100));
+
+    run_for(99);
+    EXPECT_TRUE(fired.empty());
+
+    run_for(1);
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0].now, 1110);
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToPreviousTrigger) {
+    repeat_delay         = 25;
+    deferred_token token = schedule(10, 1);
+
+    run_for(100);
+    cancel_deferred_exec(token);
+
+    ASSERT_EQ(fired.size(), 4);
+    EXPECT_EQ(fired[0].trigger_time, 1010);
+    EXPECT_EQ(fired[1].trigger_time, 1035);
+    EXPECT_EQ(fired[2].trigger_time, 1060);
+    EXPECT_EQ(fired[3].trigger_time, 1085);
+}
+
+TEST_F(DeferredExec, NextDeadlineReportsEarliestExecutor) {
+    uint32_t deadline = 0;
+    EXPECT_FALSE(deferred_exec_next_deadline(&deadline));
+
+    schedule(5000, 1);
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, 6000);
+
+    // Upper level executor that is now closer than a freshly scheduled lower level one
+    run_for(4990);
+    schedule(20, 2);
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, 6000);
+
+    schedule(3, 3);
+    EXPECT_TRUE(deferred_exec_next_deadline(&deadline));
+    EXPECT_EQ(deadline, 5993);
+
+    run_for(100);
+    EXPECT_EQ(fired.size(), 3);
+    EXPECT_FALSE(deferred_exec_next_deadline(&deadline));
+}
+
+TEST_F(DeferredExec, ScalesToConfiguredCapacity) {
+    for (intptr_t i = 0; i < MAX_DEFERRED_EXECUTORS; ++i) {
+        EXPECT_NE(schedule(1 + (i * 37) % 3000, i), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(10, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+
+    run_for(3000);
+    EXPECT_EQ(fired.size(), MAX_DEFERRED_EXECUTORS);
+    for (size_t i = 1; i < fired.size(); ++i) {
+        EXPECT_LE(fired[i - 1].now, fired[i].now);
+    }
+}
+
+static deferred_token chained_token = INVALID_DEFERRED_TOKEN;
+
+static uint32_t self_cancelling_callback(uint32_t trigger_time, void *cb_arg) {
+    cancel_deferred_exec(chained_token);
+    chained_token = defer_exec(5, record_callback, cb_arg);
+    return 10;
+}
+
+TEST_F(DeferredExec, CallbackCanCancelAndRequeueItself) {
+    chained_token = defer_exec(10, self_cancelling_callback, (void *)7);
+
+    run_for(10);
+    EXPECT_TRUE(fired.empty());
+
+    run_for(5);
+    ASSERT_EQ(fired.size(), 1);
+    EXPECT_EQ(fired[0].id, 7);
+    EXPECT_EQ(fired[0].now, 1015);
+}
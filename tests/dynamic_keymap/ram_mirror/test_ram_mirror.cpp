@@ -0,0 +1,76 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "keymap_introspection.h"
+}
+
+static uint8_t *keycode_eeprom_address(uint8_t layer, uint8_t row, uint8_t column) {
+    return (uint8_t *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2));
+}
+
+class DynamicKeymapRamMirror : public TestFixture {};
+
+TEST_F(DynamicKeymapRamMirror, SetKeycodeWritesThrough) {
+    dynamic_keymap_set_keycode(1, 2, 3, KC_F13);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_F13);
+
+    uint8_t *address = keycode_eeprom_address(1, 2, 3);
+    EXPECT_EQ(eeprom_read_byte(address), KC_F13 >> 8);
+    EXPECT_EQ(eeprom_read_byte(address + 1), KC_F13 & 0xFF);
+
+    // Reloading the mirror gives back what was persisted
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), KC_F13);
+}
+
+TEST_F(DynamicKeymapRamMirror, LookupsDoNotReadEeprom) {
+    dynamic_keymap_set_keycode(0, 1, 1, KC_A);
+
+    // Changes behind the mirror's back are not seen until it is reloaded
+    uint8_t *address = keycode_eeprom_address(0, 1, 1);
+    eeprom_update_byte(address, KC_B >> 8);
+    eeprom_update_byte(address + 1, KC_B & 0xFF);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_A);
+
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_B);
+}
+
+TEST_F(DynamicKeymapRamMirror, BufferUpdatesStayCoherent) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_NO);
+    dynamic_keymap_set_keycode(0, 0, 1, KC_NO);
+    dynamic_keymap_set_keycode(0, 0, 2, KC_NO);
+
+    // Starts and ends half way through a keycode
+    uint8_t data[] = {KC_C & 0xFF, QK_LCTL >> 8, KC_D & 0xFF, KC_E >> 8};
+    dynamic_keymap_set_buffer(1, sizeof(data), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_C);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), LCTL(KC_D));
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 2), KC_E & 0xFF00);
+
+    uint8_t readback[sizeof(data)] = {0};
+    dynamic_keymap_get_buffer(1, sizeof(readback), readback);
+    EXPECT_EQ(memcmp(readback, data, sizeof(data)), 0);
+
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), LCTL(KC_D));
+
+    // Reads past the end of the keymap are zero filled
+    uint16_t keymap_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+    uint8_t  tail[4];
+    memset(tail, 0xFF, sizeof(tail));
+    dynamic_keymap_get_buffer(keymap_size - 2, sizeof(tail), tail);
+    EXPECT_EQ(tail[2], 0);
+    EXPECT_EQ(tail[3], 0);
+}
+
+TEST_F(DynamicKeymapRamMirror, ResetRestoresMirror) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_F14);
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), keycode_at_keymap_location_raw(0, 0, 0));
+}
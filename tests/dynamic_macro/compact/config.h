@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// 32 bytes, which held 4 uncompressed events
+#define DYNAMIC_MACRO_SIZE 4
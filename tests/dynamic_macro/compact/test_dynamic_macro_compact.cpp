@@ -0,0 +1,176 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_dynamic_macro.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// Captures reports as the keys they hold, dropping repeated reports
+class DynamicMacroCompact : public TestFixture {
+   public:
+    void SetUp() override {
+        dynamic_macro_init();
+    }
+
+    void capture(TestDriver &driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([this](report_keyboard_t &report) {
+            std::string keys;
+            for (uint8_t key : report.keys) {
+                if (key) {
+                    keys += 'A' + (key - KC_A);
+                }
+            }
+            if (reports.empty() || reports.back() != keys) {
+                reports.push_back(keys);
+            }
+        });
+    }
+
+    std::vector<std::string> reports;
+};
+
+TEST_F(DynamicMacroCompact, RecordAndPlay) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+    capture(driver);
+
+    tap_key(key_rec);
+    tap_key(key_a);
+    tap_key(key_b);
+    tap_key(key_stop);
+    EXPECT_EQ(reports, (std::vector<std::string>{"A", "", "B", ""}));
+
+    reports.clear();
+    tap_key(key_play);
+    // One event is sent per pass through the main loop
+    ASSERT_TRUE(dynamic_macro_is_playing());
+    EXPECT_EQ(reports, (std::vector<std::string>{"A"}));
+    idle_for(10);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    EXPECT_EQ(reports, (std::vector<std::string>{"A", "", "B", ""}));
+}
+
+TEST_F(DynamicMacroCompact, KeysAreProcessedDuringPlayback) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_c(0, 5, 0, KC_C);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_c});
+    capture(driver);
+
+    tap_key(key_rec);
+    for (int i = 0; i < 4; i++) {
+        tap_key(key_a);
+    }
+    tap_key(key_stop);
+
+    reports.clear();
+    tap_key(key_play);
+    ASSERT_TRUE(dynamic_macro_is_playing());
+    key_c.press();
+    run_one_scan_loop();
+    key_c.release();
+    run_one_scan_loop();
+    ASSERT_TRUE(dynamic_macro_is_playing());
+    idle_for(20);
+
+    // C was typed while the macro was still playing
+    auto c = std::find_if(reports.begin(), reports.end(), [](const std::string &keys) { return keys.find('C') != std::string::npos; });
+    ASSERT_NE(c, reports.end());
+    EXPECT_NE(std::find(c, reports.end(), "A"), reports.end());
+}
+
+TEST_F(DynamicMacroCompact, FitsSeveralTimesMoreEvents) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+    capture(driver);
+
+    // 16 events in a buffer that used to hold DYNAMIC_MACRO_SIZE, the 17th and 18th are dropped
+    tap_key(key_rec);
+    for (int i = 0; i < 4; i++) {
+        tap_key(key_a);
+        tap_key(key_b);
+    }
+    tap_key(key_a);
+    tap_key(key_stop);
+
+    reports.clear();
+    tap_key(key_play);
+    idle_for(40);
+    EXPECT_EQ(reports, (std::vector<std::string>{"A", "", "B", "", "A", "", "B", "", "A", "", "B", "", "A", "", "B", ""}));
+}
+
+TEST_F(DynamicMacroCompact, TrailingKeyDownsAreTrimmed) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+    capture(driver);
+
+    tap_key(key_rec);
+    tap_key(key_a);
+    key_b.press();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    key_b.release();
+    run_one_scan_loop();
+
+    reports.clear();
+    tap_key(key_play);
+    idle_for(10);
+    EXPECT_EQ(reports, (std::vector<std::string>{"A", ""}));
+}
+
+TEST_F(DynamicMacroCompact, NestedMacro) {
+    TestDriver driver;
+    KeymapKey  key_rec1(0, 0, 0, DM_REC1);
+    KeymapKey  key_rec2(0, 0, 1, DM_REC2);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play1(0, 2, 0, DM_PLY1);
+    KeymapKey  key_play2(0, 2, 1, DM_PLY2);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    KeymapKey  key_c(0, 5, 0, KC_C);
+    set_keymap({key_rec1, key_rec2, key_stop, key_play1, key_play2, key_a, key_b, key_c});
+    capture(driver);
+
+    tap_key(key_rec2);
+    tap_key(key_b);
+    tap_key(key_stop);
+
+    tap_key(key_rec1);
+    tap_key(key_a);
+    tap_key(key_play2);
+    tap_key(key_c);
+    tap_key(key_stop);
+
+    reports.clear();
+    tap_key(key_play1);
+    idle_for(20);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    EXPECT_EQ(reports, (std::vector<std::string>{"A", "", "B", "", "C", ""}));
+}
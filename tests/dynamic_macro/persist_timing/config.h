@@ -0,0 +1,11 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_MACRO_PERSIST
+#define DYNAMIC_MACRO_PRESERVE_TIMING
+#define DYNAMIC_MACRO_SIZE 16
+#define TRANSIENT_EEPROM_SIZE 512
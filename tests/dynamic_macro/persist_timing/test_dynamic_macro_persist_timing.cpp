@@ -0,0 +1,175 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_dynamic_macro.h"
+#include "nvm_dynamic_macro.h"
+#include "timer.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// Recorded timing, with keys stored as a matrix index
+static const uint8_t format = 0x13;
+
+// Captures reports as the keys they hold along with the time they were sent
+class DynamicMacroPersistTiming : public TestFixture {
+   public:
+    void SetUp() override {
+        nvm_dynamic_macro_erase();
+        dynamic_macro_init();
+    }
+
+    void capture(TestDriver &driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([this](report_keyboard_t &report) {
+            std::string keys;
+            for (uint8_t key : report.keys) {
+                if (key) {
+                    keys += 'A' + (key - KC_A);
+                }
+            }
+            if (reports.empty() || reports.back().first != keys) {
+                reports.push_back({keys, timer_read32()});
+            }
+        });
+    }
+
+    // The time between each report and the first one
+    std::vector<std::pair<std::string, uint32_t>> relative_reports() {
+        std::vector<std::pair<std::string, uint32_t>> relative;
+        for (auto &report : reports) {
+            relative.push_back({report.first, report.second - reports.front().second});
+        }
+        return relative;
+    }
+
+    void record_macro(KeymapKey &key_rec, KeymapKey &key_stop, KeymapKey &key_a, KeymapKey &key_b) {
+        tap_key(key_rec);
+        key_a.press();
+        run_one_scan_loop();
+        idle_for(29);
+        key_a.release();
+        run_one_scan_loop();
+        idle_for(199);
+        key_b.press();
+        run_one_scan_loop();
+        key_a.press();
+        run_one_scan_loop();
+        idle_for(299);
+        key_b.release();
+        run_one_scan_loop();
+        idle_for(14);
+        key_a.release();
+        run_one_scan_loop();
+        tap_key(key_stop);
+    }
+
+    std::vector<std::pair<std::string, uint32_t>> reports;
+};
+
+static const std::vector<std::pair<std::string, uint32_t>> expected = {
+    {"A", 0}, {"", 30}, {"B", 230}, {"BA", 231}, {"A", 531}, {"", 546},
+};
+
+TEST_F(DynamicMacroPersistTiming, PlaybackKeepsRecordedTiming) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+    capture(driver);
+
+    record_macro(key_rec, key_stop, key_a, key_b);
+    EXPECT_EQ(relative_reports(), expected);
+
+    reports.clear();
+    tap_key(key_play);
+    idle_for(600);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    EXPECT_EQ(relative_reports(), expected);
+}
+
+TEST_F(DynamicMacroPersistTiming, MacrosSurviveRestart) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC2);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY2);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+    capture(driver);
+
+    record_macro(key_rec, key_stop, key_a, key_b);
+
+    // The previous contents are invalidated straight away, and written a chunk at a time
+    uint16_t length1, length2;
+    EXPECT_FALSE(nvm_dynamic_macro_read_header(format, &length1, &length2));
+    idle_for(10);
+    ASSERT_TRUE(nvm_dynamic_macro_read_header(format, &length1, &length2));
+    EXPECT_EQ(length1, 0);
+    EXPECT_GT(length2, 0);
+
+    dynamic_macro_init();
+    reports.clear();
+    tap_key(key_play);
+    idle_for(600);
+    EXPECT_EQ(relative_reports(), expected);
+
+    // Nothing is played once the stored macros are gone
+    nvm_dynamic_macro_erase();
+    dynamic_macro_init();
+    reports.clear();
+    tap_key(key_play);
+    idle_for(600);
+    EXPECT_TRUE(reports.empty());
+}
+
+TEST_F(DynamicMacroPersistTiming, NothingIsRecordedOnceFull) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    KeymapKey  key_c(0, 5, 0, KC_C);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b, key_c});
+    capture(driver);
+
+    // 20 taps take 119 of the 128 bytes, every event after the first one carrying a one byte delay
+    tap_key(key_rec);
+    for (int i = 0; i < 20; i++) {
+        tap_key(key_a);
+    }
+
+    // The release of C needs a two byte delay and doesn't fit, the quicker release of B would
+    key_b.press();
+    run_one_scan_loop();
+    key_c.press();
+    run_one_scan_loop();
+    idle_for(299);
+    key_c.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    tap_key(key_stop);
+
+    // Recording stopped at C, so the macro is trimmed back to the last tap of A
+    reports.clear();
+    tap_key(key_play);
+    idle_for(100);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+    ASSERT_EQ(reports.size(), 40u);
+    for (auto &report : reports) {
+        EXPECT_TRUE(report.first == "A" || report.first == "") << report.first;
+    }
+}
@@ -0,0 +1,16 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_MACRO_PERSIST
+#define DYNAMIC_MACRO_PRESERVE_TIMING
+#define DYNAMIC_MACRO_SIZE 16
+#define DYNAMIC_MACRO_SAVE_CHUNK_SIZE 4
+#define TRANSIENT_EEPROM_SIZE 512
+
+#define TICKLESS_IDLE_MATRIX_INTERRUPT
+#define TICKLESS_IDLE_MAX_SLEEP 100
+#define TICKLESS_IDLE_ACTIVITY_TIMEOUT 20
@@ -0,0 +1,6 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DYNAMIC_MACRO_ENABLE = yes
+EEPROM_DRIVER = transient
+TICKLESS_IDLE_ENABLE = yes
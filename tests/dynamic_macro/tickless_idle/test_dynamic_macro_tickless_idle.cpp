@@ -0,0 +1,124 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_dynamic_macro.h"
+#include "nvm_dynamic_macro.h"
+#include "timer.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// Recorded timing, with keys stored as a matrix index
+static const uint8_t format = 0x13;
+
+class DynamicMacroTicklessIdle : public TestFixture {
+   public:
+    void SetUp() override {
+        nvm_dynamic_macro_erase();
+        dynamic_macro_init();
+        tickless_idle_reset_stats();
+    }
+
+    void capture(TestDriver &driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([this](report_keyboard_t &report) {
+            std::string keys;
+            for (uint8_t key : report.keys) {
+                if (key) {
+                    keys += 'A' + (key - KC_A);
+                }
+            }
+            if (reports.empty() || reports.back().first != keys) {
+                reports.push_back({keys, timer_read32()});
+            }
+        });
+    }
+
+    // Taps A, then B 60ms after A is released
+    void record_macro(KeymapKey &key_rec, KeymapKey &key_stop, KeymapKey &key_a, KeymapKey &key_b) {
+        tap_key(key_rec);
+        key_a.press();
+        run_one_scan_loop();
+        idle_for(29);
+        key_a.release();
+        run_one_scan_loop();
+        idle_for(59);
+        key_b.press();
+        run_one_scan_loop();
+        idle_for(19);
+        key_b.release();
+        run_one_scan_loop();
+        tap_key(key_stop);
+    }
+
+    // Runs the main loop the way the firmware does with tickless idle, sleeping for as long as it reports
+    void run_until_idle() {
+        do {
+            keyboard_task();
+            housekeeping_task();
+            tickless_idle_task();
+        } while (dynamic_macro_is_playing());
+    }
+
+    std::vector<std::pair<std::string, uint32_t>> reports;
+};
+
+TEST_F(DynamicMacroTicklessIdle, SleepsUntilTheNextEventOfAPlayback) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_play(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_play, key_a, key_b});
+    capture(driver);
+
+    record_macro(key_rec, key_stop, key_a, key_b);
+    idle_for(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+
+    reports.clear();
+    tap_key(key_play);
+    tickless_idle_reset_stats();
+    run_until_idle();
+
+    // The gaps between events are shorter than the longest sleep, and still kept exactly
+    ASSERT_EQ(reports.size(), 4u);
+    EXPECT_EQ(reports[1].second - reports[0].second, 30u);
+    EXPECT_EQ(reports[2].second - reports[0].second, 90u);
+    EXPECT_EQ(reports[3].second - reports[0].second, 110u);
+    EXPECT_GT(tickless_idle_get_stats()->sleeps, 0u);
+    EXPECT_LT(tickless_idle_get_stats()->iterations, 60u);
+}
+
+TEST_F(DynamicMacroTicklessIdle, SaveIsNotHeldBackBySleep) {
+    TestDriver driver;
+    KeymapKey  key_rec(0, 0, 0, DM_REC2);
+    KeymapKey  key_stop(0, 1, 0, DM_RSTP);
+    KeymapKey  key_a(0, 3, 0, KC_A);
+    KeymapKey  key_b(0, 4, 0, KC_B);
+    set_keymap({key_rec, key_stop, key_a, key_b});
+    capture(driver);
+
+    record_macro(key_rec, key_stop, key_a, key_b);
+
+    // Past the activity timeout, only the save keeps the loop awake until it has been written
+    set_activity_timestamps(0, 0, 0);
+    uint16_t length1, length2;
+    uint8_t  iterations = 0;
+    while (tickless_idle_timeout() == 0) {
+        EXPECT_FALSE(nvm_dynamic_macro_read_header(format, &length1, &length2));
+        keyboard_task();
+        ASSERT_LT(++iterations, 32);
+    }
+    EXPECT_GT(iterations, 1);
+    EXPECT_TRUE(nvm_dynamic_macro_read_header(format, &length1, &length2));
+    EXPECT_EQ(tickless_idle_timeout(), TICKLESS_IDLE_MAX_SLEEP);
+}
@@ -0,0 +1,129 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class EffectiveLayerCache : public TestFixture {};
+
+TEST_F(EffectiveLayerCache, ResolvesThroughTransparentKeys) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+    KeymapKey  key_b = KeymapKey(0, 1, 0, KC_B);
+
+    set_keymap({key_a, key_b, KeymapKey(1, 0, 0, KC_C), KeymapKey(1, 1, 0, KC_TRNS), KeymapKey(2, 0, 0, KC_TRNS), KeymapKey(2, 1, 0, KC_TRNS)});
+
+    layer_on(1);
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b.position), 0);
+
+    layer_clear();
+}
+
+TEST_F(EffectiveLayerCache, EntriesAboveTheChangedLayersSurvive) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B), KeymapKey(2, 0, 0, KC_C)});
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    // Layer 1 is below the winning layer, so the lookup cannot change
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 2);
+
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    layer_clear();
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+}
+
+TEST_F(EffectiveLayerCache, FollowsDefaultLayerChanges) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    default_layer_set(1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    default_layer_set(1 << 0);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+}
+
+TEST_F(EffectiveLayerCache, FollowsEepromReset) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+
+    default_layer_set(1 << 1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    // Resets the default layer to 0 without going through default_layer_set()
+    eeconfig_init_quantum();
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+}
+
+TEST_F(EffectiveLayerCache, InvalidatesOnKeymapChange) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_TRNS)});
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 0);
+
+    set_keymap({key_a, KeymapKey(1, 0, 0, KC_B)});
+    EXPECT_EQ(layer_switch_get_layer(key_a.position), 1);
+
+    layer_clear();
+}
+
+TEST_F(EffectiveLayerCache, MomentaryLayerReleasesOriginalKey) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  layer_key   = KeymapKey(0, 0, 0, MO(1));
+    KeymapKey  regular_key = KeymapKey(0, 1, 0, KC_A);
+
+    set_keymap({layer_key, regular_key, KeymapKey(1, 0, 0, KC_TRNS), KeymapKey(1, 1, 0, KC_B)});
+
+    EXPECT_REPORT(driver, (KC_A));
+    regular_key.press();
+    run_one_scan_loop();
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.press();
+    run_one_scan_loop();
+
+    // The key was pressed on layer 0, so it must be released there too
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+
+    EXPECT_NO_REPORT(driver);
+    layer_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,212 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_benchmark.hpp"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_random.hpp"
+
+extern "C" {
+#include "action_util.h"
+#include "process_key_override.h"
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+static uint32_t overrides_examined = 0;
+
+// Counts the overrides each path looks at, both of them go through key_override_get() for every override they examine
+extern "C" const key_override_t *key_override_get(uint16_t key_override_idx) {
+    ++overrides_examined;
+    return key_override_get_raw(key_override_idx);
+}
+
+class KeyOverrideKeyIndex : public TestFixture, public testing::WithParamInterface<bool> {
+   public:
+    void SetUp() override {
+        key_override_key_index_set_enabled(GetParam());
+    }
+
+    void TearDown() override {
+        key_override_key_index_set_enabled(true);
+    }
+};
+
+TEST_P(KeyOverrideKeyIndex, FirstMatchingOverrideWins) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_shift, key_backspace});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DELETE));
+    key_backspace.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_backspace.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(KeyOverrideKeyIndex, NoOverrideWithoutModifiers) {
+    TestDriver driver;
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_backspace});
+
+    EXPECT_REPORT(driver, (KC_BACKSPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_backspace);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_P(KeyOverrideKeyIndex, OnlyExaminesOverridesForTheKey) {
+    TestDriver driver;
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_backspace});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    keyrecord_t record   = {};
+    record.event.key     = {1, 0};
+    record.event.type    = KEY_EVENT;
+    record.event.pressed = true;
+
+    // Held Shift keeps the linear scan off its "no mods down" fast path
+    add_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    // No override is triggered by Space, and the ones without a trigger need other modifiers
+    overrides_examined = 0;
+    process_key_override(KC_SPACE, &record);
+    EXPECT_EQ(overrides_examined, GetParam() ? 0 : key_override_count());
+
+    // Shift + Backspace = Delete is override 290, the first one with that trigger
+    overrides_examined = 0;
+    process_key_override(KC_BACKSPACE, &record);
+    EXPECT_EQ(overrides_examined, GetParam() ? 1 : 291);
+
+    record.event.pressed = false;
+    process_key_override(KC_BACKSPACE, &record);
+    clear_mods();
+    idle_for(600);
+}
+
+INSTANTIATE_TEST_CASE_P(IndexedAndLinear, KeyOverrideKeyIndex, testing::Bool(), [](const testing::TestParamInfo<bool> &info) { return info.param ? "Indexed" : "Linear"; });
+
+// Plays the same pseudo-random stream of key and modifier events through both matching paths and checks that they send the
+// same reports. The stream covers triggers pressed before and after their modifiers as well as overrides without a trigger.
+class KeyOverrideKeyIndexEquivalence : public TestFixture {
+   public:
+    std::vector<report_keyboard_t> replay_events(TestDriver &driver, std::vector<KeymapKey> &keys);
+};
+
+std::vector<report_keyboard_t> KeyOverrideKeyIndexEquivalence::replay_events(TestDriver &driver, std::vector<KeymapKey> &keys) {
+    std::vector<report_keyboard_t> reports;
+    std::vector<bool>              held(keys.size(), false);
+    TestRandom                     random(12345);
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([&reports](report_keyboard_t &report) { reports.push_back(report); });
+
+    for (uint16_t step = 0; step < 600; ++step) {
+        size_t key = random.next(keys.size());
+        if (held[key]) {
+            keys[key].release();
+        } else {
+            keys[key].press();
+        }
+        held[key] = !held[key];
+        idle_for(1 + random.next(80));
+    }
+    for (size_t key = 0; key < keys.size(); ++key) {
+        if (held[key]) {
+            keys[key].release();
+            run_one_scan_loop();
+        }
+    }
+    idle_for(600); // past KEY_OVERRIDE_REPEAT_DELAY, so no deferred key is left over
+
+    testing::Mock::VerifyAndClearExpectations(&driver);
+    return reports;
+}
+
+TEST_F(KeyOverrideKeyIndexEquivalence, IndexedMatchesLinear) {
+    TestDriver             driver;
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, KC_LEFT_SHIFT), KeymapKey(0, 1, 0, KC_LEFT_CTRL), KeymapKey(0, 2, 0, KC_LEFT_ALT), KeymapKey(0, 3, 0, KC_RIGHT_GUI), KeymapKey(0, 4, 0, KC_RIGHT_SHIFT), KeymapKey(0, 0, 1, KC_A), KeymapKey(0, 1, 1, KC_B), KeymapKey(0, 2, 1, KC_C), KeymapKey(0, 3, 1, KC_D), KeymapKey(0, 4, 1, KC_BACKSPACE),
+    };
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    key_override_key_index_set_enabled(false);
+    auto linear = replay_events(driver, keys);
+
+    key_override_key_index_set_enabled(true);
+    auto indexed = replay_events(driver, keys);
+
+    ASSERT_GT(linear.size(), 100u);
+    // The stream has to actually activate overrides for the comparison to mean anything
+    size_t replaced = std::count_if(linear.begin(), linear.end(), [](const report_keyboard_t &report) { return std::any_of(std::begin(report.keys), std::end(report.keys), [](uint8_t key) { return key >= KC_F1 && key <= KC_F12; }); });
+    EXPECT_GT(replaced, 10u);
+    ASSERT_EQ(linear.size(), indexed.size());
+    for (size_t i = 0; i < linear.size(); ++i) {
+        EXPECT_EQ(linear[i], indexed[i]) << "report " << i;
+    }
+}
+
+class KeyOverrideKeyIndexBenchmark : public TestFixture {};
+
+static double time_events(uint32_t events) {
+    keyrecord_t record   = {};
+    record.event.key     = {1, 0};
+    record.event.type    = KEY_EVENT;
+    record.event.pressed = true;
+
+    double ns = benchmark_ns([&] {
+        for (uint32_t i = 0; i < events; ++i) {
+            record.event.pressed = !(i & 1);
+            process_key_override((i & 2) ? KC_SPACE : KC_ENTER, &record);
+        }
+    });
+    return ns / events;
+}
+
+// Feeds the same stream of non-trigger key events through both matching paths with Shift held, so the linear scan can't
+// reject overrides on the "no mods down" fast path, with 300 overrides defined
+TEST_F(KeyOverrideKeyIndexBenchmark, IndexedVersusLinear) {
+    const uint32_t events = 20000;
+
+    add_mods(MOD_BIT(KC_LEFT_SHIFT));
+
+    key_override_key_index_set_enabled(false);
+    time_events(events / 10);
+    double linear_ns = time_events(events);
+
+    key_override_key_index_set_enabled(true);
+    time_events(events / 10);
+    double indexed_ns = time_events(events);
+
+    clear_mods();
+
+    record_benchmark("linear_ns", linear_ns);
+    record_benchmark("indexed_ns", indexed_ns);
+}
@@ -0,0 +1,32 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+#define KEY_INDEX_OVERRIDE_COUNT 300
+#define KEY_INDEX_FILLER_COUNT 290
+
+static key_override_t  overrides[KEY_INDEX_OVERRIDE_COUNT];
+const key_override_t  *key_overrides[KEY_INDEX_OVERRIDE_COUNT];
+
+// Fillers cycle through KC_A..KC_0 with a mix of modifier requirements, and every 37th has no trigger key. The overrides
+// the tests look for come after them, so both matching paths have to get past more than 255 overrides.
+__attribute__((constructor)) static void key_index_overrides_init(void) {
+    static const uint8_t filler_mods[] = {MOD_BIT(KC_LEFT_SHIFT), MOD_BIT(KC_LEFT_CTRL), MOD_MASK_SHIFT, MOD_BIT(KC_LEFT_CTRL) | MOD_BIT(KC_LEFT_ALT), MOD_BIT(KC_RIGHT_GUI)};
+
+    for (uint16_t i = 0; i < KEY_INDEX_FILLER_COUNT; ++i) {
+        uint16_t trigger = (i % 37 == 36) ? KC_NO : KC_A + (i % 36);
+        uint8_t  mods    = (trigger == KC_NO) ? MOD_BIT(KC_RIGHT_GUI) | MOD_BIT(KC_LEFT_CTRL) : filler_mods[i % sizeof(filler_mods)];
+        overrides[i]     = ko_make_with_layers_negmods_and_options(mods, trigger, KC_F1 + (i % 12), ~0, (i % 3 == 0) ? MOD_BIT(KC_LEFT_ALT) : 0, (i % 4 == 0) ? ko_options_default | ko_option_one_mod : ko_options_default);
+    }
+
+    // Shift + Backspace = Delete, shadowing the later Shift + Backspace = Escape
+    overrides[290] = ko_make_basic(MOD_MASK_SHIFT, KC_BACKSPACE, KC_DELETE);
+    overrides[291] = ko_make_basic(MOD_MASK_SHIFT, KC_BACKSPACE, KC_ESCAPE);
+    for (uint16_t i = 292; i < KEY_INDEX_OVERRIDE_COUNT; ++i) {
+        overrides[i] = ko_make_basic(MOD_BIT(KC_RIGHT_ALT), KC_F13 + (i - 292), KC_F1);
+    }
+
+    for (uint16_t i = 0; i < KEY_INDEX_OVERRIDE_COUNT; ++i) {
+        key_overrides[i] = &overrides[i];
+    }
+}
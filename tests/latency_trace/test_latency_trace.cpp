@@ -0,0 +1,106 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+void simulate_async_tick(uint32_t t);
+}
+
+using testing::_;
+using testing::InSequence;
+
+class LatencyTrace : public TestFixture {
+   public:
+    void SetUp() override {
+        latency_trace_reset();
+    }
+};
+
+TEST_F(LatencyTrace, StampsEveryStageOfAKeypress) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_MATRIX_SCAN)->count, 2);
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_MATRIX_TASK)->count, 2);
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_ACTION_EXEC)->count, 2);
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_PROCESS_RECORD)->count, 2);
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_HOST_SEND)->count, 2);
+    EXPECT_EQ(latency_trace_dropped_count(), 0);
+}
+
+TEST_F(LatencyTrace, IdleScansAreNotRecorded) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_MATRIX_SCAN)->count, 0);
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_HOST_SEND)->count, 0);
+}
+
+TEST_F(LatencyTrace, LaterStagesAccumulateLatency) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    // Every timer read now advances time, so each stage sees a strictly later timestamp than the previous one
+    simulate_async_tick(1);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    simulate_async_tick(0);
+
+    const latency_trace_histogram_t *matrix_task = latency_trace_get_histogram(LATENCY_TRACE_STAGE_MATRIX_TASK);
+    const latency_trace_histogram_t *action_exec = latency_trace_get_histogram(LATENCY_TRACE_STAGE_ACTION_EXEC);
+    const latency_trace_histogram_t *host_send   = latency_trace_get_histogram(LATENCY_TRACE_STAGE_HOST_SEND);
+
+    EXPECT_GT(matrix_task->min_us, 0);
+    EXPECT_GT(action_exec->min_us, matrix_task->max_us);
+    EXPECT_GT(host_send->min_us, action_exec->max_us);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(LatencyTrace, RawReportCarriesBatchedEvents) {
+    uint8_t report[32];
+
+    latency_trace_scan_begin();
+    latency_trace_stamp(LATENCY_TRACE_STAGE_ACTION_EXEC);
+    latency_trace_stamp(LATENCY_TRACE_STAGE_HOST_SEND);
+
+    EXPECT_EQ(latency_trace_fill_report(report, sizeof(report)), 3);
+    EXPECT_EQ(report[0], LATENCY_TRACE_REPORT_MARKER);
+    EXPECT_EQ(report[1], 3);
+    EXPECT_EQ(report[2 + 5], LATENCY_TRACE_STAGE_MATRIX_SCAN);
+    EXPECT_EQ(report[2 + 6 + 5], LATENCY_TRACE_STAGE_ACTION_EXEC);
+    EXPECT_EQ(report[2 + 12 + 5], LATENCY_TRACE_STAGE_HOST_SEND);
+    EXPECT_EQ(report[2 + 4], report[2 + 6 + 4]);
+
+    EXPECT_EQ(latency_trace_get_histogram(LATENCY_TRACE_STAGE_HOST_SEND)->count, 1);
+    EXPECT_EQ(latency_trace_fill_report(report, sizeof(report)), 0);
+}
@@ -0,0 +1,13 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define OLED_DISPLAY_128X64
+#define OLED_TIMEOUT 0
+#define OLED_COALESCE_BLOCKS
+#define OLED_UPDATE_BYTE_LIMIT 256
+#define OLED_RENDER_STATS
+#define OLED_RENDER_STATS_INTERVAL 0
@@ -0,0 +1,183 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "oled_driver.h"
+}
+
+static const uint16_t WIDTH  = 128;
+static const uint16_t PAGES  = 64 / 8;
+static const uint16_t MATRIX = WIDTH * PAGES;
+
+extern "C" uint8_t oled_buffer[];
+
+struct window_t {
+    uint8_t col_start, col_end, page_start, page_end;
+};
+
+/**
+ * An SSD1306 in horizontal addressing mode: data written after a window command fills the window row by row, and the
+ * address pointer carries over from one data transfer to the next.
+ */
+static struct {
+    uint8_t               ram[MATRIX];
+    window_t              window;
+    uint8_t               col, page;
+    std::vector<window_t> windows;
+    std::vector<uint16_t> data_transfers;
+} controller;
+
+extern "C" bool oled_send_cmd(const uint8_t *data, uint16_t size) {
+    // Only address windows matter here, the rest of the commands are set up once by oled_init()
+    if (size == 7 && data[1] == 0x21 && data[4] == 0x22) {
+        controller.window = {data[2], data[3], data[5], data[6]};
+        controller.col    = data[2];
+        controller.page   = data[5];
+        controller.windows.push_back(controller.window);
+    }
+    return true;
+}
+
+extern "C" bool oled_send_data(const uint8_t *data, uint16_t size) {
+    for (uint16_t i = 0; i < size; ++i) {
+        controller.ram[controller.page * WIDTH + controller.col] = data[i];
+        if (++controller.col > controller.window.col_end) {
+            controller.col = controller.window.col_start;
+            if (++controller.page > controller.window.page_end) {
+                controller.page = controller.window.page_start;
+            }
+        }
+    }
+    controller.data_transfers.push_back(size);
+    return true;
+}
+
+class OledCoalesceBlocks : public testing::Test {
+   protected:
+    void SetUp() override {
+        memset(controller.ram, 0xAA, sizeof(controller.ram));
+        ASSERT_TRUE(oled_init(OLED_ROTATION_0));
+        oled_render_dirty(true);
+        controller.windows.clear();
+        controller.data_transfers.clear();
+        oled_reset_render_stats();
+    }
+
+    void fill_buffer(uint8_t seed) {
+        std::vector<char> pattern(MATRIX);
+        for (uint16_t i = 0; i < MATRIX; ++i) {
+            pattern[i] = (char)(i * 7 + seed);
+        }
+        oled_write_raw(pattern.data(), MATRIX);
+    }
+
+    void expect_display_matches_buffer() {
+        for (uint16_t i = 0; i < MATRIX; ++i) {
+            ASSERT_EQ(controller.ram[i], oled_buffer[i]) << "byte " << i;
+        }
+    }
+};
+
+TEST_F(OledCoalesceBlocks, InitClearsDisplay) {
+    for (uint16_t i = 0; i < MATRIX; ++i) {
+        ASSERT_EQ(controller.ram[i], 0) << "byte " << i;
+    }
+}
+
+TEST_F(OledCoalesceBlocks, FullFrameIsOneWindow) {
+    fill_buffer(1);
+    oled_render_dirty(true);
+
+    ASSERT_EQ(controller.windows.size(), 1u);
+    EXPECT_EQ(controller.windows[0].col_start, 0);
+    EXPECT_EQ(controller.windows[0].col_end, WIDTH - 1);
+    EXPECT_EQ(controller.windows[0].page_start, 0);
+    EXPECT_EQ(controller.windows[0].page_end, PAGES - 1);
+    ASSERT_EQ(controller.data_transfers.size(), 1u);
+    EXPECT_EQ(controller.data_transfers[0], MATRIX);
+    expect_display_matches_buffer();
+}
+
+TEST_F(OledCoalesceBlocks, StreamsUpToByteLimitPerRender) {
+    fill_buffer(2);
+
+    uint8_t renders = 0;
+    do {
+        oled_render();
+        ++renders;
+    } while (controller.data_transfers.size() < MATRIX / OLED_UPDATE_BYTE_LIMIT);
+    EXPECT_EQ(renders, MATRIX / OLED_UPDATE_BYTE_LIMIT);
+
+    // The window is set up once, and the controller picks up where the last transfer left off
+    EXPECT_EQ(controller.windows.size(), 1u);
+    for (uint16_t size : controller.data_transfers) {
+        EXPECT_EQ(size, OLED_UPDATE_BYTE_LIMIT);
+    }
+    expect_display_matches_buffer();
+
+    // Nothing is left to send
+    oled_render();
+    EXPECT_EQ(controller.data_transfers.size(), MATRIX / OLED_UPDATE_BYTE_LIMIT);
+}
+
+TEST_F(OledCoalesceBlocks, SeparateRunsGetSeparateWindows) {
+    oled_write_raw_byte(0x11, 3);            // block 0: page 0, columns 0-63
+    oled_write_raw_byte(0x22, 5 * WIDTH + 9); // block 10: page 5, columns 0-63
+    oled_render_dirty(true);
+
+    ASSERT_EQ(controller.windows.size(), 2u);
+    EXPECT_EQ(controller.windows[0].col_end, 63);
+    EXPECT_EQ(controller.windows[0].page_start, 0);
+    EXPECT_EQ(controller.windows[1].col_start, 0);
+    EXPECT_EQ(controller.windows[1].col_end, 63);
+    EXPECT_EQ(controller.windows[1].page_start, 5);
+    EXPECT_EQ(controller.windows[1].page_end, 5);
+    expect_display_matches_buffer();
+}
+
+TEST_F(OledCoalesceBlocks, RunStartingMidPageSplitsAtPageBoundaries) {
+    // Blocks 1-4: the second half of page 0, all of page 1 and the first half of page 2
+    for (uint16_t i = 64; i < 320; i += 64) {
+        oled_write_raw_byte(0x33, i);
+    }
+    oled_render_dirty(true);
+
+    ASSERT_EQ(controller.windows.size(), 3u);
+    EXPECT_EQ(controller.windows[0].col_start, 64);
+    EXPECT_EQ(controller.windows[0].col_end, 127);
+    EXPECT_EQ(controller.windows[1].col_start, 0);
+    EXPECT_EQ(controller.windows[1].col_end, 127);
+    EXPECT_EQ(controller.windows[1].page_start, 1);
+    EXPECT_EQ(controller.windows[2].col_end, 63);
+    EXPECT_EQ(controller.windows[2].page_start, 2);
+    expect_display_matches_buffer();
+}
+
+TEST_F(OledCoalesceBlocks, DrawingDuringAStreamIsRendered) {
+    fill_buffer(3);
+    oled_render();
+
+    // One byte that has already been sent, and one that hasn't
+    oled_write_raw_byte(0x5A, 10);
+    oled_write_raw_byte(0x5B, MATRIX - 10);
+    oled_render_dirty(true);
+
+    expect_display_matches_buffer();
+}
+
+TEST_F(OledCoalesceBlocks, RenderStats) {
+    fill_buffer(4);
+    oled_render_dirty(true);
+    oled_write_raw_byte(0x44, 0);
+    oled_render_dirty(true);
+
+    oled_render_stats_t stats;
+    oled_get_render_stats(&stats);
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_EQ(stats.transfers, 4u);
+    EXPECT_EQ(stats.bytes, MATRIX + 64u);
+}
@@ -0,0 +1,10 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define QP_STREAM_HAS_FILE_IO
+#define QUANTUM_PAINTER_PIXDATA_DOUBLE_BUFFER
+#define QUANTUM_PAINTER_DISPLAY_TIMEOUT 0
@@ -0,0 +1,379 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "qp.h"
+#include "qp_internal.h"
+#include "qp_comms.h"
+#include "qgf.h"
+#include "qp_surface.h"
+}
+
+static const uint16_t PANEL_WIDTH  = 240;
+static const uint16_t PANEL_HEIGHT = 240;
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * An RGB565 panel whose comms model an SPI peripheral with DMA: a transfer runs in the background and only costs the
+ * CPU time if it has to be waited upon. The received data is only copied into the framebuffer once the transfer has
+ * been waited upon, so any buffer reused while still being transmitted shows up as corruption.
+ */
+struct mock_panel_t {
+    painter_driver_t base; // must be first, so this object can be cast to painter_driver_t*
+
+    std::vector<uint16_t> framebuffer;
+    uint16_t              l, t, r, b;
+    uint16_t              cursor_x, cursor_y;
+
+    double                 ns_per_byte;
+    clock_type::time_point epoch;
+    double                 stalled_ns;
+    double                 busy_until_ns;
+    const uint8_t         *in_flight_data;
+    uint32_t               in_flight_bytes;
+    uint32_t               transfers;
+    uint32_t               overlapped_decodes; // pixels decoded while a transfer was still in flight
+
+    // Elapsed time, with the CPU time spent stalled on transfers added in
+    double now_ns() const {
+        return std::chrono::duration<double, std::nano>(clock_type::now() - epoch).count() + stalled_ns;
+    }
+};
+
+static mock_panel_t *panel_from(painter_device_t device) {
+    return (mock_panel_t *)device;
+}
+
+static void mock_receive(mock_panel_t *panel, const uint8_t *data, uint32_t byte_count) {
+    const uint16_t *pixels = (const uint16_t *)data;
+    for (uint32_t i = 0; i < byte_count / sizeof(uint16_t); ++i) {
+        panel->framebuffer[panel->cursor_y * PANEL_WIDTH + panel->cursor_x] = pixels[i];
+        if (++panel->cursor_x > panel->r) {
+            panel->cursor_x = panel->l;
+            if (++panel->cursor_y > panel->b) {
+                panel->cursor_y = panel->t;
+            }
+        }
+    }
+}
+
+static bool mock_comms_init(painter_device_t device) {
+    return true;
+}
+
+static bool mock_comms_start(painter_device_t device) {
+    return true;
+}
+
+static bool mock_comms_stop(painter_device_t device) {
+    EXPECT_EQ(panel_from(device)->in_flight_data, nullptr) << "Comms stopped during a transfer";
+    return true;
+}
+
+static bool mock_comms_wait(painter_device_t device) {
+    mock_panel_t *panel = panel_from(device);
+    double        now   = panel->now_ns();
+    if (panel->busy_until_ns > now) {
+        panel->stalled_ns += panel->busy_until_ns - now;
+    }
+    if (panel->in_flight_data) {
+        mock_receive(panel, panel->in_flight_data, panel->in_flight_bytes);
+        panel->in_flight_data = nullptr;
+    }
+    return true;
+}
+
+static uint32_t mock_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    mock_panel_t *panel = panel_from(device);
+    EXPECT_EQ(panel->in_flight_data, nullptr) << "Transfer started while another was in flight";
+    panel->busy_until_ns   = panel->now_ns() + panel->ns_per_byte * byte_count;
+    panel->in_flight_data  = (const uint8_t *)data;
+    panel->in_flight_bytes = byte_count;
+    ++panel->transfers;
+    return byte_count;
+}
+
+static uint32_t mock_comms_send(painter_device_t device, const void *data, uint32_t byte_count) {
+    mock_comms_send_async(device, data, byte_count);
+    mock_comms_wait(device);
+    return byte_count;
+}
+
+static bool mock_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+static bool mock_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+static bool mock_clear(painter_device_t device) {
+    return true;
+}
+
+static bool mock_flush(painter_device_t device) {
+    return true;
+}
+
+static bool mock_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    mock_panel_t *panel = panel_from(device);
+    EXPECT_EQ(panel->in_flight_data, nullptr) << "Viewport changed during a transfer";
+    panel->l = panel->cursor_x = left;
+    panel->t = panel->cursor_y = top;
+    panel->r                   = right;
+    panel->b                   = bottom;
+    return true;
+}
+
+static bool mock_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    qp_comms_send(device, pixel_data, native_pixel_count * sizeof(uint16_t));
+    return true;
+}
+
+static uint16_t mock_native_color(qp_pixel_t hsv) {
+    return (uint16_t)((hsv.hsv888.h << 8) | hsv.hsv888.v);
+}
+
+static bool mock_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        palette[i].rgb565 = mock_native_color(palette[i]);
+    }
+    return true;
+}
+
+static bool mock_append_pixels(painter_device_t device, uint8_t *target_buffer, qp_pixel_t *palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t *palette_indices) {
+    mock_panel_t *panel = panel_from(device);
+    if (panel->in_flight_data) {
+        EXPECT_NE(target_buffer, panel->in_flight_data) << "Decoding into the buffer being transferred";
+        panel->overlapped_decodes += pixel_count;
+    }
+    uint16_t *buf = (uint16_t *)target_buffer;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = palette[palette_indices[i]].rgb565;
+    }
+    return true;
+}
+
+static bool mock_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+static const painter_driver_vtable_t mock_driver_vtable = {
+    .init            = mock_init,
+    .power           = mock_power,
+    .clear           = mock_clear,
+    .flush           = mock_flush,
+    .viewport        = mock_viewport,
+    .pixdata         = mock_pixdata,
+    .palette_convert = mock_palette_convert,
+    .append_pixels   = mock_append_pixels,
+    .append_pixdata  = mock_append_pixdata,
+};
+
+static const painter_comms_vtable_t mock_sync_comms_vtable = {
+    .comms_init       = mock_comms_init,
+    .comms_start      = mock_comms_start,
+    .comms_stop       = mock_comms_stop,
+    .comms_send       = mock_comms_send,
+    .comms_send_async = nullptr,
+    .comms_wait       = nullptr,
+};
+
+static const painter_comms_vtable_t mock_async_comms_vtable = {
+    .comms_init       = mock_comms_init,
+    .comms_start      = mock_comms_start,
+    .comms_stop       = mock_comms_stop,
+    .comms_send       = mock_comms_send,
+    .comms_send_async = mock_comms_send_async,
+    .comms_wait       = mock_comms_wait,
+};
+
+/**
+ * Builds a full-screen, single frame, 4bpp palette QGF image.
+ */
+static std::vector<uint8_t> make_qgf(const std::vector<qp_pixel_t> &palette, const std::vector<uint8_t> &indices) {
+    std::vector<uint8_t> out;
+    auto                 u8     = [&out](uint32_t v) { out.push_back(v & 0xFF); };
+    auto                 u16    = [&u8](uint32_t v) { u8(v), u8(v >> 8); };
+    auto                 u24    = [&u8](uint32_t v) { u8(v), u8(v >> 8), u8(v >> 16); };
+    auto                 u32    = [&u16](uint32_t v) { u16(v), u16(v >> 16); };
+    auto                 header = [&](uint8_t type_id, uint32_t length) { u8(type_id), u8(~type_id), u24(length); };
+
+    std::vector<uint8_t> data((indices.size() + 1) / 2);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        data[i / 2] |= indices[i] << (4 * (i % 2));
+    }
+
+    const uint32_t frame_offset = 23 + 9;
+    const uint32_t total_size   = frame_offset + 11 + (5 + 16 * 3) + (5 + data.size());
+
+    header(QGF_GRAPHICS_DESCRIPTOR_TYPEID, 18);
+    u24(QGF_MAGIC), u8(0x01), u32(total_size), u32(~total_size), u16(PANEL_WIDTH), u16(PANEL_HEIGHT), u16(1);
+    header(QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, 4);
+    u32(frame_offset);
+    header(QGF_FRAME_DESCRIPTOR_TYPEID, 6);
+    u8(PALETTE_4BPP), u8(0), u8(IMAGE_UNCOMPRESSED), u8(0), u16(0);
+    header(QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, 16 * 3);
+    for (auto &p : palette) {
+        u8(p.hsv888.h), u8(p.hsv888.s), u8(p.hsv888.v);
+    }
+    header(QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+    out.insert(out.end(), data.begin(), data.end());
+
+    EXPECT_EQ(out.size(), total_size);
+    return out;
+}
+
+class PainterDoubleBuffer : public ::testing::Test {
+   protected:
+    mock_panel_t          panel = {};
+    std::vector<uint8_t>  qgf;
+    std::vector<uint16_t> expected;
+
+    void SetUp() override {
+        std::vector<qp_pixel_t> palette(16);
+        for (uint8_t i = 0; i < 16; ++i) {
+            palette[i].hsv888 = {.h = (uint8_t)(i * 16), .s = 255, .v = (uint8_t)(255 - i * 8)};
+        }
+
+        // Something that doesn't repeat every chunk, so that out-of-order or stale chunks are detected
+        std::vector<uint8_t> indices(PANEL_WIDTH * PANEL_HEIGHT);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            indices[i] = ((i * 7) / 5 + i / PANEL_WIDTH) & 0x0F;
+            expected.push_back(mock_native_color(palette[indices[i]]));
+        }
+        qgf = make_qgf(palette, indices);
+
+        panel.base.driver_vtable         = &mock_driver_vtable;
+        panel.base.comms_vtable          = &mock_async_comms_vtable;
+        panel.base.panel_width           = PANEL_WIDTH;
+        panel.base.panel_height          = PANEL_HEIGHT;
+        panel.base.native_bits_per_pixel = 16;
+        panel.framebuffer.assign(PANEL_WIDTH * PANEL_HEIGHT, 0);
+        panel.epoch = clock_type::now();
+        ASSERT_TRUE(qp_init((painter_device_t)&panel, QP_ROTATION_0));
+    }
+
+    // Loads the image through a file stream, as a device would from external storage
+    painter_image_handle_t load_image() {
+        FILE *f = tmpfile();
+        EXPECT_NE(f, nullptr);
+        fwrite(qgf.data(), 1, qgf.size(), f);
+        rewind(f);
+        return qp_load_image_file(f);
+    }
+
+    // Draws the image, returning the time taken including any time stalled waiting on transfers
+    double draw_image() {
+        painter_image_handle_t image = load_image();
+        EXPECT_NE(image, nullptr);
+        double start = panel.now_ns();
+        EXPECT_TRUE(qp_drawimage((painter_device_t)&panel, 0, 0, image));
+        double end = panel.now_ns();
+        qp_close_image(image);
+        return end - start;
+    }
+};
+
+TEST_F(PainterDoubleBuffer, SynchronousDrawIsCorrect) {
+    panel.base.comms_vtable = &mock_sync_comms_vtable;
+    draw_image();
+    EXPECT_TRUE(panel.framebuffer == expected) << "Framebuffer did not match the image";
+    EXPECT_EQ(panel.overlapped_decodes, 0);
+}
+
+TEST_F(PainterDoubleBuffer, AsynchronousDrawIsCorrect) {
+    panel.ns_per_byte = 10;
+    draw_image();
+    EXPECT_EQ(panel.in_flight_data, nullptr) << "Transfer still in flight after drawing";
+    EXPECT_TRUE(panel.framebuffer == expected) << "Framebuffer did not match the image";
+}
+
+TEST_F(PainterDoubleBuffer, DecodesWhileTransferring) {
+    panel.base.comms_vtable = &mock_sync_comms_vtable;
+    draw_image();
+    uint32_t sync_transfers = panel.transfers;
+
+    panel.base.comms_vtable = &mock_async_comms_vtable;
+    panel.transfers         = 0;
+    draw_image();
+    EXPECT_EQ(panel.transfers, sync_transfers);
+
+    // Only the first chunk is decoded with nothing on the wire, every other one overlaps the previous transfer
+    EXPECT_GT(sync_transfers, 2);
+    EXPECT_GT(panel.overlapped_decodes, PANEL_WIDTH * PANEL_HEIGHT / 2);
+}
+
+TEST_F(PainterDoubleBuffer, SurfaceFlushesDirtyRegionAsynchronously) {
+    std::vector<uint8_t> surface_buffer(SURFACE_REQUIRED_BUFFER_BYTE_SIZE(PANEL_WIDTH, PANEL_HEIGHT, 16));
+    painter_device_t     surface = qp_make_rgb565_surface(PANEL_WIDTH, PANEL_HEIGHT, surface_buffer.data());
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+
+    painter_image_handle_t image = load_image();
+    ASSERT_NE(image, nullptr);
+    ASSERT_TRUE(qp_drawimage(surface, 0, 0, image));
+    qp_close_image(image);
+
+    panel.ns_per_byte = 10;
+    ASSERT_TRUE(qp_surface_draw(surface, (painter_device_t)&panel, 0, 0, false));
+    EXPECT_TRUE(memcmp(panel.framebuffer.data(), surface_buffer.data(), surface_buffer.size()) == 0) << "Framebuffer did not match the surface";
+
+    // Only the changed region is sent the second time around
+    std::fill(panel.framebuffer.begin(), panel.framebuffer.end(), 0);
+    ASSERT_TRUE(qp_rect(surface, 10, 20, 29, 24, 0, 255, 255, true));
+    ASSERT_TRUE(qp_surface_draw(surface, (painter_device_t)&panel, 0, 0, false));
+    const uint16_t *surface_pixels = (const uint16_t *)surface_buffer.data();
+    for (uint16_t y = 0; y < PANEL_HEIGHT; ++y) {
+        for (uint16_t x = 0; x < PANEL_WIDTH; ++x) {
+            bool     dirty = x >= 10 && x <= 29 && y >= 20 && y <= 24;
+            uint16_t value = panel.framebuffer[y * PANEL_WIDTH + x];
+            ASSERT_EQ(value, dirty ? surface_pixels[y * PANEL_WIDTH + x] : 0) << "Unexpected pixel at " << x << "," << y;
+        }
+    }
+}
+
+// Draws a full-screen 4bpp image through the file stream backend, comparing a blocking transfer of each chunk against
+// transferring each chunk while the next one is decoded. The modelled transfer rate is matched to the measured decode
+// rate, as is typical of an MCU decoding images for an SPI display.
+TEST_F(PainterDoubleBuffer, BenchmarkFullScreenImage) {
+    const int iterations = 10;
+
+    // Calibrate against the decode time on its own
+    panel.base.comms_vtable = &mock_sync_comms_vtable;
+    panel.ns_per_byte       = 0;
+    draw_image();
+    double decode_ns = 0;
+    for (int i = 0; i < iterations; ++i) {
+        decode_ns += draw_image();
+    }
+    decode_ns /= iterations;
+    panel.ns_per_byte = decode_ns / (PANEL_WIDTH * PANEL_HEIGHT * sizeof(uint16_t));
+
+    double sync_ns = 0;
+    for (int i = 0; i < iterations; ++i) {
+        sync_ns += draw_image();
+    }
+    sync_ns /= iterations;
+    EXPECT_TRUE(panel.framebuffer == expected) << "Framebuffer did not match the image";
+
+    std::fill(panel.framebuffer.begin(), panel.framebuffer.end(), 0);
+    panel.base.comms_vtable = &mock_async_comms_vtable;
+    double async_ns         = 0;
+    for (int i = 0; i < iterations; ++i) {
+        async_ns += draw_image();
+    }
+    async_ns /= iterations;
+    EXPECT_TRUE(panel.framebuffer == expected) << "Framebuffer did not match the image";
+
+    record_benchmark("decode_us", decode_ns / 1000);
+    record_benchmark("blocking_us", sync_ns / 1000);
+    record_benchmark("double_buffered_us", async_ns / 1000);
+}
@@ -0,0 +1,10 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_MOTION_ACCUMULATE
+// Sensors are read every scan loop, reports go out every fourth
+#define POINTING_DEVICE_REPORT_INTERVAL_MS 4
@@ -0,0 +1,217 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+#include "test_random.hpp"
+
+extern "C" {
+#include "pointing_device.h"
+#include "timer.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+static int driver_clear_motion_calls = 0;
+
+extern "C" void pointing_device_driver_clear_motion(void) {
+    driver_clear_motion_calls++;
+}
+
+struct sent_report_t {
+    report_mouse_t report;
+    uint32_t       time;
+};
+
+class PointingAccumulate : public TestFixture {
+   public:
+    std::vector<sent_report_t> sent;
+
+    void SetUp() override {
+        pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_ONE, POINTING_DEVICE_MOTION_SCALE_ONE);
+        pointing_device_clear_motion();
+        pd_clear_movement();
+        sent.clear();
+    }
+
+    void TearDown() override {
+        pd_clear_movement();
+        pd_clear_all_buttons();
+        pointing_device_clear_motion();
+    }
+
+    void record_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber()).WillRepeatedly([this](report_mouse_t &report) { sent.push_back({report, timer_read32()}); });
+    }
+
+    // The time of the last report outlives a test, and the timer starts over for the next one
+    void wait_for_report_interval() {
+        idle_for(100);
+    }
+
+    // Reads the sensor once per scan loop
+    void poll(int16_t x, int16_t y, int16_t h = 0, int16_t v = 0) {
+        pd_set_x(x);
+        pd_set_y(y);
+        pd_set_h(h);
+        pd_set_v(v);
+        run_one_scan_loop();
+        pd_clear_movement();
+    }
+
+    template <typename T>
+    int32_t total(T report_mouse_t::*axis) {
+        int32_t sum = 0;
+        for (auto &s : sent) {
+            sum += s.report.*axis;
+        }
+        return sum;
+    }
+};
+
+TEST_F(PointingAccumulate, MotionIsConserved) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // A synthetic trace from a high CPI sensor, read several times per report, so bursts pile up past what a report
+    // can carry
+    int32_t    expected_x = 0, expected_y = 0;
+    TestRandom random(12345);
+    for (int i = 0; i < 500; i++) {
+        int16_t x = (int16_t)random.next(255) - 127;
+        int16_t y = (int16_t)random.next(161) - 80;
+        expected_x += x;
+        expected_y += y;
+        poll(x, y);
+    }
+    idle_for(2000);
+    VERIFY_AND_CLEAR(driver);
+
+    int32_t x = 0, y = 0;
+    for (size_t i = 0; i < sent.size(); i++) {
+        x += sent[i].report.x;
+        y += sent[i].report.y;
+        if (i > 0) {
+            EXPECT_GE(sent[i].time - sent[i - 1].time, (uint32_t)POINTING_DEVICE_REPORT_INTERVAL_MS) << "report " << i;
+        }
+    }
+    EXPECT_EQ(x, expected_x);
+    EXPECT_EQ(y, expected_y);
+}
+
+TEST_F(PointingAccumulate, BacklogIsSplitAcrossReports) {
+    TestDriver driver;
+    record_reports(driver);
+    wait_for_report_interval();
+
+    for (int i = 0; i < 8; i++) {
+        poll(MOUSE_REPORT_XY_MAX, -100);
+    }
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    // Motion keeps going out at the report rate, a full report at a time, until it has all been sent
+    ASSERT_EQ(sent.size(), 8u);
+    for (size_t i = 0; i < sent.size(); i++) {
+        EXPECT_EQ(sent[i].report.x, MOUSE_REPORT_XY_MAX);
+        if (i > 0) {
+            EXPECT_EQ(sent[i].time - sent[i - 1].time, (uint32_t)POINTING_DEVICE_REPORT_INTERVAL_MS);
+        }
+    }
+    EXPECT_EQ(sent[0].report.y, -100);
+    EXPECT_EQ(sent[1].report.y, MOUSE_REPORT_XY_MIN);
+    EXPECT_EQ(total(&report_mouse_t::y), -800);
+}
+
+TEST_F(PointingAccumulate, ReportsAreCoalesced) {
+    TestDriver driver;
+    record_reports(driver);
+    wait_for_report_interval();
+
+    for (int i = 0; i < 16; i++) {
+        poll(1, 2);
+    }
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    // The first poll goes straight out, and the rest in one report per interval
+    EXPECT_EQ(sent.size(), 16 / POINTING_DEVICE_REPORT_INTERVAL_MS + 1);
+    EXPECT_EQ(total(&report_mouse_t::x), 16);
+    EXPECT_EQ(total(&report_mouse_t::y), 32);
+}
+
+TEST_F(PointingAccumulate, FractionsAddUp) {
+    TestDriver driver;
+    record_reports(driver);
+
+    // A scroll divisor of 8 and half speed pointer motion
+    pointing_device_set_motion_scale(POINTING_DEVICE_MOTION_SCALE_ONE / 2, POINTING_DEVICE_MOTION_SCALE_ONE / 8);
+    for (int i = 0; i < 20; i++) {
+        poll(-3, 0, 0, 1);
+    }
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(total(&report_mouse_t::x), -30);
+    EXPECT_EQ(total(&report_mouse_t::v), 2);
+
+    // What's left over stays pending rather than being rounded away
+    sent.clear();
+    record_reports(driver);
+    for (int i = 0; i < 4; i++) {
+        poll(0, 0, 0, 1);
+    }
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(total(&report_mouse_t::v), 1);
+}
+
+TEST_F(PointingAccumulate, ButtonsAreNotHeldBack) {
+    TestDriver driver;
+    wait_for_report_interval();
+
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, 0, 0));
+    poll(5, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    // Within the report interval, the button goes out straight away and the motion waits
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    pd_press_button(POINTING_DEVICE_BUTTON1);
+    poll(5, 0);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, 0, 1));
+    idle_for(POINTING_DEVICE_REPORT_INTERVAL_MS);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 0));
+    pd_release_button(POINTING_DEVICE_BUTTON1);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingAccumulate, ClearMotionDiscardsPendingMotion) {
+    TestDriver driver;
+    record_reports(driver);
+    wait_for_report_interval();
+
+    for (int i = 0; i < 4; i++) {
+        poll(MOUSE_REPORT_XY_MAX, 0);
+    }
+    pointing_device_clear_motion();
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(sent.size(), 1u);
+    EXPECT_EQ(sent[0].report.x, MOUSE_REPORT_XY_MAX);
+}
+
+TEST_F(PointingAccumulate, ClearMotionReachesTheDriver) {
+    // Sensor drivers can hold back motion that didn't fit in a report, which has to go as well
+    driver_clear_motion_calls = 0;
+    pointing_device_clear_motion();
+    EXPECT_EQ(driver_clear_motion_calls, 1);
+}
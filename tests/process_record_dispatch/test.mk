@@ -0,0 +1,18 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CAPS_WORD_ENABLE = yes
+DYNAMIC_TAPPING_TERM_ENABLE = yes
+LAYER_LOCK_ENABLE = yes
+REPEAT_KEY_ENABLE = yes
+SECURE_ENABLE = yes
+TRI_LAYER_ENABLE = yes
+
+ALWAYS_HANDLERS = process_last_key process_repeat_key process_caps_word process_space_cadet process_layer_lock process_quantum
+RANGE_HANDLERS = process_secure process_dynamic_tapping_term process_magic process_grave_esc process_tri_layer process_default_layer process_oneshot
+
+# Handler calls are counted by intercepting calls between objects, which needs GNU ld
+ifeq ($(shell uname -s),Linux)
+    OPT_DEFS += -DPROCESS_RECORD_DISPATCH_COUNT
+    LDFLAGS += $(foreach function,$(ALWAYS_HANDLERS) $(RANGE_HANDLERS),-Wl,--wrap=$(function))
+endif
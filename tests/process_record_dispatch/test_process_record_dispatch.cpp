@@ -0,0 +1,128 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <string>
+#include "keyboard_report_util.hpp"
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+static std::map<std::string, int> handler_calls;
+
+#ifdef PROCESS_RECORD_DISPATCH_COUNT
+// Linked with --wrap for each of these, see test.mk.
+#    define COUNT_HANDLER(function)                                                      \
+        extern "C" bool __real_##function(uint16_t keycode, keyrecord_t *record);        \
+        extern "C" bool __wrap_##function(uint16_t keycode, keyrecord_t *record) {       \
+            ++handler_calls[#function];                                                  \
+            return __real_##function(keycode, record);                                   \
+        }                                                                                \
+        [[maybe_unused]] static bool function##_registered = (handler_calls[#function], true);
+
+COUNT_HANDLER(process_last_key)
+COUNT_HANDLER(process_repeat_key)
+COUNT_HANDLER(process_caps_word)
+COUNT_HANDLER(process_space_cadet)
+COUNT_HANDLER(process_layer_lock)
+COUNT_HANDLER(process_quantum)
+
+COUNT_HANDLER(process_secure)
+COUNT_HANDLER(process_dynamic_tapping_term)
+COUNT_HANDLER(process_magic)
+COUNT_HANDLER(process_grave_esc)
+COUNT_HANDLER(process_tri_layer)
+COUNT_HANDLER(process_default_layer)
+COUNT_HANDLER(process_oneshot)
+#endif
+
+static const std::vector<std::string> always_handlers = {"process_last_key", "process_repeat_key", "process_caps_word", "process_space_cadet", "process_layer_lock", "process_quantum"};
+
+class ProcessRecordDispatch : public TestFixture {
+   public:
+    void SetUp() override {
+#ifndef PROCESS_RECORD_DISPATCH_COUNT
+        GTEST_SKIP() << "handler calls can only be counted when linking with GNU ld";
+#endif
+        for (auto &handler : handler_calls) {
+            handler.second = 0;
+        }
+    }
+
+    int total_calls() {
+        int total = 0;
+        for (auto &handler : handler_calls) {
+            total += handler.second;
+        }
+        return total;
+    }
+};
+
+TEST_F(ProcessRecordDispatch, BasicKeycodeOnlyCallsInterestedHandlers) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    for (auto &handler : handler_calls) {
+        bool always = std::find(always_handlers.begin(), always_handlers.end(), handler.first) != always_handlers.end();
+        EXPECT_EQ(handler.second, always ? 2 : 0) << handler.first;
+    }
+
+    // A chain of calls would have invoked every handler for both events
+    record_benchmark("handlers_called_per_event", total_calls() / 2);
+    record_benchmark("handlers_counted", handler_calls.size());
+}
+
+TEST_F(ProcessRecordDispatch, RangeHandlersReceiveTheirKeycodes) {
+    TestDriver driver;
+    auto       key_gesc  = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+    auto       key_lower = KeymapKey(0, 1, 0, QK_TRI_LAYER_LOWER);
+    set_keymap({key_gesc, key_lower});
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_gesc);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(handler_calls["process_grave_esc"], 2);
+
+    EXPECT_NO_REPORT(driver);
+    key_lower.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    key_lower.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(handler_calls["process_tri_layer"], 2);
+}
+
+TEST_F(ProcessRecordDispatch, HandlersAfterAConsumingHandlerAreSkipped) {
+    TestDriver driver;
+    auto       key_gesc = KeymapKey(0, 0, 0, QK_GRAVE_ESCAPE);
+    set_keymap({key_gesc});
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_gesc);
+    VERIFY_AND_CLEAR(driver);
+
+    // Run before Grave Escape, in order
+    EXPECT_EQ(handler_calls["process_caps_word"], 2);
+    EXPECT_EQ(handler_calls["process_secure"], 2);
+    EXPECT_EQ(handler_calls["process_dynamic_tapping_term"], 2);
+    EXPECT_EQ(handler_calls["process_space_cadet"], 2);
+    // Run after Grave Escape, which consumed the key
+    EXPECT_EQ(handler_calls["process_tri_layer"], 0);
+    EXPECT_EQ(handler_calls["process_layer_lock"], 0);
+    EXPECT_EQ(handler_calls["process_oneshot"], 0);
+    EXPECT_EQ(handler_calls["process_quantum"], 0);
+}
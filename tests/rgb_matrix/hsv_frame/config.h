@@ -0,0 +1,13 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define RGB_MATRIX_LED_COUNT 8
+#define RGB_MATRIX_LED_PROCESS_LIMIT 8
+#define RGB_MATRIX_HSV_FRAME
+// Smaller than the LED count, so a render also flushes partway through
+#define RGB_MATRIX_HSV_FRAME_SIZE 3
+#define ENABLE_RGB_MATRIX_CYCLE_LEFT_RIGHT
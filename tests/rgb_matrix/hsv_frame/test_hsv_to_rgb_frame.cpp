@@ -0,0 +1,122 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+#include "test_random.hpp"
+
+extern "C" {
+#include "color.h"
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void advance_time(uint32_t ms);
+
+extern rgb_t    test_leds[RGB_MATRIX_LED_COUNT];
+extern uint32_t g_rgb_timer;
+}
+
+static bool operator==(const rgb_t &a, const rgb_t &b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+class HsvToRgbFrame : public testing::Test {};
+
+// Every one of the 2^24 colors converts exactly as it does one at a time
+TEST_F(HsvToRgbFrame, MatchesHsvToRgb) {
+    hsv_t hsv[256];
+    rgb_t rgb[256];
+    rgb_t rgb_nocie[256];
+
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = {(uint8_t)h, (uint8_t)s, (uint8_t)v};
+            }
+            hsv_to_rgb_frame(hsv, rgb, 256);
+            hsv_to_rgb_nocie_frame(hsv, rgb_nocie, 256);
+
+            for (uint16_t v = 0; v < 256; v++) {
+                ASSERT_TRUE(rgb[v] == hsv_to_rgb(hsv[v])) << "h " << h << " s " << s << " v " << v;
+                ASSERT_TRUE(rgb_nocie[v] == hsv_to_rgb_nocie(hsv[v])) << "h " << h << " s " << s << " v " << v;
+            }
+        }
+    }
+}
+
+TEST_F(HsvToRgbFrame, ConvertsInPlace) {
+    union {
+        hsv_t hsv;
+        rgb_t rgb;
+    } frame[256];
+
+    for (uint16_t i = 0; i < 256; i++) {
+        frame[i].hsv = {(uint8_t)i, (uint8_t)(255 - i), (uint8_t)(i * 7)};
+    }
+    hsv_to_rgb_frame(&frame[0].hsv, &frame[0].rgb, 256);
+
+    for (uint16_t i = 0; i < 256; i++) {
+        EXPECT_TRUE(frame[i].rgb == hsv_to_rgb({(uint8_t)i, (uint8_t)(255 - i), (uint8_t)(i * 7)})) << "pixel " << i;
+    }
+}
+
+TEST_F(HsvToRgbFrame, Benchmark) {
+    const uint32_t     pixels = 1 << 20;
+    const uint16_t     batch  = 256;
+    std::vector<hsv_t> hsv(pixels);
+    std::vector<rgb_t> rgb_scalar(pixels);
+    std::vector<rgb_t> rgb(pixels);
+    TestRandom         random(12345);
+
+    for (auto &pixel : hsv) {
+        uint16_t hue_sat = random.next();
+        pixel            = {(uint8_t)hue_sat, (uint8_t)(hue_sat >> 8), (uint8_t)random.next()};
+    }
+
+    double scalar_ns = benchmark_ns([&] {
+        for (uint32_t i = 0; i < pixels; i++) {
+            rgb_scalar[i] = hsv_to_rgb(hsv[i]);
+        }
+    });
+    double frame_ns = benchmark_ns([&] {
+        for (uint32_t i = 0; i < pixels; i += batch) {
+            hsv_to_rgb_frame(&hsv[i], &rgb[i], batch);
+        }
+    });
+
+    record_benchmark("scalar_per_sec", pixels / scalar_ns * 1e9);
+    record_benchmark("frame_per_sec", pixels / frame_ns * 1e9);
+
+    EXPECT_EQ(memcmp(rgb.data(), rgb_scalar.data(), pixels * sizeof(rgb_t)), 0);
+}
+
+class HsvFrameEffect : public TestFixture {};
+
+// Effect runners batch their colors, while still skipping LEDs that don't match the flags
+TEST_F(HsvFrameEffect, RunnerRendersEveryLed) {
+    TestDriver driver;
+
+    rgb_matrix_enable_noeeprom();
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_CYCLE_LEFT_RIGHT);
+    rgb_matrix_sethsv_noeeprom(0, 200, 255);
+    rgb_matrix_set_flags_noeeprom(LED_FLAG_KEYLIGHT);
+    idle_for(RGB_MATRIX_LED_FLUSH_LIMIT * 2);
+
+    // Render one full frame without time moving on
+    advance_time(RGB_MATRIX_LED_FLUSH_LIMIT);
+    memset(test_leds, 0xAA, sizeof(test_leds));
+    for (uint8_t i = 0; i < 10; i++) {
+        rgb_matrix_task();
+    }
+
+    const uint8_t time = scale16by8(g_rgb_timer, qadd8(rgb_matrix_get_speed() / 4, 1));
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (g_led_config.flags[i] & LED_FLAG_KEYLIGHT) {
+            rgb_t expected = hsv_to_rgb({(uint8_t)(g_led_config.point[i].x - time), 200, RGB_MATRIX_MAXIMUM_BRIGHTNESS});
+            EXPECT_TRUE(test_leds[i] == expected) << "LED " << (int)i;
+        } else {
+            EXPECT_EQ(test_leds[i].r, 0xAA) << "LED " << (int)i;
+        }
+    }
+}
@@ -0,0 +1,35 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+rgb_t test_leds[RGB_MATRIX_LED_COUNT];
+
+// clang-format off
+led_config_t g_led_config = {
+    {{0}},
+    {{0, 0}, {30, 0}, {60, 0}, {90, 0}, {120, 0}, {150, 0}, {180, 0}, {210, 0}},
+    {4, 4, 4, 4, 4, 2, 4, 4},
+};
+// clang-format on
+
+static void test_init(void) {}
+
+static void test_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    test_leds[index] = (rgb_t){r, g, b};
+}
+
+static void test_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        test_set_color(i, r, g, b);
+    }
+}
+
+static void test_flush(void) {}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = test_init,
+    .set_color     = test_set_color,
+    .set_color_all = test_set_color_all,
+    .flush         = test_flush,
+};
@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Small enough that a handful of simultaneous changes overflows it
+#define SCAN_QUEUE_SIZE 4
@@ -0,0 +1,111 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "scan_queue.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" void advance_time(uint32_t ms);
+
+static std::vector<keyevent_t> processed;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    processed.push_back(record->event);
+    return true;
+}
+
+class ScanQueue : public TestFixture {
+   public:
+    void SetUp() override {
+        processed.clear();
+    }
+};
+
+TEST_F(ScanQueue, TapKey) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_a);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(processed.size(), 2u);
+    EXPECT_TRUE(processed[0].pressed);
+    EXPECT_FALSE(processed[1].pressed);
+}
+
+TEST_F(ScanQueue, EventKeepsScanTime) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    // The key is seen by a scan, but the main loop doesn't get to the event until later
+    key_a.press();
+    const uint16_t scan_time = timer_read();
+    EXPECT_TRUE(scan_queue_produce());
+    advance_time(30);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(processed.size(), 1u);
+    EXPECT_TRUE(TIMER_DIFF_16(processed[0].time, scan_time) <= 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanQueue, FullQueueDefersRemainingChanges) {
+    TestDriver             driver;
+    InSequence             s;
+    std::vector<KeymapKey> keys = {KeymapKey(0, 0, 0, KC_A), KeymapKey(0, 1, 0, KC_B), KeymapKey(0, 2, 0, KC_C), KeymapKey(0, 3, 0, KC_D), KeymapKey(0, 0, 1, KC_E)};
+    for (auto &key : keys) {
+        add_key(key);
+    }
+
+    // The queue holds three events, so the last two changes wait for the next scan
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    for (auto &key : keys) {
+        key.press();
+    }
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(processed.size(), SCAN_QUEUE_SIZE - 1u);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(processed.size(), keys.size());
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(keys.size());
+    for (auto &key : keys) {
+        key.release();
+    }
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Everything pressed was released, in scan order
+    ASSERT_EQ(processed.size(), 2 * keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        EXPECT_EQ(processed[i].key.row, processed[keys.size() + i].key.row);
+        EXPECT_EQ(processed[i].key.col, processed[keys.size() + i].key.col);
+        EXPECT_FALSE(processed[keys.size() + i].pressed);
+    }
+}
@@ -0,0 +1,10 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define TICKLESS_IDLE_MATRIX_INTERRUPT
+#define TICKLESS_IDLE_MAX_SLEEP 100
+#define TICKLESS_IDLE_ACTIVITY_TIMEOUT 200
@@ -0,0 +1,5 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SCAN_QUEUE_ENABLE = yes
+TICKLESS_IDLE_ENABLE = yes
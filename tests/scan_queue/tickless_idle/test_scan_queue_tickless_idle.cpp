@@ -0,0 +1,57 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "scan_queue.h"
+
+void set_time(uint32_t t);
+}
+
+class ScanQueueTicklessIdle : public TestFixture {
+   public:
+    void SetUp() override {
+        set_activity_timestamps(0, 0, 0);
+        tickless_idle_reset_stats();
+    }
+};
+
+// Stands in for the scan thread, which queues events while the main loop is asleep and then wakes it
+TEST_F(ScanQueueTicklessIdle, QueuedEventIsNotHeldBackBySleep) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    EXPECT_EQ(tickless_idle_timeout(), TICKLESS_IDLE_MAX_SLEEP);
+
+    key_a.press();
+    EXPECT_TRUE(scan_queue_produce());
+    EXPECT_FALSE(scan_queue_is_empty());
+    EXPECT_EQ(tickless_idle_timeout(), 0);
+
+    tickless_idle_wakeup();
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+
+    EXPECT_REPORT(driver, (KC_A));
+    keyboard_task();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(scan_queue_is_empty());
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanQueueTicklessIdle, WakeupCutsSleepShort) {
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    tickless_idle_wakeup();
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    EXPECT_EQ(tickless_idle_get_stats()->sleeps, 1);
+}
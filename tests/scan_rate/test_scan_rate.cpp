@@ -0,0 +1,127 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "scan_rate.h"
+}
+
+extern "C" void advance_time(uint32_t ms);
+
+// The test platform's timestamps are milliseconds, so these tests work with millisecond budgets
+class ScanRate : public TestFixture {
+   public:
+    void SetUp() override {
+        scan_rate_set_target(0);
+        scan_rate_reset();
+    }
+
+    void TearDown() override {
+        scan_rate_set_target(0);
+    }
+
+    // Starts a new window, publishing the one in progress
+    void roll_window() {
+        advance_time(1000);
+        scan_rate_begin();
+    }
+};
+
+TEST_F(ScanRate, CountsScansPerSecond) {
+    TestDriver driver;
+
+    // The first scan opens the window, the rest fill it
+    idle_for(1001);
+
+    const scan_rate_stats_t *stats = scan_rate_get_stats();
+    EXPECT_EQ(stats->scans_per_second, 1000u);
+    EXPECT_EQ(get_matrix_scan_rate(), 1000u);
+}
+
+TEST_F(ScanRate, MeasuresScanAndTaskTime) {
+    scan_rate_begin();
+    advance_time(1);
+    scan_rate_mark(SCAN_RATE_TASK_MATRIX);
+    advance_time(3);
+    scan_rate_mark(SCAN_RATE_TASK_RGB_MATRIX);
+    advance_time(2);
+    scan_rate_end();
+
+    scan_rate_begin();
+    advance_time(2);
+    scan_rate_mark(SCAN_RATE_TASK_RGB_MATRIX);
+    scan_rate_end();
+
+    roll_window();
+
+    const scan_rate_stats_t *stats = scan_rate_get_stats();
+    EXPECT_EQ(stats->scans_per_second, 2u);
+    EXPECT_EQ(stats->max_scan_us, 6000u);
+    EXPECT_EQ(stats->task_us[SCAN_RATE_TASK_MATRIX], 1000u);
+    EXPECT_EQ(stats->task_us[SCAN_RATE_TASK_RGB_MATRIX], 5000u);
+    EXPECT_EQ(stats->task_max_us[SCAN_RATE_TASK_RGB_MATRIX], 3000u);
+    EXPECT_EQ(stats->task_us[SCAN_RATE_TASK_OTHER], 2000u);
+}
+
+TEST_F(ScanRate, DefersTaskThatWouldExceedBudget) {
+    // 4ms per iteration
+    scan_rate_set_target(250);
+
+    // A 3ms task fits after a 1ms matrix scan
+    scan_rate_begin();
+    advance_time(1);
+    scan_rate_mark(SCAN_RATE_TASK_MATRIX);
+    ASSERT_TRUE(scan_rate_should_run(SCAN_RATE_TASK_RGB_MATRIX));
+    advance_time(3);
+    scan_rate_mark(SCAN_RATE_TASK_RGB_MATRIX);
+    scan_rate_end();
+
+    // After a 2ms matrix scan it doesn't, until it has been deferred SCAN_RATE_MAX_DEFERRALS times
+    for (int iteration = 0; iteration <= SCAN_RATE_MAX_DEFERRALS; ++iteration) {
+        scan_rate_begin();
+        advance_time(2);
+        scan_rate_mark(SCAN_RATE_TASK_MATRIX);
+        bool run = scan_rate_should_run(SCAN_RATE_TASK_RGB_MATRIX);
+        EXPECT_EQ(run, iteration == SCAN_RATE_MAX_DEFERRALS) << "iteration " << iteration;
+        if (run) {
+            advance_time(3);
+            scan_rate_mark(SCAN_RATE_TASK_RGB_MATRIX);
+        }
+        scan_rate_end();
+    }
+
+    // Other tasks are judged on their own cost
+    scan_rate_begin();
+    advance_time(2);
+    scan_rate_mark(SCAN_RATE_TASK_MATRIX);
+    EXPECT_TRUE(scan_rate_should_run(SCAN_RATE_TASK_OLED));
+    scan_rate_end();
+
+    roll_window();
+    EXPECT_EQ(scan_rate_get_stats()->deferred[SCAN_RATE_TASK_RGB_MATRIX], SCAN_RATE_MAX_DEFERRALS);
+    EXPECT_EQ(scan_rate_get_stats()->deferred[SCAN_RATE_TASK_OLED], 0);
+}
+
+TEST_F(ScanRate, NoTargetNeverDefers) {
+    scan_rate_begin();
+    advance_time(10);
+    scan_rate_mark(SCAN_RATE_TASK_RGB_MATRIX);
+    scan_rate_end();
+
+    for (int iteration = 0; iteration < 10; ++iteration) {
+        scan_rate_begin();
+        advance_time(10);
+        scan_rate_mark(SCAN_RATE_TASK_MATRIX);
+        EXPECT_TRUE(scan_rate_should_run(SCAN_RATE_TASK_RGB_MATRIX));
+        scan_rate_end();
+    }
+    EXPECT_EQ(scan_rate_get_target(), 0u);
+}
+
+TEST_F(ScanRate, RejectsTargetFinerThanTimestamp) {
+    // A millisecond timebase cannot budget an iteration shorter than one millisecond
+    EXPECT_TRUE(scan_rate_set_target(1000));
+    EXPECT_FALSE(scan_rate_set_target(2000));
+    EXPECT_EQ(scan_rate_get_target(), 1000u);
+}
@@ -0,0 +1,229 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::InvokeWithoutArgs;
+
+struct completion_t {
+    bool     completed;
+    intptr_t id;
+    uint32_t time;
+};
+
+static std::vector<completion_t> completions;
+
+static void record_completion(bool completed, void *cb_arg) {
+    completions.push_back({completed, (intptr_t)cb_arg, timer_read32()});
+}
+
+class SendStringAsync : public TestFixture {
+   public:
+    std::vector<uint32_t> report_times;
+
+    void SetUp() override {
+        completions.clear();
+        deferred_exec_task();
+    }
+
+    void TearDown() override {
+        TestDriver driver;
+        EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+        send_string_async_cancel();
+        run_for(2);
+    }
+
+    // The main loop, as far as queued strings are concerned
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            deferred_exec_task();
+            run_one_scan_loop();
+        }
+    }
+
+    void record_report_times(TestDriver &driver) {
+        EXPECT_ANY_REPORT(driver).WillRepeatedly(InvokeWithoutArgs([this] { report_times.push_back(timer_read32()); }));
+    }
+};
+
+TEST_F(SendStringAsync, QueuingDoesNotBlock) {
+    TestDriver driver;
+    uint32_t   start = timer_read32();
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("ab", 10, record_completion, (void *)1));
+    EXPECT_EQ(timer_read32(), start);
+    EXPECT_EQ(send_string_async_pending(), 1);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    run_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(send_string_async_pending(), 0);
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_TRUE(completions[0].completed);
+    EXPECT_EQ(completions[0].id, 1);
+}
+
+TEST_F(SendStringAsync, KeyEventsArePacedByTheInterval) {
+    TestDriver driver;
+    uint32_t   start = timer_read32();
+
+    record_report_times(driver);
+    send_string_async("ab", 10, record_completion, NULL);
+    run_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(report_times, (std::vector<uint32_t>{start + 1, start + 11, start + 21, start + 31}));
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].time, start + 41);
+}
+
+TEST_F(SendStringAsync, ShiftedCharacters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("A", 0, NULL, NULL);
+    run_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, DelaysArePacedByTheMainLoop) {
+    TestDriver driver;
+    uint32_t   start = timer_read32();
+
+    record_report_times(driver);
+    send_string_async("a" SS_DELAY(100) "b", 0, record_completion, NULL);
+    run_for(50);
+    EXPECT_EQ(report_times, (std::vector<uint32_t>{start + 1, start + 1}));
+    run_for(100);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(report_times, (std::vector<uint32_t>{start + 1, start + 1, start + 101, start + 101}));
+    ASSERT_EQ(completions.size(), 1);
+    EXPECT_EQ(completions[0].time, start + 101);
+}
+
+TEST_F(SendStringAsync, BurstsAreBounded) {
+    TestDriver driver;
+    uint32_t   start = timer_read32();
+
+    // Two events per character, so eight characters take two passes through the main loop
+    record_report_times(driver);
+    send_string_async("abcdefgh", 0, NULL, NULL);
+    run_for(5);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(report_times.size(), 16);
+    EXPECT_EQ(report_times[SEND_STRING_ASYNC_BURST - 1], start + 1);
+    EXPECT_EQ(report_times[SEND_STRING_ASYNC_BURST], start + 2);
+}
+
+TEST_F(SendStringAsync, FullQueueRejectsStrings) {
+    TestDriver driver;
+
+    EXPECT_ANY_REPORT(driver).Times(6);
+    EXPECT_TRUE(send_string_async("a", 0, record_completion, (void *)1));
+    EXPECT_TRUE(send_string_async("b", 0, record_completion, (void *)2));
+    EXPECT_FALSE(send_string_async("c", 0, record_completion, (void *)3));
+    EXPECT_EQ(send_string_async_pending(), 2);
+
+    run_for(5);
+    EXPECT_TRUE(send_string_async("d", 0, record_completion, (void *)4));
+    run_for(5);
+    VERIFY_AND_CLEAR(driver);
+
+    ASSERT_EQ(completions.size(), 3);
+    EXPECT_EQ(completions[0].id, 1);
+    EXPECT_EQ(completions[1].id, 2);
+    EXPECT_EQ(completions[2].id, 4);
+}
+
+TEST_F(SendStringAsync, CancelReleasesHeldKeys) {
+    TestDriver driver;
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    EXPECT_TRUE(send_string_async(SS_DOWN(X_LCTL) "a" SS_UP(X_LCTL), 50, record_completion, (void *)1));
+    EXPECT_TRUE(send_string_async("b", 50, record_completion, (void *)2));
+    run_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async_cancel();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_REPORT(driver);
+    run_for(200);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(send_string_async_pending(), 0);
+    ASSERT_EQ(completions.size(), 2);
+    EXPECT_FALSE(completions[0].completed);
+    EXPECT_FALSE(completions[1].completed);
+}
+
+TEST_F(SendStringAsync, BlockingSendWaitsForQueuedStrings) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    send_string_async("a", 10, record_completion, NULL);
+    send_string_with_delay("b", 10);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(send_string_async_pending(), 0);
+    EXPECT_EQ(completions.size(), 1);
+}
+
+typedef struct counting_state_t {
+    char next;
+    char last;
+} counting_state_t;
+
+static char get_next_counting(void *arg) {
+    counting_state_t *state = (counting_state_t *)arg;
+    return state->next <= state->last ? state->next++ : 0;
+}
+
+TEST_F(SendStringAsync, GetterStateIsCopied) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_Z));
+    EXPECT_EMPTY_REPORT(driver);
+    {
+        counting_state_t state = {'x', 'z'};
+        EXPECT_TRUE(send_string_async_impl(get_next_counting, &state, sizeof(state), 0, NULL, NULL));
+        state.next = 'a';
+    }
+    run_for(5);
+    VERIFY_AND_CLEAR(driver);
+}
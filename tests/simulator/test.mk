@@ -0,0 +1,17 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+TAP_DANCE_ENABLE = yes
+AUTO_SHIFT_ENABLE = yes
+CAPS_WORD_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = simulator_keymap.c
+
+# Per-module timing and allocation counting intercept calls between objects, which needs GNU ld
+ifeq ($(shell uname -s),Linux)
+    OPT_DEFS += -DREPLAY_SIMULATOR_PROFILE
+    LDFLAGS += $(foreach function,malloc calloc realloc \
+        keyboard_task action_exec action_tapping_process process_record \
+        process_combo process_tap_dance process_auto_shift process_caps_word host_keyboard_send,-Wl,--wrap=$(function))
+endif
@@ -0,0 +1,311 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include "gtest/gtest.h"
+#include "replay_typing.hpp"
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+#include "test_random.hpp"
+
+extern "C" {
+#include "action.h"
+#include "action_tapping.h"
+#include "host.h"
+#include "process_auto_shift.h"
+#include "process_combo.h"
+}
+
+#ifdef REPLAY_SIMULATOR_PROFILE
+// Linked with --wrap for each of these, see test.mk. Times are inclusive of anything the function calls.
+#    define REPLAY_PROFILE(ret, function, params, args)                                                                   \
+        extern "C" ret               __real_##function params;                                                           \
+        static ReplayModuleTime      function##_time       = {#function, 0, 0};                                          \
+        [[maybe_unused]] static bool function##_registered = (ReplaySimulator::register_module(&function##_time), true); \
+        extern "C" ret               __wrap_##function params {                                                          \
+            ReplayModuleTimer timer(function##_time);                                                                    \
+            return __real_##function args;                                                                               \
+        }
+
+REPLAY_PROFILE(void, keyboard_task, (void), ())
+REPLAY_PROFILE(void, action_exec, (keyevent_t event), (event))
+REPLAY_PROFILE(void, action_tapping_process, (keyrecord_t record), (record))
+REPLAY_PROFILE(void, process_record, (keyrecord_t * record), (record))
+REPLAY_PROFILE(bool, process_combo, (uint16_t keycode, keyrecord_t *record), (keycode, record))
+REPLAY_PROFILE(bool, process_tap_dance, (uint16_t keycode, keyrecord_t *record), (keycode, record))
+REPLAY_PROFILE(bool, process_auto_shift, (uint16_t keycode, keyrecord_t *record), (keycode, record))
+REPLAY_PROFILE(bool, process_caps_word, (uint16_t keycode, keyrecord_t *record), (keycode, record))
+REPLAY_PROFILE(void, host_keyboard_send, (report_keyboard_t * report), (report))
+
+extern "C" void *__real_malloc(size_t size);
+extern "C" void *__real_calloc(size_t count, size_t size);
+extern "C" void *__real_realloc(void *pointer, size_t size);
+
+extern "C" void *__wrap_malloc(size_t size) {
+    ReplaySimulator::count_allocation();
+    return __real_malloc(size);
+}
+
+extern "C" void *__wrap_calloc(size_t count, size_t size) {
+    ReplaySimulator::count_allocation();
+    return __real_calloc(count, size);
+}
+
+extern "C" void *__wrap_realloc(void *pointer, size_t size) {
+    ReplaySimulator::count_allocation();
+    return __real_realloc(pointer, size);
+}
+#endif
+
+// clang-format off
+static const ReplayLayout simulator_layout = {
+    {KC_Q,  KC_W,    KC_E,   KC_R,    KC_T,    KC_Y,   KC_U, KC_I,    KC_O,   KC_P},
+    {KC_A,  KC_S,    KC_D,   KC_F,    KC_G,    KC_H,   KC_J, KC_K,    KC_L,   KC_SCLN},
+    {KC_Z,  KC_X,    KC_C,   KC_V,    KC_B,    KC_N,   KC_M, KC_COMM, KC_DOT, KC_SLSH},
+    {TD(0), KC_LSFT, KC_SPC, KC_BSPC, CW_TOGG, KC_ENT, KC_1, KC_2,    KC_3,   KC_4},
+};
+// clang-format on
+
+static keypos_t position_of(uint16_t keycode) {
+    return replay_position_of(simulator_layout, keycode);
+}
+
+static uint16_t combo_partner(uint16_t keycode) {
+    switch (keycode) {
+        case KC_J:
+            return KC_K;
+        case KC_K:
+            return KC_J;
+        case KC_D:
+            return KC_F;
+        case KC_F:
+            return KC_D;
+        default:
+            return KC_NO;
+    }
+}
+
+/**
+ * Deterministic typing model for the simulator layout. Words are typed with rollover, and are sometimes capitalised by
+ * holding past the auto-shift timeout or with shift, typed in caps word, mistyped and corrected, or followed by a
+ * combo, tap dance or punctuation. Keeps track of the text the trace should type.
+ */
+class TraceGenerator {
+   public:
+    explicit TraceGenerator(uint32_t seed) : random(seed) {}
+
+    ReplayTrace generate(size_t words) {
+        static const char *const vocabulary[] = {"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "keyboard", "firmware", "matrix", "layer", "combo", "tap", "dance", "shift", "caps", "word", "kid", "jerk", "fjord", "did", "skunk", "judge"};
+
+        trace              = ReplayTrace();
+        trace.has_expected = true;
+        for (size_t i = 0; i < words; ++i) {
+            std::string word      = vocabulary[random.next(sizeof(vocabulary) / sizeof(vocabulary[0]))];
+            bool        caps_word = false;
+            switch (random.next(12)) {
+                case 0: // Capitalised by auto-shift, allowing for combo keys only reaching it after the combo term
+                    settle(30);
+                    tap(KC_A + (word[0] - 'a'), AUTO_SHIFT_TIMEOUT + COMBO_TERM + 20 + random.next(40), 0);
+                    settle(30);
+                    type(word.substr(1));
+                    word[0] = toupper(word[0]);
+                    break;
+                case 1: { // Capitalised with shift
+                    settle(30);
+                    uint32_t shift_down = now;
+                    now += 30;
+                    tap(KC_A + (word[0] - 'a'), 60, 0);
+                    settle(20);
+                    hold(KC_LSFT, shift_down, now);
+                    settle(30);
+                    type(word.substr(1));
+                    word[0] = toupper(word[0]);
+                    break;
+                }
+                case 2: // Caps word, ended by the following space once the last letter is released
+                    settle(30);
+                    tap(CW_TOGG, 50, 60);
+                    type(word);
+                    settle(30);
+                    std::transform(word.begin(), word.end(), word.begin(), ::toupper);
+                    caps_word = true;
+                    break;
+                case 3: { // Mistyped and corrected
+                    size_t typo = random.next(word.size());
+                    type(word.substr(0, typo));
+                    type("x");
+                    tap(KC_BSPC, 60, 80);
+                    type(word.substr(typo));
+                    break;
+                }
+                default:
+                    type(word);
+                    break;
+            }
+            trace.expected += word;
+
+            switch (caps_word ? 0 : 1 + random.next(10)) {
+                case 1: // Combo
+                    settle(30);
+                    chord(random.next(2) ? KC_J : KC_D);
+                    settle(30);
+                    break;
+                case 2: { // Tap dance, left to time out
+                    bool twice = random.next(2);
+                    settle(30);
+                    tap(TD(0), 50, 70);
+                    if (twice) {
+                        tap(TD(0), 50, 70);
+                    }
+                    settle(TAPPING_TERM + 30);
+                    trace.expected += twice ? "=" : "-";
+                    break;
+                }
+                case 3: { // Punctuation
+                    bool comma = random.next(2);
+                    tap(comma ? KC_COMM : KC_DOT, 60, 70);
+                    trace.expected += comma ? "," : ".";
+                    break;
+                }
+            }
+
+            if (i % 12 == 11) {
+                tap(KC_ENT, 60, 80);
+                trace.expected += "\n";
+            } else {
+                tap(KC_SPC, 60, 80);
+                trace.expected += " ";
+            }
+        }
+        return trace;
+    }
+
+   private:
+    TestRandom  random;
+    uint32_t    now                                = 0;
+    uint32_t    all_released                       = 0;
+    uint32_t    released[MATRIX_ROWS][MATRIX_COLS] = {};
+    ReplayTrace trace;
+
+    void settle(uint32_t gap) {
+        now = std::max(now, all_released) + gap;
+    }
+
+    void hold(uint16_t keycode, uint32_t press, uint32_t release) {
+        keypos_t position = position_of(keycode);
+        trace.add(press, position.row, position.col, true);
+        trace.add(release, position.row, position.col, false);
+        released[position.row][position.col] = release;
+        all_released                         = std::max(all_released, release);
+    }
+
+    /* Presses no earlier than `now`, and not while the same key or its combo partner are held. */
+    void tap(uint16_t keycode, uint32_t hold_ms, uint32_t interval) {
+        keypos_t position = position_of(keycode);
+        uint32_t press    = std::max(now, released[position.row][position.col] + 1);
+        if (uint16_t partner = combo_partner(keycode)) {
+            keypos_t partner_position = position_of(partner);
+            press                     = std::max(press, released[partner_position.row][partner_position.col] + 1);
+        }
+        hold(keycode, press, press + hold_ms);
+        now = press + interval;
+    }
+
+    void type(const std::string &text) {
+        for (char c : text) {
+            tap(KC_A + (c - 'a'), 60 + random.next(50), 40 + random.next(50));
+        }
+    }
+
+    void chord(uint16_t keycode) {
+        uint16_t partner = combo_partner(keycode);
+        hold(keycode, now, now + 50);
+        hold(partner, now + 10, now + 55);
+        trace.expected += keycode == KC_J ? "<esc>" : "\t";
+    }
+};
+
+class Simulator : public TestFixture {
+   protected:
+    void SetUp() override {
+        replay_add_layout(*this, simulator_layout);
+    }
+
+    static std::string trace_path(const char *name) {
+        std::string path = __FILE__;
+        return path.substr(0, path.find_last_of('/') + 1) + "traces/" + name;
+    }
+};
+
+TEST_F(Simulator, RecordedTraceTypesExpectedText) {
+    ReplayTrace trace;
+    std::string error;
+    ASSERT_TRUE(load_replay_trace(trace_path("hello.trace"), trace, error)) << error;
+    ASSERT_TRUE(trace.has_expected);
+
+    ReplayResult result = ReplaySimulator().replay(trace);
+    EXPECT_EQ(result.output, trace.expected);
+}
+
+TEST_F(Simulator, MalformedTraceIsRejected) {
+    ReplayTrace        trace;
+    std::string        error;
+    std::istringstream out_of_order("10 0 0 d\n5 0 0 u\n");
+    EXPECT_FALSE(parse_replay_trace(out_of_order, trace, error));
+    EXPECT_EQ(error, "line 2: events must be in time order");
+
+    std::istringstream outside_matrix("0 9 0 d\n");
+    EXPECT_FALSE(parse_replay_trace(outside_matrix, trace, error));
+    EXPECT_EQ(error, "line 1: position is outside the matrix");
+}
+
+TEST_F(Simulator, GeneratedTraceTypesExpectedText) {
+    ReplayTrace trace = TraceGenerator(1).generate(200);
+
+    ReplayResult result = ReplaySimulator().replay(trace);
+    EXPECT_EQ(result.output, trace.expected);
+}
+
+TEST_F(Simulator, ReplayIsDeterministic) {
+    ReplayTrace trace = TraceGenerator(2).generate(50);
+
+    ReplayResult first  = ReplaySimulator().replay(trace);
+    ReplayResult second = ReplaySimulator().replay(trace);
+    EXPECT_GT(first.reports, 0u);
+    EXPECT_EQ(first.reports, second.reports);
+    EXPECT_EQ(first.report_hash, second.report_hash);
+    EXPECT_EQ(first.output, second.output);
+}
+
+/**
+ * Replays a long generated trace, or the trace named by the QMK_REPLAY_TRACE environment variable, and reports
+ * throughput, heap allocations and the time spent in each module.
+ */
+TEST_F(Simulator, BenchmarkReplay) {
+    ReplayTrace trace;
+    if (const char *path = std::getenv("QMK_REPLAY_TRACE")) {
+        std::string error;
+        ASSERT_TRUE(load_replay_trace(path, trace, error)) << error;
+    } else {
+        trace = TraceGenerator(3).generate(1000);
+    }
+
+    ReplayResult result = ReplaySimulator().replay(trace);
+    if (trace.has_expected) {
+        EXPECT_EQ(result.output, trace.expected);
+    }
+
+    record_benchmark("events_per_second", result.events_per_second());
+    record_benchmark("scans_per_second", result.scans_per_second());
+    record_benchmark("allocations", result.allocations);
+    for (const auto &module : result.modules) {
+        record_benchmark(std::string(module.name) + "_calls", module.calls);
+        record_benchmark(std::string(module.name) + "_ns_per_event", result.events ? (double)module.ns / result.events : 0);
+    }
+
+    // Nothing on the key processing path should touch the heap
+    EXPECT_EQ(result.allocations, 0u);
+}
@@ -0,0 +1,7 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+CRC_ENABLE = yes
+
+VPATH += $(QUANTUM_PATH)/split_common
+SRC += serial_link.c
@@ -0,0 +1,362 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <deque>
+#include <functional>
+#include <map>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "test_benchmark.hpp"
+
+extern "C" {
+#include "serial_link.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+// 460800 baud with 8E2 framing
+static const size_t BYTES_PER_MS = 38;
+
+struct message_t {
+    uint8_t              id;
+    uint8_t              flags;
+    std::vector<uint8_t> data;
+
+    bool operator==(const message_t &other) const {
+        return id == other.id && flags == other.flags && data == other.data;
+    }
+};
+
+/**
+ * One direction of the line. Bytes take at least a millisecond to get across, and no more than BYTES_PER_MS of them
+ * arrive per millisecond. Line noise flips bits, drops bytes and adds stray ones.
+ */
+struct wire_t {
+    std::deque<std::pair<uint8_t, uint32_t>> bytes;
+    std::mt19937                             rng{1};
+    uint32_t                                 flip_one_in   = 0;
+    uint32_t                                 drop_one_in   = 0;
+    uint32_t                                 insert_one_in = 0;
+    // Drops a whole write, for losing particular frames
+    std::function<bool(const uint8_t *data, size_t length)> drop_write;
+
+    bool chance(uint32_t one_in) {
+        return one_in && rng() % one_in == 0;
+    }
+
+    void write(const uint8_t *data, size_t length) {
+        if (drop_write && drop_write(data, length)) {
+            return;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            uint8_t byte = data[i];
+            if (chance(drop_one_in)) {
+                continue;
+            }
+            if (chance(flip_one_in)) {
+                byte ^= 1 << (rng() % 8);
+            }
+            bytes.push_back({byte, timer_read32()});
+            if (chance(insert_one_in)) {
+                bytes.push_back({(uint8_t)rng(), timer_read32()});
+            }
+        }
+    }
+};
+
+struct endpoint_t {
+    serial_link_t          link;
+    wire_t                *out;
+    std::vector<message_t> received;
+    int                    resets;
+};
+
+static std::map<serial_link_t *, endpoint_t *> endpoints;
+
+static void link_write(serial_link_t *link, const uint8_t *data, size_t length) {
+    endpoints[link]->out->write(data, length);
+}
+
+static void link_receive(serial_link_t *link, uint8_t id, uint8_t flags, const uint8_t *data, uint8_t length) {
+    endpoints[link]->received.push_back({id, flags, std::vector<uint8_t>(data, data + length)});
+}
+
+static void link_reset(serial_link_t *link) {
+    endpoints[link]->resets++;
+}
+
+class SerialLink : public testing::Test {
+   protected:
+    wire_t     a_to_b, b_to_a;
+    endpoint_t initiator = {}, target = {};
+
+    void SetUp() override {
+        timer_clear();
+        endpoints.clear();
+        start(initiator, true, &a_to_b);
+        start(target, false, &b_to_a);
+    }
+
+    void start(endpoint_t &endpoint, bool is_initiator, wire_t *out) {
+        endpoint.out = out;
+        endpoint.received.clear();
+        endpoint.resets = 0;
+        serial_link_init(&endpoint.link, is_initiator, link_write, link_receive, link_reset);
+        endpoints[&endpoint.link] = &endpoint;
+    }
+
+    static void deliver(wire_t &wire, endpoint_t &endpoint) {
+        std::vector<uint8_t> bytes;
+        while (!wire.bytes.empty() && bytes.size() < BYTES_PER_MS && wire.bytes.front().second < timer_read32()) {
+            bytes.push_back(wire.bytes.front().first);
+            wire.bytes.pop_front();
+        }
+        serial_link_receive_bytes(&endpoint.link, bytes.data(), bytes.size());
+    }
+
+    // Runs both sides for a millisecond
+    void step() {
+        deliver(a_to_b, target);
+        deliver(b_to_a, initiator);
+        serial_link_task(&initiator.link);
+        serial_link_task(&target.link);
+        advance_time(1);
+    }
+
+    void run(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; ++i) {
+            step();
+        }
+    }
+
+    void connect() {
+        run(10);
+        ASSERT_TRUE(serial_link_is_connected(&initiator.link));
+        ASSERT_TRUE(serial_link_is_connected(&target.link));
+    }
+
+    static message_t message(uint32_t n, size_t length) {
+        message_t m = {(uint8_t)n, SERIAL_LINK_REQUEST, std::vector<uint8_t>(length)};
+        for (size_t i = 0; i < length; ++i) {
+            // Plenty of bytes that have to be escaped
+            m.data[i] = (i % 3) ? (uint8_t)(n * 7 + i) : (i % 2 ? SERIAL_LINK_FLAG : SERIAL_LINK_ESCAPE);
+        }
+        return m;
+    }
+
+    static bool send(endpoint_t &endpoint, const message_t &m) {
+        return serial_link_send(&endpoint.link, m.id, m.flags, m.data.data(), m.data.size());
+    }
+
+    // Keeps sending from both sides, as fast as the window lets through, until everything has been delivered
+    void exchange(const std::vector<message_t> &from_initiator, const std::vector<message_t> &from_target, uint32_t limit_ms) {
+        size_t a = 0, b = 0;
+        for (uint32_t ms = 0; ms < limit_ms; ++ms) {
+            while (a < from_initiator.size() && send(initiator, from_initiator[a])) {
+                ++a;
+            }
+            while (b < from_target.size() && send(target, from_target[b])) {
+                ++b;
+            }
+            if (target.received.size() == from_initiator.size() && initiator.received.size() == from_target.size()) {
+                break;
+            }
+            step();
+        }
+    }
+};
+
+TEST_F(SerialLink, Handshake) {
+    EXPECT_FALSE(serial_link_is_connected(&initiator.link));
+    EXPECT_FALSE(serial_link_can_send(&target.link));
+    connect();
+    EXPECT_EQ(initiator.resets, 1);
+    EXPECT_EQ(target.resets, 1);
+
+    // Keepalives hold the link up while there's nothing to send
+    run(500);
+    EXPECT_TRUE(serial_link_is_connected(&initiator.link));
+    EXPECT_TRUE(serial_link_is_connected(&target.link));
+    EXPECT_EQ(initiator.link.stats.timeouts, 0);
+}
+
+TEST_F(SerialLink, FramesArePipelined) {
+    connect();
+
+    // A full window goes out before the first acknowledgement can be back
+    for (uint32_t i = 0; i < SERIAL_LINK_WINDOW; ++i) {
+        EXPECT_TRUE(send(initiator, message(i, 8)));
+    }
+    EXPECT_FALSE(serial_link_can_send(&initiator.link));
+    EXPECT_FALSE(send(initiator, message(99, 8)));
+
+    // The window takes about a millisecond per frame to get across
+    run(SERIAL_LINK_WINDOW + 2);
+    EXPECT_TRUE(serial_link_is_idle(&initiator.link));
+    ASSERT_EQ(target.received.size(), (size_t)SERIAL_LINK_WINDOW);
+    for (uint32_t i = 0; i < SERIAL_LINK_WINDOW; ++i) {
+        EXPECT_EQ(target.received[i], message(i, 8));
+    }
+    EXPECT_EQ(initiator.link.stats.retransmits, 0);
+}
+
+TEST_F(SerialLink, TargetSendsUnsolicited) {
+    connect();
+
+    EXPECT_TRUE(send(target, message(1, 4)));
+    run(3);
+    ASSERT_EQ(initiator.received.size(), 1u);
+    EXPECT_EQ(initiator.received[0], message(1, 4));
+}
+
+TEST_F(SerialLink, OnlyLostFramesAreSent) {
+    connect();
+
+    // Lose the second data frame once
+    int data_frames = 0;
+    a_to_b.drop_write = [&](const uint8_t *data, size_t length) { return length > SERIAL_LINK_HEADER_SIZE + 8 && ++data_frames == 2; };
+
+    for (uint32_t i = 0; i < SERIAL_LINK_WINDOW; ++i) {
+        EXPECT_TRUE(send(initiator, message(i, 8)));
+    }
+    run(10);
+
+    EXPECT_EQ(initiator.link.stats.retransmits, 1);
+    ASSERT_EQ(target.received.size(), (size_t)SERIAL_LINK_WINDOW);
+    for (uint32_t i = 0; i < SERIAL_LINK_WINDOW; ++i) {
+        EXPECT_EQ(target.received[i], message(i, 8));
+    }
+}
+
+TEST_F(SerialLink, LostAcknowledgementsAreRecovered) {
+    connect();
+
+    int acks = 0;
+    b_to_a.drop_write = [&](const uint8_t *data, size_t length) { return acks++ < 2; };
+
+    EXPECT_TRUE(send(initiator, message(1, 8)));
+    run(20);
+
+    // The retransmission is acknowledged, and the duplicate isn't handed over twice
+    EXPECT_TRUE(serial_link_is_idle(&initiator.link));
+    EXPECT_GE(initiator.link.stats.retransmits, 1);
+    ASSERT_EQ(target.received.size(), 1u);
+}
+
+TEST_F(SerialLink, NoisyLineDeliversEverythingInOrder) {
+    connect();
+    for (wire_t *wire : {&a_to_b, &b_to_a}) {
+        wire->flip_one_in   = 2000;
+        wire->drop_one_in   = 3000;
+        wire->insert_one_in = 3000;
+    }
+
+    std::vector<message_t> from_initiator, from_target;
+    std::mt19937           rng(12345);
+    for (uint32_t i = 0; i < 2000; ++i) {
+        from_initiator.push_back(message(i, rng() % (SERIAL_LINK_PAYLOAD_SIZE + 1)));
+        from_target.push_back(message(i * 3, rng() % 8));
+    }
+    exchange(from_initiator, from_target, 20000);
+
+    EXPECT_EQ(target.received, from_initiator);
+    EXPECT_EQ(initiator.received, from_target);
+    EXPECT_GT(initiator.link.stats.retransmits + target.link.stats.retransmits, 0);
+    EXPECT_GT(initiator.link.stats.crc_errors + target.link.stats.crc_errors, 0);
+    EXPECT_EQ(initiator.link.stats.timeouts, 0);
+    EXPECT_EQ(initiator.resets, 1);
+}
+
+TEST_F(SerialLink, SequenceNumbersWrapAround) {
+    connect();
+
+    // Lose every seventh data frame, so that frames are in flight out of order as the sequence numbers wrap
+    int data_frames = 0;
+    a_to_b.drop_write = [&](const uint8_t *data, size_t length) { return length > SERIAL_LINK_HEADER_SIZE + 8 && ++data_frames % 7 == 0; };
+
+    std::vector<message_t> messages;
+    for (uint32_t i = 0; i < 600; ++i) {
+        messages.push_back(message(i, 8));
+    }
+    exchange(messages, {}, 10000);
+
+    EXPECT_EQ(target.received, messages);
+    EXPECT_GT(initiator.link.stats.retransmits, 0);
+    EXPECT_EQ(initiator.link.stats.timeouts, 0);
+}
+
+TEST_F(SerialLink, ReconnectsAfterTargetRestarts) {
+    connect();
+    EXPECT_TRUE(send(initiator, message(1, 8)));
+    run(3);
+
+    // The target comes back up knowing nothing about the link
+    start(target, false, &b_to_a);
+    EXPECT_TRUE(send(initiator, message(2, 8)));
+    run(SERIAL_LINK_TIMEOUT_MS + 20);
+
+    EXPECT_EQ(initiator.link.stats.timeouts, 1);
+    EXPECT_EQ(initiator.resets, 2);
+    EXPECT_EQ(target.resets, 1);
+    ASSERT_TRUE(serial_link_is_connected(&initiator.link));
+    ASSERT_TRUE(serial_link_is_connected(&target.link));
+
+    // What was in flight is gone, and the link carries on afresh
+    EXPECT_TRUE(send(initiator, message(3, 8)));
+    run(3);
+    ASSERT_EQ(target.received.size(), 1u);
+    EXPECT_EQ(target.received[0], message(3, 8));
+}
+
+TEST_F(SerialLink, ReconnectsAfterInitiatorRestarts) {
+    connect();
+    EXPECT_TRUE(send(target, message(1, 8)));
+    run(3);
+
+    start(initiator, true, &a_to_b);
+    run(10);
+
+    EXPECT_EQ(target.resets, 2);
+    ASSERT_TRUE(serial_link_is_connected(&initiator.link));
+    ASSERT_TRUE(serial_link_is_connected(&target.link));
+    EXPECT_TRUE(send(target, message(2, 8)));
+    run(3);
+    ASSERT_EQ(initiator.received.size(), 1u);
+    EXPECT_EQ(initiator.received[0], message(2, 8));
+}
+
+// Time to get a scan's worth of small transactions across, one at a time as the request/response protocol does, and
+// pipelined
+TEST_F(SerialLink, BenchmarkPipelining) {
+    connect();
+    const uint32_t         count = 200;
+    std::vector<message_t> messages;
+    for (uint32_t i = 0; i < count; ++i) {
+        messages.push_back(message(i, 6));
+    }
+
+    uint32_t start_ms = timer_read32();
+    for (const message_t &m : messages) {
+        EXPECT_TRUE(send(initiator, m));
+        while (!serial_link_is_idle(&initiator.link)) {
+            step();
+        }
+    }
+    uint32_t one_at_a_time_ms = timer_read32() - start_ms;
+
+    initiator.received.clear();
+    target.received.clear();
+    start_ms = timer_read32();
+    exchange(messages, {}, 10000);
+    while (!serial_link_is_idle(&initiator.link)) {
+        step();
+    }
+    uint32_t pipelined_ms = timer_read32() - start_ms;
+
+    EXPECT_EQ(target.received, messages);
+    EXPECT_LT(pipelined_ms, one_at_a_time_ms);
+    record_benchmark("one_at_a_time_ms", one_at_a_time_ms);
+    record_benchmark("pipelined_ms", pipelined_ms);
+}
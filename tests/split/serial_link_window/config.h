@@ -0,0 +1,9 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SERIAL_LINK_PAYLOAD_SIZE 32
+#define SERIAL_LINK_WINDOW 8
@@ -0,0 +1,10 @@
+# Copyright 2025 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# Runs the serial link tests with the largest window
+
+CRC_ENABLE = yes
+
+VPATH += $(QUANTUM_PATH)/split_common
+SRC += serial_link.c
+SRC += ../serial_link/test_serial_link.cpp
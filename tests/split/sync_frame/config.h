@@ -0,0 +1,12 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define SPLIT_KEYBOARD
+#define SPLIT_TRANSPORT_SYNC_FRAME
+#define SPLIT_LAYER_STATE_ENABLE
+#define DISABLE_SYNC_TIMER
+#define FORCED_SYNC_THROTTLE_MS 100
@@ -0,0 +1,175 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "action_layer.h"
+#include "timer.h"
+#include "transactions.h"
+#include "transport.h"
+#include "transaction_id_define.h"
+
+void advance_time(uint32_t ms);
+}
+
+// Both halves run in this process. The master uses the real shared memory, the slave gets its own copy, which the
+// stand-in serial transport below copies regions in and out of.
+static split_shared_memory_t slave_memory;
+static int                   exchanges;
+
+extern "C" {
+// Stand-ins for split_util.c, which would go looking for handedness and USB
+bool is_keyboard_master(void) {
+    return true;
+}
+
+void split_pre_init(void) {}
+void split_post_init(void) {}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+void soft_serial_initiator_init(void) {}
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    split_transaction_desc_t *trans  = &split_transaction_table[index];
+    uint8_t                  *master = (uint8_t *)split_shmem;
+    uint8_t                  *slave  = (uint8_t *)&slave_memory;
+
+    memcpy(slave + trans->initiator2target_offset, master + trans->initiator2target_offset, trans->initiator2target_buffer_size);
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, slave + trans->initiator2target_offset, trans->target2initiator_buffer_size, slave + trans->target2initiator_offset);
+    }
+    memcpy(master + trans->target2initiator_offset, slave + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    ++exchanges;
+    return true;
+}
+}
+
+class SyncFrame : public ::testing::Test {
+   protected:
+    matrix_row_t master_matrix[MATRIX_ROWS / 2] = {0};
+    matrix_row_t slave_matrix[MATRIX_ROWS / 2]  = {0};
+    layer_state_t slave_layer_state             = 0;
+    layer_state_t slave_default_layer_state     = 0;
+
+    void SetUp() override {
+        layer_state         = 0;
+        default_layer_state = 0;
+        // The slave fills in its matrix and acknowledgement first, then whatever an earlier test left staged gets
+        // acknowledged
+        slave_housekeeping();
+        settle();
+        exchanges = 0;
+    }
+
+    void master_scan() {
+        EXPECT_TRUE(transactions_master(master_matrix, slave_matrix));
+    }
+
+    // The slave's main loop pass, run against the slave's shared memory and layer state
+    void slave_housekeeping() {
+        static split_shared_memory_t master_memory;
+        layer_state_t                master_layer_state         = layer_state;
+        layer_state_t                master_default_layer_state = default_layer_state;
+
+        memcpy(&master_memory, split_shmem, sizeof(master_memory));
+        memcpy(split_shmem, &slave_memory, sizeof(slave_memory));
+        layer_state         = slave_layer_state;
+        default_layer_state = slave_default_layer_state;
+
+        transactions_slave(master_matrix, slave_matrix);
+
+        slave_layer_state         = layer_state;
+        slave_default_layer_state = default_layer_state;
+        memcpy(&slave_memory, split_shmem, sizeof(slave_memory));
+        memcpy(split_shmem, &master_memory, sizeof(master_memory));
+        layer_state         = master_layer_state;
+        default_layer_state = master_default_layer_state;
+    }
+
+    void settle() {
+        for (int i = 0; i < 4; ++i) {
+            master_scan();
+            slave_housekeeping();
+        }
+    }
+
+    uint8_t frame_length_sent() {
+        return split_shmem->sync_frame.length;
+    }
+};
+
+TEST_F(SyncFrame, IdleScanSendsAnEmptyFrame) {
+    master_scan();
+    EXPECT_EQ(exchanges, 1);
+    EXPECT_EQ(frame_length_sent(), 0);
+}
+
+TEST_F(SyncFrame, SurvivesTwoExchangesBetweenSlavePasses) {
+    layer_state = 0x2;
+    master_scan();
+    master_scan();
+    EXPECT_EQ(frame_length_sent(), sizeof(layer_state_t));
+
+    slave_housekeeping();
+    EXPECT_EQ(slave_layer_state, 0x2);
+
+    // Acknowledged by the next exchange, after which the frame is no longer sent
+    master_scan();
+    master_scan();
+    EXPECT_EQ(frame_length_sent(), 0);
+    EXPECT_EQ(split_shmem->layers.layer_state, 0x2);
+}
+
+TEST_F(SyncFrame, ChangesWhileUnacknowledgedAreMerged) {
+    layer_state = 0x2;
+    master_scan();
+    default_layer_state = 0x1;
+    master_scan();
+    layer_state = 0x6;
+    master_scan();
+
+    slave_housekeeping();
+    EXPECT_EQ(slave_layer_state, 0x6);
+    EXPECT_EQ(slave_default_layer_state, 0x1);
+
+    master_scan();
+    master_scan();
+    EXPECT_EQ(frame_length_sent(), 0);
+}
+
+TEST_F(SyncFrame, OlderFrameAppliedIsNotTakenAsAcknowledgement) {
+    layer_state = 0x2;
+    master_scan();
+    slave_housekeeping();
+
+    // The slave reports the first frame applied while the master is already sending a newer one
+    layer_state = 0x4;
+    master_scan();
+    master_scan();
+    EXPECT_NE(frame_length_sent(), 0);
+
+    slave_housekeeping();
+    EXPECT_EQ(slave_layer_state, 0x4);
+    master_scan();
+    master_scan();
+    EXPECT_EQ(frame_length_sent(), 0);
+}
+
+TEST_F(SyncFrame, ForcedResyncDoesNotStarveAcknowledgement) {
+    layer_state = 0x2;
+    master_scan();
+    advance_time(FORCED_SYNC_THROTTLE_MS + 1);
+    master_scan();
+    slave_housekeeping();
+    advance_time(FORCED_SYNC_THROTTLE_MS + 1);
+    master_scan();
+    master_scan();
+    EXPECT_EQ(frame_length_sent(), 0);
+    EXPECT_EQ(slave_layer_state, 0x2);
+}
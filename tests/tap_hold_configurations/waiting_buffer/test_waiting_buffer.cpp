@@ -0,0 +1,136 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "action_tapping.h"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+#include "test_random.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+class WaitingBuffer : public TestFixture {
+   public:
+    std::vector<report_keyboard_t> reports;
+
+    void capture_reports(TestDriver &driver) {
+        EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly([this](report_keyboard_t &report) { reports.push_back(report); });
+    }
+
+    // Keys in the order they first show up in a report, each with the modifiers it was sent with
+    std::vector<std::pair<uint8_t, uint8_t>> typed_keys() {
+        std::vector<std::pair<uint8_t, uint8_t>> typed;
+        report_keyboard_t                        previous = {};
+        for (const auto &report : reports) {
+            for (uint8_t key : report.keys) {
+                if (key != KC_NO && std::find(std::begin(previous.keys), std::end(previous.keys), key) == std::end(previous.keys)) {
+                    typed.push_back({key, report.mods});
+                }
+            }
+            previous = report;
+        }
+        return typed;
+    }
+};
+
+// Typing more keys under a held mod-tap key than the buffer holds used to clear the keyboard state and lose them
+TEST_F(WaitingBuffer, HoldSettlesEarlyInsteadOfOverflowing) {
+    TestDriver             driver;
+    auto                   mod_tap_key = KeymapKey(0, 0, 0, SFT_T(KC_P));
+    std::vector<KeymapKey> letters;
+    for (uint8_t i = 0; i < 12; i++) {
+        letters.push_back(KeymapKey(0, i % 10, 1 + i / 10, KC_B + i));
+    }
+
+    set_keymap({mod_tap_key});
+    for (auto &letter : letters) {
+        add_key(letter);
+    }
+    capture_reports(driver);
+
+    // 24 events within the tapping term, more than the buffer can hold
+    mod_tap_key.press();
+    run_one_scan_loop();
+    for (auto &letter : letters) {
+        tap_key(letter);
+    }
+    EXPECT_LT(timer_read(), TAPPING_TERM);
+    mod_tap_key.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    auto typed = typed_keys();
+    ASSERT_EQ(typed.size(), letters.size());
+    for (uint8_t i = 0; i < letters.size(); i++) {
+        EXPECT_EQ(typed[i].first, KC_B + i);
+        EXPECT_EQ(typed[i].second, MOD_BIT(KC_LEFT_SHIFT));
+    }
+    EXPECT_EQ(reports.back(), report_keyboard_t{});
+}
+
+// Rolls at 25 keys per second over home row mods, with two or three keys down at a time, type every key in order
+TEST_F(WaitingBuffer, FastRollsOverHomeRowModsLoseNoKeys) {
+    TestDriver             driver;
+    std::vector<KeymapKey> keys = {
+        KeymapKey(0, 0, 0, LCTL_T(KC_A)), KeymapKey(0, 1, 0, LALT_T(KC_S)), KeymapKey(0, 2, 0, LGUI_T(KC_D)), KeymapKey(0, 3, 0, LSFT_T(KC_F)), KeymapKey(0, 0, 1, KC_G), KeymapKey(0, 1, 1, KC_H), KeymapKey(0, 2, 1, KC_J), KeymapKey(0, 3, 1, KC_K), KeymapKey(0, 4, 1, KC_L), KeymapKey(0, 5, 1, KC_E),
+    };
+    for (auto &key : keys) {
+        add_key(key);
+    }
+    capture_reports(driver);
+
+    const uint16_t press_interval = 40;
+    const uint16_t hold_time      = 100;
+    const uint16_t presses        = 500;
+
+    struct event_t {
+        uint32_t time;
+        size_t   key;
+        bool     pressed;
+    };
+    std::vector<event_t> events;
+    std::vector<uint8_t> expected;
+    std::vector<int64_t> released_at(keys.size(), -1);
+    TestRandom           random(4321);
+
+    for (uint16_t i = 0; i < presses; i++) {
+        const uint32_t time = i * press_interval;
+        size_t         key  = random.next(keys.size());
+        // Pick a key that isn't still held from an earlier press
+        while (released_at[key] > (int64_t)time) {
+            key = (key + 1) % keys.size();
+        }
+        released_at[key] = time + hold_time;
+        events.push_back({time, key, true});
+        events.push_back({time + hold_time, key, false});
+        expected.push_back((uint8_t)keys[key].report_code); // the tap keycode, for mod-taps
+    }
+    std::stable_sort(events.begin(), events.end(), [](const event_t &a, const event_t &b) { return a.time < b.time; });
+
+    size_t next = 0;
+    for (uint32_t time = 0; next < events.size(); time++) {
+        for (; next < events.size() && events[next].time == time; next++) {
+            if (events[next].pressed) {
+                keys[events[next].key].press();
+            } else {
+                keys[events[next].key].release();
+            }
+        }
+        run_one_scan_loop();
+    }
+    idle_for(TAPPING_TERM);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    auto typed = typed_keys();
+    ASSERT_EQ(typed.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(typed[i].first, expected[i]) << "key " << i;
+        EXPECT_EQ(typed[i].second, 0) << "key " << i;
+    }
+    EXPECT_EQ(reports.back(), report_keyboard_t{});
+}
@@ -0,0 +1,281 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "replay_simulator.hpp"
+#include <bitset>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+extern "C" {
+#include "host.h"
+#include "keyboard.h"
+#include "keycodes.h"
+#include "modifiers.h"
+#include "test_matrix.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+
+std::vector<ReplayModuleTime*>& registered_modules() {
+    static std::vector<ReplayModuleTime*> modules;
+    return modules;
+}
+
+uint64_t allocation_count = 0;
+
+uint64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* State of the replay in progress, fed by the host driver below. */
+ReplayResult*    active_result = nullptr;
+uint32_t         active_start  = 0;
+std::bitset<256> held_keys;
+
+void hash_bytes(const void* data, size_t length) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < length; ++i) {
+        active_result->report_hash = (active_result->report_hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+}
+
+void hash_report(const void* report, size_t length) {
+    uint32_t elapsed = timer_read32() - active_start;
+    hash_bytes(&elapsed, sizeof(elapsed));
+    hash_bytes(report, length);
+    ++active_result->reports;
+}
+
+void type_keycode(uint8_t keycode, bool shifted, std::string& output) {
+    static const char digits[]         = "1234567890";
+    static const char shifted_digits[] = "!@#$%^&*()";
+    static const char symbols[]        = "-=[]\\#;'`,./";
+    static const char shifted_syms[]   = "_+{}|~:\"~<>?";
+
+    if (keycode >= KC_A && keycode <= KC_Z) {
+        output += (char)((shifted ? 'A' : 'a') + (keycode - KC_A));
+    } else if (keycode >= KC_1 && keycode <= KC_0) {
+        output += (shifted ? shifted_digits : digits)[keycode - KC_1];
+    } else if (keycode >= KC_MINUS && keycode <= KC_SLASH) {
+        output += (shifted ? shifted_syms : symbols)[keycode - KC_MINUS];
+    } else if (keycode == KC_ENTER) {
+        output += '\n';
+    } else if (keycode == KC_TAB) {
+        output += '\t';
+    } else if (keycode == KC_SPACE) {
+        output += ' ';
+    } else if (keycode == KC_BACKSPACE) {
+        if (!output.empty()) {
+            output.pop_back();
+        }
+    } else if (keycode == KC_ESCAPE) {
+        output += "<esc>";
+    } else {
+        char name[8];
+        snprintf(name, sizeof(name), "<0x%02X>", keycode);
+        output += name;
+    }
+}
+
+void type_new_keys(uint8_t mods, const std::bitset<256>& keys, const uint8_t* order, size_t order_length) {
+    bool shifted = mods & (MOD_BIT(KC_LEFT_SHIFT) | MOD_BIT(KC_RIGHT_SHIFT));
+    for (size_t i = 0; i < order_length; ++i) {
+        if (order[i] != KC_NO && !held_keys[order[i]]) {
+            type_keycode(order[i], shifted, active_result->output);
+        }
+    }
+    held_keys = keys;
+}
+
+uint8_t replay_keyboard_leds(void) {
+    return 0;
+}
+
+void replay_send_keyboard(report_keyboard_t* report) {
+    hash_report(report, sizeof(*report));
+
+    std::bitset<256> keys;
+    for (uint8_t key : report->keys) {
+        keys.set(key);
+    }
+    type_new_keys(report->mods, keys, report->keys, KEYBOARD_REPORT_KEYS);
+}
+
+void replay_send_nkro(report_nkro_t* report) {
+    hash_report(report, sizeof(*report));
+
+    std::bitset<256>     keys;
+    std::vector<uint8_t> order;
+    for (uint16_t key = 0; key < NKRO_REPORT_BITS * 8; ++key) {
+        if (report->bits[key / 8] & (1 << (key % 8))) {
+            keys.set(key);
+            order.push_back(key);
+        }
+    }
+    type_new_keys(report->mods, keys, order.data(), order.size());
+}
+
+void replay_send_mouse(report_mouse_t* report) {
+    hash_report(report, sizeof(*report));
+}
+
+void replay_send_extra(report_extra_t* report) {
+    hash_report(report, sizeof(*report));
+}
+
+host_driver_t replay_driver = {replay_keyboard_leds, replay_send_keyboard, replay_send_nkro, replay_send_mouse, replay_send_extra};
+
+std::string unescape(const std::string& text) {
+    std::string result;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\\' && i + 1 < text.size()) {
+            switch (text[++i]) {
+                case 'n':
+                    result += '\n';
+                    break;
+                case 't':
+                    result += '\t';
+                    break;
+                default:
+                    result += text[i];
+                    break;
+            }
+        } else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+void ReplayTrace::add(uint32_t time, uint8_t row, uint8_t col, bool pressed) {
+    auto position = events.end();
+    while (position != events.begin() && std::prev(position)->time > time) {
+        --position;
+    }
+    events.insert(position, ReplayEvent{time, row, col, pressed});
+}
+
+bool parse_replay_trace(std::istream& input, ReplayTrace& trace, std::string& error) {
+    static const std::string expect_prefix = "# expect:";
+
+    std::string line;
+    uint32_t    line_number = 0;
+    uint32_t    last_time   = 0;
+    while (std::getline(input, line)) {
+        ++line_number;
+        if (line.compare(0, expect_prefix.size(), expect_prefix) == 0) {
+            size_t start       = line.find_first_not_of(' ', expect_prefix.size());
+            trace.expected     = unescape(start == std::string::npos ? "" : line.substr(start));
+            trace.has_expected = true;
+            continue;
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream fields(line);
+        uint32_t           time;
+        unsigned           row, col;
+        std::string        direction;
+        if (!(fields >> time >> row >> col >> direction) || (direction != "d" && direction != "u")) {
+            error = "line " + std::to_string(line_number) + ": expected <time_ms> <row> <col> <d|u>";
+            return false;
+        }
+        if (row >= MATRIX_ROWS || col >= MATRIX_COLS) {
+            error = "line " + std::to_string(line_number) + ": position is outside the matrix";
+            return false;
+        }
+        if (time < last_time) {
+            error = "line " + std::to_string(line_number) + ": events must be in time order";
+            return false;
+        }
+        last_time = time;
+        trace.events.push_back(ReplayEvent{time, (uint8_t)row, (uint8_t)col, direction == "d"});
+    }
+    return true;
+}
+
+bool load_replay_trace(const std::string& path, ReplayTrace& trace, std::string& error) {
+    std::ifstream input(path);
+    if (!input) {
+        error = "unable to open " + path;
+        return false;
+    }
+    return parse_replay_trace(input, trace, error);
+}
+
+double ReplayResult::events_per_second() const {
+    return elapsed_ns ? events * 1e9 / elapsed_ns : 0;
+}
+
+double ReplayResult::scans_per_second() const {
+    return elapsed_ns ? scans * 1e9 / elapsed_ns : 0;
+}
+
+ReplayResult ReplaySimulator::replay(const ReplayTrace& trace) {
+    ReplayResult result;
+    result.report_hash = 0xcbf29ce484222325ULL;
+
+    for (auto module : registered_modules()) {
+        module->calls = 0;
+        module->ns    = 0;
+    }
+
+    host_driver_t* previous_driver = host_get_driver();
+    host_set_driver(&replay_driver);
+    active_result = &result;
+    active_start  = timer_read32();
+    held_keys.reset();
+
+    uint64_t allocations = allocation_count;
+    uint32_t end         = (trace.events.empty() ? 0 : trace.events.back().time) + settle_ms;
+    auto     event       = trace.events.begin();
+    uint64_t start_ns    = now_ns();
+    for (uint32_t time = 0; time <= end; ++time) {
+        for (; event != trace.events.end() && event->time <= time; ++event) {
+            if (event->pressed) {
+                press_key(event->col, event->row);
+            } else {
+                release_key(event->col, event->row);
+            }
+        }
+        keyboard_task();
+        housekeeping_task();
+        advance_time(1);
+        ++result.scans;
+    }
+    result.elapsed_ns  = now_ns() - start_ns;
+    result.allocations = allocation_count - allocations;
+    result.events      = trace.events.size();
+
+    for (auto module : registered_modules()) {
+        result.modules.push_back(*module);
+    }
+
+    active_result = nullptr;
+    host_set_driver(previous_driver);
+    return result;
+}
+
+void ReplaySimulator::register_module(ReplayModuleTime* module) {
+    registered_modules().push_back(module);
+}
+
+void ReplaySimulator::count_allocation(void) {
+    ++allocation_count;
+}
+
+ReplayModuleTimer::ReplayModuleTimer(ReplayModuleTime& module) : module(module), start_ns(now_ns()) {}
+
+ReplayModuleTimer::~ReplayModuleTimer() {
+    module.ns += now_ns() - start_ns;
+    ++module.calls;
+}
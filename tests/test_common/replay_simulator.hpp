@@ -0,0 +1,112 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A single matrix transition, `time` milliseconds after the start of a trace.
+ */
+struct ReplayEvent {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+};
+
+/**
+ * @brief A recorded keystroke trace, and optionally the text it is expected to type.
+ */
+struct ReplayTrace {
+    std::vector<ReplayEvent> events;
+    std::string              expected;
+    bool                     has_expected = false;
+
+    /**
+     * @brief Adds an event, keeping the trace ordered by time. Events at the same time keep their insertion order.
+     */
+    void add(uint32_t time, uint8_t row, uint8_t col, bool pressed);
+};
+
+/**
+ * @brief Parses a trace from its text form, one `<time_ms> <row> <col> <d|u>` event per line.
+ *
+ * Blank lines and lines starting with `#` are ignored, apart from `# expect: <text>` which sets the expected output.
+ * The expected text may use `\n`, `\t` and `\\` escapes. Returns false and fills in `error` on malformed input.
+ */
+bool parse_replay_trace(std::istream& input, ReplayTrace& trace, std::string& error);
+
+/**
+ * @brief Reads and parses the trace file at `path`.
+ */
+bool load_replay_trace(const std::string& path, ReplayTrace& trace, std::string& error);
+
+/**
+ * @brief Inclusive time spent in a firmware function, accumulated by a test's profiling wrappers.
+ */
+struct ReplayModuleTime {
+    const char* name;
+    uint64_t    calls;
+    uint64_t    ns;
+};
+
+struct ReplayResult {
+    size_t                        events      = 0;
+    uint32_t                      scans       = 0;
+    uint64_t                      elapsed_ns  = 0;
+    uint64_t                      allocations = 0;
+    uint32_t                      reports     = 0;
+    uint64_t                      report_hash = 0;
+    std::string                   output;
+    std::vector<ReplayModuleTime> modules;
+
+    double events_per_second() const;
+    double scans_per_second() const;
+};
+
+/**
+ * @brief Replays traces through the full firmware, one keyboard task per millisecond of trace time.
+ *
+ * Keyboard reports are captured by the simulator's own host driver and decoded into the text they would type on a US
+ * layout. The keymap is whatever the running test fixture has set up.
+ */
+class ReplaySimulator {
+   public:
+    /**
+     * @param settle_ms How long to keep scanning after the last event, so pending timeouts can expire.
+     */
+    explicit ReplaySimulator(uint32_t settle_ms = 1000) : settle_ms(settle_ms) {}
+
+    ReplayResult replay(const ReplayTrace& trace);
+
+    /**
+     * @brief Adds a module to the per-module timings reported by every replay. Usually called by static initialisers.
+     */
+    static void register_module(ReplayModuleTime* module);
+
+    /**
+     * @brief Counts a heap allocation made by the firmware, for tests which intercept the allocator.
+     */
+    static void count_allocation(void);
+
+   private:
+    uint32_t settle_ms;
+};
+
+/**
+ * @brief Adds the lifetime of the timer to the given module's time.
+ */
+class ReplayModuleTimer {
+   public:
+    explicit ReplayModuleTimer(ReplayModuleTime& module);
+    ~ReplayModuleTimer();
+
+   private:
+    ReplayModuleTime& module;
+    uint64_t          start_ns;
+};
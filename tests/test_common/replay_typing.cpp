@@ -0,0 +1,71 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "replay_typing.hpp"
+#include "test_random.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "keycodes.h"
+}
+
+void replay_add_layout(TestFixture& fixture, const ReplayLayout& layout) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+            fixture.add_key(KeymapKey(0, col, row, layout[row][col]));
+        }
+    }
+}
+
+keypos_t replay_position_of(const ReplayLayout& layout, uint16_t keycode) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; ++row) {
+        for (uint8_t col = 0; col < MATRIX_COLS; ++col) {
+            if (layout[row][col] == keycode) {
+                return {.col = col, .row = row};
+            }
+        }
+    }
+    ADD_FAILURE() << "keycode " << keycode << " is not on the layout";
+    return {.col = 0, .row = 0};
+}
+
+uint16_t replay_keycode_of(char c) {
+    switch (c) {
+        case ' ':
+            return KC_SPC;
+        case '\b':
+            return KC_BSPC;
+        case '\n':
+            return KC_ENT;
+        case '\'':
+            return KC_QUOT;
+        case '^':
+            return KC_LCTL;
+        default:
+            return KC_A + (c - 'a');
+    }
+}
+
+ReplayTrace replay_type_trace(const ReplayLayout& layout, const std::string& text) {
+    ReplayTrace trace;
+    uint32_t    now = 0;
+    for (char c : text) {
+        keypos_t key = replay_position_of(layout, replay_keycode_of(c));
+        trace.add(now, key.row, key.col, true);
+        trace.add(now + 20, key.row, key.col, false);
+        now += 40;
+    }
+    return trace;
+}
+
+std::string replay_benchmark_text(size_t length) {
+    static const char* const words[] = {"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "available", "information", "language", "accommodate", "filter", "length", "output", "their", "heirloom", "interrupt", "guarantee"};
+
+    std::string text;
+    TestRandom  random(12345);
+    while (text.size() < length) {
+        text += words[random.next(sizeof(words) / sizeof(words[0]))];
+        text += ' ';
+    }
+    return text;
+}
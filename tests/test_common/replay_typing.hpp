@@ -0,0 +1,43 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "keyboard.h"
+#include "replay_simulator.hpp"
+#include "test_fixture.hpp"
+
+/**
+ * @brief Layer 0 layout, indexed `[row][col]`, that tests type text on.
+ */
+using ReplayLayout = uint16_t[MATRIX_ROWS][MATRIX_COLS];
+
+/**
+ * @brief Adds every key of `layout` to the fixture's keymap.
+ */
+void replay_add_layout(TestFixture& fixture, const ReplayLayout& layout);
+
+/**
+ * @brief Finds `keycode` on `layout`, failing the test if it isn't there.
+ */
+keypos_t replay_position_of(const ReplayLayout& layout, uint16_t keycode);
+
+/**
+ * @brief Maps a character of test text to the keycode typing it.
+ *
+ * Letters are lowercase, `\b` is Backspace, `\n` is Enter and `^` taps Left Ctrl.
+ */
+uint16_t replay_keycode_of(char c);
+
+/**
+ * @brief Builds a trace typing `text` on `layout` a key at a time, each key held for 20ms and pressed 40ms apart.
+ */
+ReplayTrace replay_type_trace(const ReplayLayout& layout, const std::string& text);
+
+/**
+ * @brief Space separated stream of common English words at least `length` characters long, for benchmarks.
+ */
+std::string replay_benchmark_text(size_t length);
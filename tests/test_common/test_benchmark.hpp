@@ -0,0 +1,33 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs `body` once and returns how long it took, in nanoseconds.
+ */
+template <typename F>
+double benchmark_ns(F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Records a benchmark result as a property of the running test.
+ *
+ * Properties end up in the report written with `--gtest_output=xml`. Results are only printed to stdout when
+ * `QMK_TEST_BENCHMARK` is set in the environment, so normal test runs stay quiet.
+ */
+inline void record_benchmark(const std::string& name, double value) {
+    testing::Test::RecordProperty(name, (int)value);
+    if (std::getenv("QMK_TEST_BENCHMARK")) {
+        printf("[ BENCHMARK] %s: %.3f\n", name.c_str(), value);
+    }
+}
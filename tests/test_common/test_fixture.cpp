@@ -59,6 +59,7 @@ void TestFixture::TearDownTestCase() {}
 TestFixture::TestFixture() {
     m_this = this;
     timer_clear();
+    effective_layer_cache_invalidate();
     keyrecord_t empty_keyrecord = {0};
     test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &empty_keyrecord) << "ms" << std::endl;
 }
@@ -103,6 +104,8 @@ void TestFixture::add_key(KeymapKey key) {
         FAIL() << "key is already mapped for layer " << +key.layer << " and (column,row) (" << +key.position.col << "," << +key.position.row << ")";
     }
 
+    effective_layer_cache_invalidate_key(key.position.row, key.position.col);
+
     this->keymap.push_back(key);
 }
 
@@ -131,6 +134,7 @@ void TestFixture::tap_combo(const std::vector<KeymapKey>& chord_keys, unsigned d
 
 void TestFixture::set_keymap(std::initializer_list<KeymapKey> keys) {
     this->keymap.clear();
+    effective_layer_cache_invalidate();
     for (auto& key : keys) {
         add_key(key);
     }
@@ -0,0 +1,32 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Linear congruential generator for test input, so generated data is the same on every run and every host.
+ */
+class TestRandom {
+   public:
+    explicit TestRandom(uint32_t seed) : seed(seed) {}
+
+    /**
+     * @brief Returns the next 16 bit value.
+     */
+    uint16_t next() {
+        seed = seed * 1103515245 + 12345;
+        return seed >> 16;
+    }
+
+    /**
+     * @brief Returns the next value in `[0, range)`.
+     */
+    uint32_t next(uint32_t range) {
+        return next() % range;
+    }
+
+   private:
+    uint32_t seed;
+};
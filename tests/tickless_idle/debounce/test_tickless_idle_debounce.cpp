@@ -0,0 +1,68 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "debounce.h"
+
+void set_time(uint32_t t);
+void tickless_idle_simulate_interrupt_at(uint32_t time);
+}
+
+// Stands in for an interrupt driven matrix: the pin-change interrupt wakes the loop, which scans the raw state and
+// debounces it, the debounced copy being what the rest of the firmware sees.
+class TicklessIdleDebounce : public TestFixture {
+   public:
+    matrix_row_t raw[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked[MATRIX_ROWS] = {0};
+
+    void SetUp() override {
+        debounce_init();
+        set_activity_timestamps(0, 0, 0);
+        tickless_idle_reset_stats();
+    }
+
+    // Runs the loop until the debounced matrix matches the raw one, returning how long that took
+    uint32_t run_until_settled(uint32_t changed_at) {
+        bool changed = true;
+        for (int i = 0; i < 1000; ++i) {
+            debounce(raw, cooked, changed);
+            changed = false;
+            if (memcmp(raw, cooked, sizeof(raw)) == 0) {
+                return timer_read32() - changed_at;
+            }
+            tickless_idle_task();
+        }
+        return UINT32_MAX;
+    }
+};
+
+TEST_F(TicklessIdleDebounce, TicksWhileAChangeIsDebouncing) {
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    EXPECT_EQ(tickless_idle_timeout(), TICKLESS_IDLE_MAX_SLEEP);
+
+    raw[0] = 1;
+    debounce(raw, cooked, true);
+    EXPECT_EQ(cooked[0], 0);
+    EXPECT_TRUE(debounce_pending());
+    EXPECT_EQ(tickless_idle_timeout(), 1);
+
+    EXPECT_LE(run_until_settled(TICKLESS_IDLE_ACTIVITY_TIMEOUT), DEBOUNCE + 1);
+    EXPECT_EQ(tickless_idle_timeout(), TICKLESS_IDLE_MAX_SLEEP);
+}
+
+TEST_F(TicklessIdleDebounce, PressAfterIdleIsNotDelayedBySleep) {
+    const uint32_t press_at = 2 * TICKLESS_IDLE_ACTIVITY_TIMEOUT + 13;
+
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    tickless_idle_simulate_interrupt_at(press_at);
+    while (timer_read32() < press_at) {
+        tickless_idle_task();
+    }
+    EXPECT_EQ(timer_read32(), press_at);
+
+    raw[0] = 1;
+    EXPECT_LE(run_until_settled(press_at), DEBOUNCE + 1);
+    EXPECT_FALSE(debounce_pending());
+}
@@ -0,0 +1,183 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "deferred_exec.h"
+
+void set_time(uint32_t t);
+void tickless_idle_simulate_interrupt_at(uint32_t time);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+static uint32_t callbacks_fired = 0;
+static uint32_t worst_lateness  = 0;
+
+static uint32_t periodic_callback(uint32_t trigger_time, void *cb_arg) {
+    uint32_t lateness = timer_read32() - trigger_time;
+    if (lateness > worst_lateness) {
+        worst_lateness = lateness;
+    }
+    ++callbacks_fired;
+    return (uint32_t)(uintptr_t)cb_arg;
+}
+
+class TicklessIdle : public TestFixture {
+   public:
+    std::vector<deferred_token> tokens;
+
+    void SetUp() override {
+        callbacks_fired = 0;
+        worst_lateness  = 0;
+        set_activity_timestamps(0, 0, 0);
+        deferred_exec_task();
+        tickless_idle_reset_stats();
+    }
+
+    void TearDown() override {
+        for (auto token : tokens) {
+            cancel_deferred_exec(token);
+        }
+        deferred_exec_task();
+    }
+};
+
+TEST_F(TicklessIdle, TicksEveryMillisecondWhileActive) {
+    EXPECT_EQ(tickless_idle_timeout(), 1);
+}
+
+TEST_F(TicklessIdle, SleepsForMaximumWhenNothingIsPending) {
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    EXPECT_EQ(tickless_idle_timeout(), TICKLESS_IDLE_MAX_SLEEP);
+}
+
+TEST_F(TicklessIdle, SleepsUntilNextDeferredExecution) {
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    tokens.push_back(defer_exec(30, periodic_callback, nullptr));
+    EXPECT_EQ(tickless_idle_timeout(), 30);
+
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), TICKLESS_IDLE_ACTIVITY_TIMEOUT + 30);
+    deferred_exec_task();
+    EXPECT_EQ(callbacks_fired, 1);
+    EXPECT_EQ(worst_lateness, 0);
+}
+
+TEST_F(TicklessIdle, HeldKeyPreventsLongSleeps) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    set_time(10 * TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    EXPECT_EQ(tickless_idle_timeout(), 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(TicklessIdle, KeepAwakeSkipsOneSleep) {
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    tickless_idle_keep_awake();
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), TICKLESS_IDLE_ACTIVITY_TIMEOUT + TICKLESS_IDLE_MAX_SLEEP);
+    EXPECT_EQ(tickless_idle_get_stats()->iterations, 2);
+    EXPECT_EQ(tickless_idle_get_stats()->sleeps, 1);
+}
+
+TEST_F(TicklessIdle, InterruptCutsSleepShort) {
+    set_time(TICKLESS_IDLE_ACTIVITY_TIMEOUT);
+    tickless_idle_simulate_interrupt_at(TICKLESS_IDLE_ACTIVITY_TIMEOUT + 7);
+    tickless_idle_task();
+    EXPECT_EQ(timer_read32(), TICKLESS_IDLE_ACTIVITY_TIMEOUT + 7);
+}
+
+// Compares main loop iterations against an always-polling loop over ten seconds of mostly idle use: an animation
+// style deferred callback every 50ms, and a handful of key taps arriving through the pin-change interrupt.
+TEST_F(TicklessIdle, BenchmarkWastedIterations) {
+    TestDriver driver;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key_a});
+
+    const uint32_t              duration = 10000;
+    const std::vector<uint32_t> taps     = {1500, 3200, 3400, 7000, 9100};
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    tokens.push_back(defer_exec(50, periodic_callback, (void *)(uintptr_t)50));
+
+    // Each tap is a press followed by a release 40ms later
+    std::vector<std::pair<uint32_t, bool>> events;
+    for (auto t : taps) {
+        events.push_back({t, true});
+        events.push_back({t + 40, false});
+    }
+
+    size_t   next_event     = 0;
+    uint32_t key_changes    = 0;
+    uint32_t useful         = 0;
+    uint32_t iterations     = 0;
+    uint32_t last_callbacks = 0;
+
+    while (timer_read32() < duration && iterations < 2 * duration) {
+        bool key_changed = false;
+        if (next_event < events.size() && timer_read32() >= events[next_event].first) {
+            if (events[next_event].second) {
+                key_a.press();
+            } else {
+                key_a.release();
+            }
+            ++next_event;
+            ++key_changes;
+            key_changed = true;
+        }
+        if (next_event < events.size()) {
+            tickless_idle_simulate_interrupt_at(events[next_event].first);
+        }
+
+        keyboard_task();
+        deferred_exec_task();
+        housekeeping_task();
+
+        if (key_changed || callbacks_fired != last_callbacks) {
+            ++useful;
+        }
+        last_callbacks = callbacks_fired;
+        ++iterations;
+
+        tickless_idle_task();
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    // An always-polling loop at the 1ms timer resolution runs once per millisecond no matter what
+    uint32_t polling_iterations = duration;
+    uint32_t polling_wasted     = polling_iterations - useful;
+    uint32_t tickless_wasted    = iterations - useful;
+
+    record_benchmark("polling_iterations", polling_iterations);
+    record_benchmark("polling_wasted", polling_wasted);
+    record_benchmark("tickless_iterations", iterations);
+    record_benchmark("tickless_wasted", tickless_wasted);
+
+    EXPECT_EQ(key_changes, events.size());
+    EXPECT_EQ(callbacks_fired, duration / 50 - 1);
+    EXPECT_EQ(worst_lateness, 0);
+    EXPECT_LT(tickless_wasted * 5, polling_wasted);
+}
@@ -0,0 +1,189 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstdlib>
+#include <vector>
+#include "test_benchmark.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgblight.h"
+#include "ws2812.h"
+#include "ws2812_encoder.h"
+
+extern uint8_t  test_ws2812_stream[];
+extern uint16_t test_ws2812_frames;
+extern bool     test_ws2812_sending;
+void            test_ws2812_complete(void);
+}
+
+static uint16_t flushes_completed;
+
+extern "C" void ws2812_flush_complete_user(void) {
+    flushes_completed++;
+}
+
+// Datasheet tolerance on the high time of a bit
+static const int TOLERANCE_NS = 150;
+
+static bool stream_bit(const uint8_t *stream, size_t bit) {
+    return stream[bit / 8] & (0x80 >> (bit % 8));
+}
+
+/**
+ * Decodes a stream the way a WS2812 samples it: every symbol must start high and stay low once it drops, and the
+ * length of the high pulse tells a 0 from a 1.
+ */
+static std::vector<uint8_t> decode(const uint8_t *stream, size_t bytes) {
+    std::vector<uint8_t> data(bytes);
+    size_t               bit = 0;
+    for (size_t i = 0; i < bytes * 8; i++) {
+        int high = 0;
+        while (high < WS2812_ENCODER_SYMBOL_BITS && stream_bit(stream, bit + high)) {
+            high++;
+        }
+        for (int low = high; low < WS2812_ENCODER_SYMBOL_BITS; low++) {
+            EXPECT_FALSE(stream_bit(stream, bit + low)) << "symbol " << i << " goes high again";
+        }
+
+        int high_ns = high * WS2812_ENCODER_BIT_NS;
+        if (std::abs(high_ns - WS2812_T1H) <= TOLERANCE_NS) {
+            data[i / 8] |= 0x80 >> (i % 8);
+        } else {
+            EXPECT_LE(std::abs(high_ns - WS2812_T0H), TOLERANCE_NS) << "symbol " << i << " is high for " << high_ns << "ns";
+        }
+        bit += WS2812_ENCODER_SYMBOL_BITS;
+    }
+    return data;
+}
+
+class WS2812Async : public TestFixture {
+   public:
+    void SetUp() override {
+        test_ws2812_sending = false;
+        test_ws2812_frames  = 0;
+        flushes_completed   = 0;
+    }
+};
+
+TEST_F(WS2812Async, TimingTable) {
+    // The high times as they come out of the table
+    EXPECT_EQ(WS2812_ENCODER_T0H_BITS, 1);
+    EXPECT_EQ(WS2812_ENCODER_T1H_BITS, 3);
+    EXPECT_LE(std::abs(WS2812_ENCODER_T0H_BITS * WS2812_ENCODER_BIT_NS - WS2812_T0H), TOLERANCE_NS);
+    EXPECT_LE(std::abs(WS2812_ENCODER_T1H_BITS * WS2812_ENCODER_BIT_NS - WS2812_T1H), TOLERANCE_NS);
+    // Less the rounding of WS2812_ENCODER_BIT_NS to whole ns
+    EXPECT_NEAR(WS2812_ENCODER_SYMBOL_BITS * WS2812_ENCODER_BIT_NS, WS2812_TIMING, WS2812_ENCODER_SYMBOL_BITS);
+
+    ws2812_led_t led = {};
+    uint8_t      stream[WS2812_ENCODER_SIZE(sizeof(ws2812_led_t))];
+
+    led.g = 0x00;
+    led.r = 0xFF;
+    led.b = 0xA5;
+    EXPECT_EQ(ws2812_encode_leds(stream, &led, 1), stream + sizeof(stream));
+    std::vector<uint8_t> expected = {0x88, 0x88, 0x88, 0x88, 0xEE, 0xEE, 0xEE, 0xEE, 0xE8, 0xE8, 0x8E, 0x8E};
+    EXPECT_EQ(std::vector<uint8_t>(stream, stream + sizeof(stream)), expected);
+}
+
+TEST_F(WS2812Async, EveryByteDecodes) {
+    std::vector<ws2812_led_t> leds((256 + sizeof(ws2812_led_t) - 1) / sizeof(ws2812_led_t));
+    uint8_t                  *data = (uint8_t *)leds.data();
+    for (size_t i = 0; i < leds.size() * sizeof(ws2812_led_t); i++) {
+        data[i] = i;
+    }
+
+    std::vector<uint8_t> stream(WS2812_ENCODER_SIZE(leds.size() * sizeof(ws2812_led_t)));
+    ws2812_encode_leds(stream.data(), leds.data(), leds.size());
+
+    EXPECT_EQ(decode(stream.data(), leds.size() * sizeof(ws2812_led_t)), std::vector<uint8_t>(data, data + leds.size() * sizeof(ws2812_led_t)));
+}
+
+TEST_F(WS2812Async, ResetHoldsTheLineLowLongEnough) {
+    EXPECT_GE(WS2812_ENCODER_RESET_SIZE(WS2812_TRST_US) * 8 / WS2812_ENCODER_SYMBOL_BITS * WS2812_TIMING, WS2812_TRST_US * 1000);
+}
+
+TEST_F(WS2812Async, ChannelOrder) {
+    ws2812_set_color_all(0, 0, 0);
+    ws2812_set_color(1, 0x11, 0x22, 0x33);
+    ws2812_flush();
+
+    std::vector<uint8_t> data = decode(test_ws2812_stream + WS2812_ENCODER_SIZE(sizeof(ws2812_led_t)), sizeof(ws2812_led_t));
+    EXPECT_EQ(data, (std::vector<uint8_t>{0x22, 0x11, 0x33}));
+}
+
+TEST_F(WS2812Async, RgblightDefersFlushWhileFrameInFlight) {
+    rgblight_enable_noeeprom();
+    rgblight_mode_noeeprom(RGBLIGHT_MODE_STATIC_LIGHT);
+    test_ws2812_complete();
+    test_ws2812_frames = 0;
+    flushes_completed  = 0;
+
+    rgblight_setrgb(0x10, 0x20, 0x30);
+    EXPECT_EQ(test_ws2812_frames, 1);
+    EXPECT_TRUE(ws2812_busy());
+
+    // The second frame waits for the first one, without blocking
+    rgblight_setrgb(0x40, 0x50, 0x60);
+    rgblight_task();
+    EXPECT_EQ(test_ws2812_frames, 1);
+
+    test_ws2812_complete();
+    EXPECT_EQ(flushes_completed, 1);
+    rgblight_task();
+    EXPECT_EQ(test_ws2812_frames, 2);
+    EXPECT_EQ(decode(test_ws2812_stream, sizeof(ws2812_led_t)), (std::vector<uint8_t>{0x50, 0x40, 0x60}));
+
+    // Nothing is left to flush
+    test_ws2812_complete();
+    rgblight_task();
+    EXPECT_EQ(test_ws2812_frames, 2);
+}
+
+// The per-bit encoding that the SPI driver used before the lookup table
+static uint8_t get_protocol_eq(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+TEST_F(WS2812Async, BenchmarkEncoding) {
+    const size_t              count  = 100;
+    const int                 rounds = 2000;
+    std::vector<ws2812_led_t> leds(count);
+    for (size_t i = 0; i < count; i++) {
+        leds[i] = {(uint8_t)(i * 3), (uint8_t)(i * 5), (uint8_t)(i * 7)};
+    }
+    std::vector<uint8_t> table_stream(WS2812_ENCODER_SIZE(count * sizeof(ws2812_led_t)));
+    std::vector<uint8_t> bit_stream(table_stream.size());
+
+    double bit_ns = benchmark_ns([&] {
+        for (int round = 0; round < rounds; round++) {
+            const uint8_t *data = (const uint8_t *)leds.data();
+            for (size_t i = 0; i < count * sizeof(ws2812_led_t); i++) {
+                for (int j = 0; j < 4; j++) {
+                    bit_stream[i * 4 + j] = get_protocol_eq(data[i], j);
+                }
+            }
+            leds[round % count].b ^= 1;
+        }
+    });
+    double table_ns = benchmark_ns([&] {
+        for (int round = 0; round < rounds; round++) {
+            ws2812_encode_leds(table_stream.data(), leds.data(), count);
+            leds[round % count].b ^= 1;
+        }
+    });
+
+    EXPECT_EQ(table_stream, bit_stream);
+
+    record_benchmark("per_bit_ns", bit_ns / rounds);
+    record_benchmark("table_ns", table_ns / rounds);
+}
@@ -0,0 +1,44 @@
+// Copyright 2025 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ws2812.h"
+#include "ws2812_encoder.h"
+
+/*
+ * Stands in for a DMA driver: ws2812_flush() encodes the frame and returns while it is "being sent", until the test
+ * completes the transfer with test_ws2812_complete().
+ */
+uint8_t  test_ws2812_stream[WS2812_ENCODER_SIZE(sizeof(ws2812_led_t) * WS2812_LED_COUNT)];
+uint16_t test_ws2812_frames  = 0;
+bool     test_ws2812_sending = false;
+
+ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
+
+void ws2812_init(void) {}
+
+void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    ws2812_leds[index].r = red;
+    ws2812_leds[index].g = green;
+    ws2812_leds[index].b = blue;
+}
+
+void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (int i = 0; i < WS2812_LED_COUNT; i++) {
+        ws2812_set_color(i, red, green, blue);
+    }
+}
+
+bool ws2812_busy(void) {
+    return test_ws2812_sending;
+}
+
+void ws2812_flush(void) {
+    ws2812_encode_leds(test_ws2812_stream, ws2812_leds, WS2812_LED_COUNT);
+    test_ws2812_frames++;
+    test_ws2812_sending = true;
+}
+
+void test_ws2812_complete(void) {
+    test_ws2812_sending = false;
+    ws2812_flush_complete_kb();
+}
@@ -12,6 +12,10 @@
 #include "usb_driver.h"
 #include "util.h"
 
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 /*===========================================================================*/
 /* Driver local functions.                                                   */
 /*===========================================================================*/
@@ -248,6 +252,11 @@ void usb_endpoint_out_rx_complete_cb(USBDriver *usbp, usbep_t ep) {
     usb_start_receive(endpoint);
 
     osalSysUnlockFromISR();
+
+#ifdef TICKLESS_IDLE_ENABLE
+    /* Received data is read from the main loop, so wake it up. */
+    tickless_idle_wakeup_from_isr();
+#endif
 }
 
 bool usb_endpoint_in_send(usb_endpoint_in_t *endpoint, const uint8_t *data, size_t size, sysinterval_t timeout, bool buffered) {
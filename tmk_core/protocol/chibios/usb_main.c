@@ -28,6 +28,10 @@
 #include "usb_driver.h"
 #include "usb_types.h"
 
+#ifdef TICKLESS_IDLE_ENABLE
+#    include "tickless_idle.h"
+#endif
+
 #ifdef RAW_ENABLE
 #    include "raw_hid.h"
 #endif
@@ -113,6 +117,10 @@ static inline bool usb_event_queue_enqueue(usbevent_t event) {
     }
     event_queue[event_queue_head] = event;
     event_queue_head              = next;
+#ifdef TICKLESS_IDLE_ENABLE
+    // Events are handled from the main loop, don't leave them waiting for a sleep to run out
+    tickless_idle_wakeup_from_isr();
+#endif
     return true;
 }
 
@@ -244,6 +252,9 @@ static void set_led_transfer_cb(USBDriver *usbp) {
     } else {
         usb_device_state_set_leds(set_report_buf[0]);
     }
+#ifdef TICKLESS_IDLE_ENABLE
+    tickless_idle_wakeup_from_isr();
+#endif
 }
 
 static bool usb_requests_hook_cb(USBDriver *usbp) {
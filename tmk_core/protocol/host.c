@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "util.h"
 #include "debug.h"
 #include "usb_device_state.h"
+#include "latency_trace.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -181,6 +182,7 @@ void host_keyboard_send(report_keyboard_t *report) {
 #ifdef KEYBOARD_SHARED_EP
     report->report_id = REPORT_ID_KEYBOARD;
 #endif
+    LATENCY_TRACE(HOST_SEND);
     (*driver->send_keyboard)(report);
 
     if (debug_keyboard) {
@@ -197,6 +199,7 @@ void host_nkro_send(report_nkro_t *report) {
     if (!driver || !driver->send_nkro) return;
 
     report->report_id = REPORT_ID_NKRO;
+    LATENCY_TRACE(HOST_SEND);
     (*driver->send_nkro)(report);
 
     if (debug_keyboard) {